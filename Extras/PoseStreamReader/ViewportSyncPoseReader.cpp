@@ -0,0 +1,220 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * Prints the camera poses a running editor publishes, or with --selftest hammers the reader against an in-process writer
+ * and fails if it ever hands back a torn record.
+ *
+ *   Linux/Mac:  c++ -std=c++14 -O2 -pthread -I../../Source/GameViewportSync/Public ViewportSyncPoseReader.cpp -o ViewportSyncPoseReader -lrt
+ *   Windows:    cl /std:c++14 /O2 /EHsc /I..\..\Source\GameViewportSync\Public ViewportSyncPoseReader.cpp
+ *
+ *   ViewportSyncPoseReader [Name]
+ *   ViewportSyncPoseReader --selftest [Seconds]
+ */
+
+#include "ViewportSyncPoseStreamReader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	/* Writes records the same way the editor does, every value derived from the frame number so tearing is detectable */
+	class FTestWriter
+	{
+	public:
+		explicit FTestWriter(void* Memory)
+			: Header(static_cast<FViewportSyncPoseStreamHeader*>(Memory))
+			, Records(reinterpret_cast<FViewportSyncPoseStreamRecord*>(static_cast<uint8_t*>(Memory) + sizeof(FViewportSyncPoseStreamHeader)))
+		{
+			memset(Memory, 0, VIEWPORTSYNC_POSESTREAM_SIZE);
+			Header->Version = VIEWPORTSYNC_POSESTREAM_VERSION;
+			Header->HeaderSize = sizeof(FViewportSyncPoseStreamHeader);
+			Header->RecordSize = sizeof(FViewportSyncPoseStreamRecord);
+			Header->Capacity = VIEWPORTSYNC_POSESTREAM_CAPACITY;
+			Header->MaxViewports = VIEWPORTSYNC_POSESTREAM_MAX_VIEWPORTS;
+			Header->WriterProcessId = 1;
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			Header->Magic = VIEWPORTSYNC_POSESTREAM_MAGIC;
+		}
+
+		void Write(uint64_t FrameNumber)
+		{
+			FViewportSyncPoseStreamRecord& Record = Records[Header->WriteCount % VIEWPORTSYNC_POSESTREAM_CAPACITY];
+
+			Record.Sequence = Record.Sequence + 1;
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			Record.FrameNumber = FrameNumber;
+			Record.Time = FrameNumber / 60.0;
+			Record.NumViewports = 1 + FrameNumber % VIEWPORTSYNC_POSESTREAM_MAX_VIEWPORTS;
+			for (uint32_t Index = 0; Index < Record.NumViewports; ++Index)
+			{
+				FViewportSyncPoseStreamViewport& Viewport = Record.Viewports[Index];
+				Viewport.TrackId = Index;
+				Viewport.Flags = ViewportSyncPoseFlag_HasTarget;
+				for (int Axis = 0; Axis < 3; ++Axis)
+				{
+					Viewport.CameraLocation[Axis] = float(FrameNumber % 100000);
+					Viewport.CameraRotation[Axis] = float(FrameNumber % 360);
+					Viewport.TargetLocation[Axis] = float(FrameNumber % 100000);
+				}
+				Viewport.FieldOfView = 90.0f;
+			}
+
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			Record.Sequence = Record.Sequence + 1;
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			Header->WriteCount = Header->WriteCount + 1;
+		}
+
+		void Close()
+		{
+			Header->WriterProcessId = 0;
+		}
+
+	private:
+		FViewportSyncPoseStreamHeader* Header;
+		FViewportSyncPoseStreamRecord* Records;
+	};
+
+	bool IsConsistent(const FViewportSyncPoseStreamRecord& Record)
+	{
+		if (Record.NumViewports != 1 + Record.FrameNumber % VIEWPORTSYNC_POSESTREAM_MAX_VIEWPORTS)
+		{
+			return false;
+		}
+
+		for (uint32_t Index = 0; Index < Record.NumViewports; ++Index)
+		{
+			const FViewportSyncPoseStreamViewport& Viewport = Record.Viewports[Index];
+			for (int Axis = 0; Axis < 3; ++Axis)
+			{
+				if (Viewport.CameraLocation[Axis] != float(Record.FrameNumber % 100000)
+					|| Viewport.CameraRotation[Axis] != float(Record.FrameNumber % 360)
+					|| Viewport.TargetLocation[Axis] != float(Record.FrameNumber % 100000))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	int RunSelfTest(double Seconds)
+	{
+		std::vector<uint64_t> Memory(VIEWPORTSYNC_POSESTREAM_SIZE / sizeof(uint64_t) + 1);
+
+		FTestWriter Writer(Memory.data());
+
+		FViewportSyncPoseStreamReader Reader;
+		if (!Reader.Attach(Memory.data()))
+		{
+			printf("FAILED: couldn't attach to the test stream\n");
+			return 1;
+		}
+
+		std::atomic<bool> bStop(false);
+		std::thread WriterThread([&Writer, &bStop]()
+		{
+			for (uint64_t FrameNumber = 0; !bStop; ++FrameNumber)
+			{
+				Writer.Write(FrameNumber);
+			}
+			Writer.Close();
+		});
+
+		uint64_t NumRead = 0;
+		uint64_t NumSkipped = 0;
+		uint64_t NumTorn = 0;
+		uint64_t LastFrameNumber = 0;
+		bool bOutOfOrder = false;
+
+		const auto EndTime = std::chrono::steady_clock::now() + std::chrono::duration<double>(Seconds);
+		while (std::chrono::steady_clock::now() < EndTime)
+		{
+			FViewportSyncPoseStreamRecord Record;
+			uint64_t Skipped = 0;
+			while (Reader.ReadNext(Record, &Skipped))
+			{
+				NumSkipped += Skipped;
+				NumTorn += IsConsistent(Record) ? 0 : 1;
+				bOutOfOrder |= NumRead > 0 && Record.FrameNumber <= LastFrameNumber;
+				LastFrameNumber = Record.FrameNumber;
+				++NumRead;
+			}
+		}
+
+		bStop = true;
+		WriterThread.join();
+
+		printf("Read %llu records, skipped %llu the writer lapped, %llu torn%s\n",
+			(unsigned long long)NumRead, (unsigned long long)NumSkipped, (unsigned long long)NumTorn, bOutOfOrder ? ", OUT OF ORDER" : "");
+
+		const bool bPassed = NumRead > 0 && NumTorn == 0 && !bOutOfOrder;
+		printf(bPassed ? "PASSED\n" : "FAILED\n");
+		return bPassed ? 0 : 1;
+	}
+
+	int RunReader(const char* Name)
+	{
+		FViewportSyncPoseStreamReader Reader;
+
+		printf("Waiting for '%s'...\n", Name);
+		while (!Reader.Open(Name))
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		auto LastPrintTime = std::chrono::steady_clock::now();
+		while (Reader.IsWriterAlive())
+		{
+			FViewportSyncPoseStreamRecord Record;
+			bool bHaveRecord = false;
+			uint64_t Skipped = 0;
+			while (Reader.ReadNext(Record, &Skipped))
+			{
+				bHaveRecord = true;
+			}
+
+			// Everything gets read, only print a few times a second
+			const auto Now = std::chrono::steady_clock::now();
+			if (bHaveRecord && Now - LastPrintTime > std::chrono::milliseconds(250))
+			{
+				LastPrintTime = Now;
+				printf("Frame %llu  t=%.3f  %u viewport(s)\n", (unsigned long long)Record.FrameNumber, Record.Time, Record.NumViewports);
+				for (uint32_t Index = 0; Index < Record.NumViewports; ++Index)
+				{
+					const FViewportSyncPoseStreamViewport& Viewport = Record.Viewports[Index];
+					printf("  [%u] camera (%.1f, %.1f, %.1f) rot (%.1f, %.1f, %.1f) fov %.1f",
+						Viewport.TrackId,
+						Viewport.CameraLocation[0], Viewport.CameraLocation[1], Viewport.CameraLocation[2],
+						Viewport.CameraRotation[0], Viewport.CameraRotation[1], Viewport.CameraRotation[2],
+						Viewport.FieldOfView);
+					if (Viewport.Flags & ViewportSyncPoseFlag_HasTarget)
+					{
+						printf(" target (%.1f, %.1f, %.1f)", Viewport.TargetLocation[0], Viewport.TargetLocation[1], Viewport.TargetLocation[2]);
+					}
+					printf("\n");
+				}
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		printf("The editor closed the stream\n");
+		return 0;
+	}
+}
+
+int main(int ArgC, char** ArgV)
+{
+	if (ArgC > 1 && strcmp(ArgV[1], "--selftest") == 0)
+	{
+		return RunSelfTest(ArgC > 2 ? atof(ArgV[2]) : 2.0);
+	}
+
+	return RunReader(ArgC > 1 ? ArgV[1] : VIEWPORTSYNC_POSESTREAM_DEFAULT_NAME);
+}
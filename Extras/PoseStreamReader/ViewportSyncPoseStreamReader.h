@@ -0,0 +1,256 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Header only reader for the Game Viewport Sync camera pose stream, for tools outside the engine.
+ *
+ * Needs ViewportSyncPoseStreamFormat.h (Source/GameViewportSync/Public) on the include path and nothing else,
+ * on Linux link with -lrt if your libc still keeps shm_open there.
+ *
+ * Open takes the same name the editor was given. The engine's FPlatformMemory::MapNamedSharedMemoryRegion puts it in
+ * the Global\ namespace on Windows and at the root ("/") of the POSIX shared memory namespace elsewhere, Open adds
+ * the same prefix.
+ *
+ *     FViewportSyncPoseStreamReader Reader;
+ *     if (Reader.Open())
+ *     {
+ *         FViewportSyncPoseStreamRecord Record;
+ *         while (Reader.ReadNext(Record)) { ... }
+ *     }
+ */
+
+#include "ViewportSyncPoseStreamFormat.h"
+
+#include <atomic>
+#include <string>
+#include <string.h>
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+class FViewportSyncPoseStreamReader
+{
+public:
+	FViewportSyncPoseStreamReader()
+		: Header(nullptr)
+		, Records(nullptr)
+		, NextIndex(0)
+		, MappedMemory(nullptr)
+#ifdef _WIN32
+		, MappingHandle(nullptr)
+#endif
+	{}
+
+	~FViewportSyncPoseStreamReader()
+	{
+		Close();
+	}
+
+	FViewportSyncPoseStreamReader(const FViewportSyncPoseStreamReader&) = delete;
+	FViewportSyncPoseStreamReader& operator=(const FViewportSyncPoseStreamReader&) = delete;
+
+	/* Map the stream the editor created, false if it doesn't exist (yet) or is from an incompatible version */
+	bool Open(const char* Name = VIEWPORTSYNC_POSESTREAM_DEFAULT_NAME)
+	{
+		Close();
+
+#ifdef _WIN32
+		// The engine creates the mapping in the Global\ namespace
+		const std::string GlobalName = std::string("Global\\") + Name;
+		MappingHandle = OpenFileMappingA(FILE_MAP_READ, FALSE, GlobalName.c_str());
+		if (MappingHandle == nullptr)
+		{
+			return false;
+		}
+
+		MappedMemory = MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, VIEWPORTSYNC_POSESTREAM_SIZE);
+#else
+		// The engine puts POSIX shared memory at the root of the namespace
+		const std::string Path = std::string("/") + Name;
+		const int FileDescriptor = shm_open(Path.c_str(), O_RDONLY, 0);
+		if (FileDescriptor < 0)
+		{
+			return false;
+		}
+
+		void* Memory = mmap(nullptr, VIEWPORTSYNC_POSESTREAM_SIZE, PROT_READ, MAP_SHARED, FileDescriptor, 0);
+		close(FileDescriptor);
+		MappedMemory = Memory != MAP_FAILED ? Memory : nullptr;
+#endif
+
+		if (MappedMemory == nullptr || !Attach(MappedMemory))
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	/* Read a stream that is already mapped, e.g. by something else in this process */
+	bool Attach(const void* Memory)
+	{
+		const FViewportSyncPoseStreamHeader* InHeader = static_cast<const FViewportSyncPoseStreamHeader*>(Memory);
+		if (InHeader->Magic != VIEWPORTSYNC_POSESTREAM_MAGIC)
+		{
+			return false;
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (InHeader->Version != VIEWPORTSYNC_POSESTREAM_VERSION
+			|| InHeader->HeaderSize != sizeof(FViewportSyncPoseStreamHeader)
+			|| InHeader->RecordSize != sizeof(FViewportSyncPoseStreamRecord)
+			|| InHeader->Capacity != VIEWPORTSYNC_POSESTREAM_CAPACITY
+			|| InHeader->MaxViewports != VIEWPORTSYNC_POSESTREAM_MAX_VIEWPORTS)
+		{
+			return false;
+		}
+
+		Header = InHeader;
+		Records = reinterpret_cast<const FViewportSyncPoseStreamRecord*>(static_cast<const uint8_t*>(Memory) + sizeof(FViewportSyncPoseStreamHeader));
+		NextIndex = GetWriteCount();
+		return true;
+	}
+
+	void Close()
+	{
+#ifdef _WIN32
+		if (MappedMemory != nullptr)
+		{
+			UnmapViewOfFile(MappedMemory);
+		}
+		if (MappingHandle != nullptr)
+		{
+			CloseHandle(MappingHandle);
+			MappingHandle = nullptr;
+		}
+#else
+		if (MappedMemory != nullptr)
+		{
+			munmap(MappedMemory, VIEWPORTSYNC_POSESTREAM_SIZE);
+		}
+#endif
+		MappedMemory = nullptr;
+		Header = nullptr;
+		Records = nullptr;
+		NextIndex = 0;
+	}
+
+	bool IsOpen() const { return Header != nullptr; }
+
+	/* False once the editor has closed the stream (or PIE ended and it was turned off) */
+	bool IsWriterAlive() const { return Header != nullptr && Header->WriterProcessId != 0; }
+
+	/* Copies the newest complete record, false if nothing has been published */
+	bool ReadLatest(FViewportSyncPoseStreamRecord& OutRecord)
+	{
+		const uint64_t WriteCount = GetWriteCount();
+		if (WriteCount == 0)
+		{
+			return false;
+		}
+
+		NextIndex = WriteCount;
+		return TryCopy(WriteCount - 1, OutRecord);
+	}
+
+	/*
+	 * Copies the record after the last one read, false once caught up with the writer.
+	 * If we fell more than a ring behind the lost records are skipped and counted in OutNumSkipped
+	 */
+	bool ReadNext(FViewportSyncPoseStreamRecord& OutRecord, uint64_t* OutNumSkipped = nullptr)
+	{
+		if (OutNumSkipped != nullptr)
+		{
+			*OutNumSkipped = 0;
+		}
+
+		const uint64_t WriteCount = GetWriteCount();
+
+		// The editor reopened the stream, start over
+		if (NextIndex > WriteCount)
+		{
+			NextIndex = WriteCount;
+		}
+
+		while (NextIndex < WriteCount)
+		{
+			// Keep a slot of slack, the writer may already be overwriting the oldest one
+			if (WriteCount - NextIndex >= VIEWPORTSYNC_POSESTREAM_CAPACITY)
+			{
+				const uint64_t Oldest = WriteCount - VIEWPORTSYNC_POSESTREAM_CAPACITY + 1;
+				if (OutNumSkipped != nullptr)
+				{
+					*OutNumSkipped += Oldest - NextIndex;
+				}
+				NextIndex = Oldest;
+			}
+
+			if (TryCopy(NextIndex++, OutRecord))
+			{
+				return true;
+			}
+
+			if (OutNumSkipped != nullptr)
+			{
+				++*OutNumSkipped;
+			}
+		}
+		return false;
+	}
+
+	uint64_t GetWriteCount() const
+	{
+		const uint64_t WriteCount = Header != nullptr ? Header->WriteCount : 0;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return WriteCount;
+	}
+
+private:
+	/* Seqlock read of record Index, false if it was torn or the writer has lapped it */
+	bool TryCopy(uint64_t Index, FViewportSyncPoseStreamRecord& OutRecord) const
+	{
+		const FViewportSyncPoseStreamRecord& Slot = Records[Index % VIEWPORTSYNC_POSESTREAM_CAPACITY];
+
+		// Each write to a slot adds 2, so record Index is complete when the slot reads exactly this
+		const uint64_t ExpectedSequence = 2 * (Index / VIEWPORTSYNC_POSESTREAM_CAPACITY + 1);
+
+		const uint64_t SequenceBefore = Slot.Sequence;
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (SequenceBefore != ExpectedSequence)
+		{
+			return false;
+		}
+
+		memcpy(&OutRecord, &Slot, sizeof(OutRecord));
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64_t SequenceAfter = Slot.Sequence;
+
+		OutRecord.Sequence = SequenceAfter;
+		if (OutRecord.NumViewports > VIEWPORTSYNC_POSESTREAM_MAX_VIEWPORTS)
+		{
+			return false;
+		}
+		return SequenceBefore == SequenceAfter;
+	}
+
+	const FViewportSyncPoseStreamHeader* Header;
+	const FViewportSyncPoseStreamRecord* Records;
+
+	uint64_t NextIndex;
+
+	void* MappedMemory;
+#ifdef _WIN32
+	HANDLE MappingHandle;
+#endif
+};
@@ -12,7 +12,8 @@ public class GameViewportSync : ModuleRules
 			new string[]
 			{
 				"Core",
-				"EditorSubsystem"
+				"EditorSubsystem",
+				"GameViewportSyncCore"
 			}
 			);
 			
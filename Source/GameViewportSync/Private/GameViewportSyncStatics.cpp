@@ -22,3 +22,12 @@ TSoftObjectPtr<AActor> UGameViewportSyncStatics::GetGlobalViewportFollowTargetOv
 	}
 	return nullptr;
 }
+
+FViewportSyncCommandSender UGameViewportSyncStatics::GetCommandSender()
+{
+	if (USyncViewportSubsystem* SyncViewport = GEditor->GetEditorSubsystem<USyncViewportSubsystem>())
+	{
+		return SyncViewport->GetCommandSender();
+	}
+	return FViewportSyncCommandSender();
+}
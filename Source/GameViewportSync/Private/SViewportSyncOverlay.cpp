@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SViewportSyncOverlay.h"
+#include "ViewportSyncViewModel.h"
+
+// UE Includes
+#include "EditorStyleSet.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/SInvalidationPanel.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "SViewportSyncOverlay"
+
+SViewportSyncOverlay::~SViewportSyncOverlay()
+{
+	if (ViewModel.IsValid())
+	{
+		ViewModel->OnChanged().RemoveAll(this);
+	}
+}
+
+void SViewportSyncOverlay::Construct(const FArguments& InArgs, const TSharedRef<FViewportSyncViewModel>& InViewModel)
+{
+	ViewModel = InViewModel;
+
+	ChildSlot
+	[
+		SNew(SInvalidationPanel)
+		[
+			SAssignNew(Content, SVerticalBox)
+			+ SVerticalBox::Slot()
+			.VAlign(VAlign_Top)
+			.HAlign(HAlign_Center)
+			.AutoHeight()
+			.Padding(2.0f, 1.0f, 2.0f, 1.0f)
+			[
+				SNew(STextBlock)
+				.Text(LOCTEXT("SyncingViewportLablel", "Syncing Viewport"))
+				.Font(FEditorStyle::GetFontStyle(TEXT("MenuItem.Font")))
+				.ColorAndOpacity(FLinearColor(0.4f, 1.0f, 1.0f))
+				.ShadowOffset(FVector2D(1, 1))
+			]
+			+ SVerticalBox::Slot()
+			.VAlign(VAlign_Top)
+			.HAlign(HAlign_Center)
+			.AutoHeight()
+			[
+				SAssignNew(FollowRow, SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				[
+					SNew(STextBlock)
+					.Text(LOCTEXT("FollowingActor", "Following Actor:"))
+					.Font(FEditorStyle::GetFontStyle(TEXT("MenuItem.Font")))
+					.ShadowOffset(FVector2D(1, 1))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4.0f, 1.0f, 2.0f, 1.0f)
+				[
+					SAssignNew(FollowText, STextBlock)
+					.Font(FEditorStyle::GetFontStyle(TEXT("MenuItem.Font")))
+					.ColorAndOpacity(FLinearColor(0.4f, 1.0f, 1.0f))
+					.ShadowOffset(FVector2D(1, 1))
+				]
+			]
+			+ SVerticalBox::Slot()
+			.VAlign(VAlign_Top)
+			.HAlign(HAlign_Center)
+			.AutoHeight()
+			[
+				SAssignNew(ScreenPercentageText, STextBlock)
+				.Font(FEditorStyle::GetFontStyle(TEXT("MenuItem.Font")))
+				.ShadowOffset(FVector2D(1, 1))
+			]
+			+ SVerticalBox::Slot()
+			.VAlign(VAlign_Top)
+			.HAlign(HAlign_Center)
+			.AutoHeight()
+			[
+				SAssignNew(WorldText, STextBlock)
+				.Font(FEditorStyle::GetFontStyle(TEXT("MenuItem.Font")))
+				.ShadowOffset(FVector2D(1, 1))
+			]
+			+ SVerticalBox::Slot()
+			.VAlign(VAlign_Top)
+			.HAlign(HAlign_Center)
+			.AutoHeight()
+			[
+				SAssignNew(SuspendedText, STextBlock)
+				.Text(LOCTEXT("Suspended", "Suspended while hidden"))
+				.Font(FEditorStyle::GetFontStyle(TEXT("MenuItem.Font")))
+				.ColorAndOpacity(FLinearColor(1.0f, 0.6f, 0.2f))
+				.ShadowOffset(FVector2D(1, 1))
+			]
+		]
+	];
+
+	ViewModel->OnChanged().AddSP(this, &SViewportSyncOverlay::OnViewModelChanged);
+	OnViewModelChanged();
+}
+
+void SViewportSyncOverlay::OnViewModelChanged()
+{
+	// Setting these invalidates the widgets, which is what refreshes the invalidation panel's cache
+	Content->SetVisibility(ViewModel->GetOverlayVisibility());
+	FollowRow->SetVisibility(ViewModel->GetFollowVisibility());
+	FollowText->SetText(ViewModel->GetFollowText());
+	ScreenPercentageText->SetVisibility(ViewModel->GetScreenPercentageVisibility());
+	ScreenPercentageText->SetText(ViewModel->GetScreenPercentageText());
+	WorldText->SetVisibility(ViewModel->GetWorldVisibility());
+	WorldText->SetText(ViewModel->GetWorldText());
+	SuspendedText->SetVisibility(ViewModel->GetSuspendedVisibility());
+}
+
+#undef LOCTEXT_NAMESPACE
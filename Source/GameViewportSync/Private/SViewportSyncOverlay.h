@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+class FViewportSyncViewModel;
+class STextBlock;
+
+/**
+ * Overlay shown on synced viewports.
+ * Content is only touched when the view model changes and is cached in an invalidation panel the rest of the time.
+ */
+class SViewportSyncOverlay : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SViewportSyncOverlay) {}
+	SLATE_END_ARGS()
+
+	virtual ~SViewportSyncOverlay();
+
+	void Construct(const FArguments& InArgs, const TSharedRef<FViewportSyncViewModel>& InViewModel);
+
+private:
+	void OnViewModelChanged();
+
+	TSharedPtr<FViewportSyncViewModel> ViewModel;
+
+	TSharedPtr<SWidget> Content;
+	TSharedPtr<SWidget> FollowRow;
+	TSharedPtr<STextBlock> FollowText;
+	TSharedPtr<STextBlock> ScreenPercentageText;
+	TSharedPtr<STextBlock> WorldText;
+	TSharedPtr<STextBlock> SuspendedText;
+};
@@ -2,13 +2,21 @@
 
 #include "SyncViewportSubsystem.h"
 #include "ViewportSyncSettings.h"
+#include "ViewportSyncStats.h"
+#include "SViewportSyncOverlay.h"
+#include "ViewportSyncLevelEditorFollowView.h"
 
 // UE Includes
+#include "DrawDebugHelpers.h"
 #include "Editor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
 #include "IAssetViewport.h"
 #include "LevelEditor.h"
 #include "LevelEditorViewport.h"
 #include "SceneOutlinerModule.h"
+#include "Camera/PlayerCameraManager.h"
 #include "Engine/Selection.h"
 #include "Styling/SlateIconFinder.h"
 #include "SceneOutlinerPublicTypes.h"
@@ -17,11 +25,96 @@
 #include "ViewportSyncEditorCommands.h"
 #include "ToolMenus.h"
 #include "Slate/SceneViewport.h"
+#include "SceneViewExtension.h"
 
 #define LOCTEXT_NAMESPACE "SyncViewportSubsystem"
 
 static const FName LevelEditorModuleName("LevelEditor");
 
+// How many recently closed viewports we hang on to, enough for a 2x2 <-> 1x1 layout switch plus some
+static const int32 MaxPooledViewports = 8;
+
+// Commands game code can send in a frame before they start being dropped
+static const uint32 CommandQueueCapacity = 4096;
+
+// Follow in game time so time dilation and pausing carry over to the synced viewports
+static float GetFollowDeltaTime(const FWorldContext* WorldContext, float EditorDeltaTime)
+{
+	if(const UWorld* World = WorldContext != nullptr ? WorldContext->World() : nullptr)
+	{
+		return World->IsPaused() ? 0.0f : World->GetDeltaSeconds();
+	}
+	return EditorDeltaTime;
+}
+
+static FText GetWorldContextDisplayText(const FWorldContext& WorldContext)
+{
+	const UWorld* World = WorldContext.World();
+	switch(World != nullptr ? World->GetNetMode() : NM_Standalone)
+	{
+	case NM_DedicatedServer:
+		return LOCTEXT("DedicatedServer", "Dedicated Server");
+	case NM_ListenServer:
+		return LOCTEXT("ListenServer", "Listen Server");
+	case NM_Client:
+		return FText::Format(LOCTEXT("Client", "Client {0}"), FText::AsNumber(WorldContext.PIEInstance));
+	default:
+		return FText::Format(LOCTEXT("Standalone", "Standalone {0}"), FText::AsNumber(WorldContext.PIEInstance));
+	}
+}
+
+// Behind another tab, in a collapsed or zero sized layout slot or in a minimized window
+static bool IsViewportHidden(FLevelEditorViewportClient* ViewportClient)
+{
+	// Without a widget (e.g. the benchmark's clients) there's nothing to go on
+	if(!ViewportClient->GetEditorViewportWidget().IsValid() || ViewportClient->Viewport == nullptr)
+	{
+		return false;
+	}
+
+	// Level viewports only count as visible when in the foreground tab and painted recently
+	const FIntPoint Size = ViewportClient->Viewport->GetSizeXY();
+	return Size.X <= 0 || Size.Y <= 0 || !ViewportClient->IsVisible();
+}
+
+static EViewportSyncFocusClass GetViewportFocusClass(FLevelEditorViewportClient* ViewportClient)
+{
+	if(ViewportClient == GCurrentLevelEditingViewportClient || (ViewportClient->Viewport != nullptr && ViewportClient->Viewport->HasFocus()))
+	{
+		return EViewportSyncFocusClass::Focused;
+	}
+
+	const TSharedPtr<SEditorViewport> Viewport = ViewportClient->GetEditorViewportWidget();
+	if(Viewport.IsValid() && Viewport->IsHovered())
+	{
+		return EViewportSyncFocusClass::Hovered;
+	}
+
+	return EViewportSyncFocusClass::Background;
+}
+
+// In Hz, 0 is every frame
+static float GetFocusClassUpdateRate(const UViewportSyncSettings& Settings, EViewportSyncFocusClass FocusClass)
+{
+	switch(FocusClass)
+	{
+	case EViewportSyncFocusClass::Focused:
+		return Settings.FocusedUpdateRate;
+	case EViewportSyncFocusClass::Hovered:
+		return Settings.HoveredUpdateRate;
+	case EViewportSyncFocusClass::EditorNotForeground:
+		return Settings.NotForegroundUpdateRate;
+	default:
+		return Settings.BackgroundUpdateRate;
+	}
+}
+
+static FName GetViewportConfigKey(FLevelEditorViewportClient* ViewportClient)
+{
+	const TSharedPtr<SLevelViewport> LevelViewport = StaticCastSharedPtr<SLevelViewport>(ViewportClient->GetEditorViewportWidget());
+	return LevelViewport.IsValid() ? FName(*LevelViewport->GetConfigKey()) : NAME_None;
+}
+
 DEFINE_LOG_CATEGORY_STATIC(LogViewportSync, Log, All);
 
 const FText USyncViewportSubsystem::SectionExtensionPointText(LOCTEXT("ViewportSync", "Viewport Sync"));
@@ -32,6 +125,13 @@ const FName USyncViewportSubsystem::SelectActorExtensionPointName("ViewportSync_
 
 void USyncViewportSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	// Viewports come and go with every layout change, ids are reused so the recorder's fixed set of tracks never runs out
+	FreeTrackIds.Reset();
+	for(int32 TrackId = FViewportSyncTrajectoryRecorder::MaxTracks - 1; TrackId >= 0; --TrackId)
+	{
+		FreeTrackIds.Add(uint16(TrackId));
+	}
+
 	FViewportSyncEditorCommands::Register();
 
 	FLevelEditorModule& LevelEditorModule = FModuleManager::LoadModuleChecked<FLevelEditorModule>(LevelEditorModuleName);
@@ -52,53 +152,476 @@ void USyncViewportSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	FEditorDelegates::PreBeginPIE.AddUObject(this, &USyncViewportSubsystem::OnPrePIEBegin);
 	FEditorDelegates::PostPIEStarted.AddUObject(this, &USyncViewportSubsystem::OnPIEPostStarted);
 	FEditorDelegates::EndPIE.AddUObject(this, &USyncViewportSubsystem::OnPIEEnded);
+
+	GetMutableDefault<UViewportSyncSettings>()->OnSettingChanged().AddUObject(this, &USyncViewportSubsystem::OnSettingsChanged);
+
+	RenderProfileViewExtension = FSceneViewExtensions::NewExtension<FViewportSyncRenderProfileViewExtension>();
+	CommandQueue = MakeShared<FViewportSyncCommandQueue, ESPMode::ThreadSafe>(CommandQueueCapacity);
+
+	InitializeTrajectoryRecorder();
+	UpdatePoseStream();
+	RegisterConsoleCommands();
 }
 
 void USyncViewportSubsystem::OnPostEditorTick(float DeltaTime)
 {
-	const float FollowActorSmoothSpeed = GetDefault<UViewportSyncSettings>()->FollowActorSmoothSpeed;
+	SCOPE_CYCLE_COUNTER(STAT_ViewportSync_PostEditorTick);
+	CSV_SCOPED_TIMING_STAT(ViewportSync, PostEditorTick);
+
+	if(NextStagedViewport < StagedViewports.Num())
+	{
+		ApplyStagedViewportSettings(GetDefault<UViewportSyncSettings>()->PIEStartFrameBudgetMs);
+	}
+
+	ExecuteQueuedCommands();
+
+	const UViewportSyncSettings* Settings = GetDefault<UViewportSyncSettings>();
+	const float FollowActorMovementThresholdSquared = FMath::Square(Settings->FollowActorMovementThreshold);
+
+	int32 NumSyncedViewports = 0;
+	int32 NumSuspendedViewports = 0;
+	int32 NumThrottledViewports = 0;
+	int32 NumIdleViewports = 0;
+	int32 NumStreamingViewsAdded = 0;
+	int32 NumStreamingViewsRemoved = 0;
+
+	// Most viewports watch the default instance so only work its time out once
+	const float DefaultFollowDeltaTime = GetFollowDeltaTime(PIEWorldContext, DeltaTime);
+
+	const bool bSuspendHiddenViewports = Settings->bSuspendHiddenViewports;
+	const bool bPrefetchFollowTargets = Settings->bPrefetchFollowTargets;
+	const float RenderOnChangeSettleTime = Settings->RenderOnChangeSettleTime;
+
+	// Same rule the editor uses to idle itself when alt-tabbed away
+	const bool bEditorThrottled = bFocusPriority && GEditor->ShouldThrottleCPUUsage();
+	const double CurrentTime = FPlatformTime::Seconds();
+
+	const bool bRecordingTrajectories = TrajectoryRecorder.IsEnabled();
+	if(bRecordingTrajectories)
+	{
+		TrajectoryRecorder.BeginFrame();
+	}
+
+	const bool bPublishingPoses = PoseStream.IsOpen();
+	if(bPublishingPoses)
+	{
+		PoseStream.BeginRecord(GFrameCounter, FPlatformTime::Seconds());
+	}
+
+	// Already done straight after the world ticked when following there
+	const AActor* GlobalFollowActor = bFollowAfterWorldTick ? nullptr : ResolveGlobalFollowActor();
 	
-	for(auto& ViewportInfo : ViewportInfos)
+	for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
 	{
-		if(ViewportInfo.Value.bIsPIEViewport)
+		FSyncViewportState& ViewportState = ViewportStates.HotAt(ViewportIndex);
+
+		if(ViewportState.bIsPIEViewport || ViewportState.bPIEStartStaged)
 		{
-			// We don't want to mess around with the active PIE viewport
+			// We don't want to mess around with the active PIE viewport, or ones that aren't set up yet
 			continue;
 		}
 		
-		if(ViewportInfo.Value.bSync)
+		if(ViewportState.bSync)
 		{
-			const AActor* FollowActor = GlobalFollowActorOverride.IsValid() ? GlobalFollowActorOverride.Get() : ViewportInfo.Value.FollowActor.Get();
-			if(FollowActor != nullptr)
+			++NumSyncedViewports;
+
+			FLevelEditorViewportClient* ViewportClient = ViewportStates.KeyAt(ViewportIndex);
+
+			// Turning the setting off resumes everything on the next tick
+			const bool bHidden = bSuspendHiddenViewports && IsViewportHidden(ViewportClient);
+			const bool bResumed = !bHidden && ViewportState.bSuspended;
+			if(bHidden != ViewportState.bSuspended)
 			{
-				/*
-				 * This could happen if the Actor we intended to follow wasn't first available when we hit play
-				 * Such as a player pawn or some other object
-				 */ 
-				if(ViewportInfo.Key->bUsingOrbitCamera == false)
+				if(bHidden)
 				{
-					ApplyViewportFollowActor(ViewportInfo.Key, FollowActor);
+					SuspendViewport(ViewportStates.HandleAt(ViewportIndex));
 				}
-				/*
-				 * To get the combination required to allow for orbiting and *not* allowing the user to control was getting really convoluted.
-				 * Ultimately it meant setting the actor lock but I didn't like the "Controlling Actor" UI or behaviour
-				 * 
-				 * The result of this means each frame we update the look at location so the camera correctly updates to the follow actor's new location
-				 */
 				else
-				{					
-					const FVector ActorLocation = FollowActor->GetActorLocation();
-					
-					ViewportInfo.Key->SetViewLocationForOrbiting
-					(
-						FMath::VInterpConstantTo(ViewportInfo.Value.PreviousFollowLocation, ActorLocation, DeltaTime, FollowActorSmoothSpeed),
-						(ViewportInfo.Key->GetLookAtLocation() - ViewportInfo.Key->GetViewLocation()).Size()
-					);
-
-					ViewportInfo.Value.PreviousFollowLocation = ActorLocation;
+				{
+					ResumeViewport(ViewportStates.HandleAt(ViewportIndex));
+				}
+			}
+
+			if(ViewportState.bSuspended)
+			{
+				++NumSuspendedViewports;
+				continue;
+			}
+
+			// Throttled viewports are still on screen so this happens before focus priority skips them
+			if(ViewportState.StreamingPolicy != EViewportSyncStreamingPolicy::Full)
+			{
+				const FVector ViewLocation = ViewportClient->GetViewLocation();
+
+				// The editor drew it this frame from where it is now, before we move the camera below
+				if(FViewportSyncStreaming::RemoveRenderedViewLocation(ViewportState.SyncedWorldContext->World(), ViewLocation))
+				{
+					++NumStreamingViewsRemoved;
+				}
+
+				if(ViewportState.StreamingPolicy == EViewportSyncStreamingPolicy::Reduced)
+				{
+					FViewportSyncStreaming::AddView(*ViewportClient, ViewLocation, Settings->ReducedStreamingBoost);
+					++NumStreamingViewsAdded;
+				}
+			}
+
+			// The camera moves with its target, so stream in around where the camera will be once the target gets where it's heading
+			if(bPrefetchFollowTargets && ViewportState.StreamingPolicy != EViewportSyncStreamingPolicy::None && ViewportState.Follow.Filter.IsInitialized() && !ViewportState.Follow.Filter.GetVelocity().IsNearlyZero())
+			{
+				const FVector PrefetchLocation = ViewportClient->GetViewLocation() + ViewportState.Follow.Filter.GetVelocity() * Settings->PrefetchLookAheadTime;
+				const float BoostFactor = ViewportState.StreamingPolicy == EViewportSyncStreamingPolicy::Reduced ? Settings->ReducedStreamingBoost : 1.0f;
+
+				FViewportSyncStreaming::AddView(*ViewportClient, PrefetchLocation, BoostFactor);
+				++NumStreamingViewsAdded;
+			}
+
+			if(bFocusPriority)
+			{
+				const EViewportSyncFocusClass FocusClass = bEditorThrottled ? EViewportSyncFocusClass::EditorNotForeground : GetViewportFocusClass(ViewportClient);
+				if(FocusClass != ViewportState.FocusClass)
+				{
+					ViewportState.FocusClass = FocusClass;
+					Scheduler.SetMaxRate(ViewportStates.HandleAt(ViewportIndex), GetFocusClassUpdateRate(*Settings, FocusClass));
+				}
+			}
+
+			// A resumed viewport missed this frame's world tick, catch it up now rather than drawing it where it was
+			if(!bFollowAfterWorldTick || bResumed)
+			{
+				ViewportState.Follow.PendingDeltaTime += ViewportState.SyncedWorldContext == PIEWorldContext ? DefaultFollowDeltaTime : GetFollowDeltaTime(ViewportState.SyncedWorldContext, DeltaTime);
+
+				if(ShouldUpdateFollow(ViewportState, CurrentTime, DeltaTime))
+				{
+					UpdateViewportFollow(ViewportIndex, bFollowAfterWorldTick ? ResolveGlobalFollowActor() : GlobalFollowActor, FollowActorMovementThresholdSquared);
+				}
+			}
+
+			// After the camera has moved, so a follow that is still catching up keeps it awake
+			if(bRenderingOnChange)
+			{
+				UpdateViewportRenderOnChange(ViewportIndex, DeltaTime, RenderOnChangeSettleTime);
+				if(ViewportState.bRenderIdle)
+				{
+					++NumIdleViewports;
+				}
+			}
+
+			// Focus priority held the camera back this frame, so there's nothing new to record or publish
+			if(!ViewportState.bFollowUpdated)
+			{
+				++NumThrottledViewports;
+				continue;
+			}
+			ViewportState.bFollowUpdated = false;
+
+			const FVector* FollowTargetLocation = ViewportState.bHasFollowTargetLocation ? &ViewportState.FollowTargetLocation : nullptr;
+
+			if(bRecordingTrajectories)
+			{
+				TrajectoryRecorder.AddSample(ViewportState.TrajectoryTrackId, ViewportClient->GetViewLocation(), ViewportClient->GetViewRotation(), FollowTargetLocation);
+			}
+
+			// Written straight into shared memory
+			if(FViewportSyncPoseStreamViewport* Pose = bPublishingPoses ? PoseStream.AddViewport() : nullptr)
+			{
+				const FVector ViewLocation = ViewportClient->GetViewLocation();
+				const FRotator ViewRotation = ViewportClient->GetViewRotation();
+
+				Pose->TrackId = ViewportState.TrajectoryTrackId;
+				Pose->Flags = (FollowTargetLocation != nullptr ? ViewportSyncPoseFlag_HasTarget : 0) | (ViewportState.SyncedWorldContext != PIEWorldContext ? ViewportSyncPoseFlag_OtherInstance : 0);
+				Pose->CameraLocation[0] = ViewLocation.X;
+				Pose->CameraLocation[1] = ViewLocation.Y;
+				Pose->CameraLocation[2] = ViewLocation.Z;
+				Pose->CameraRotation[0] = ViewRotation.Pitch;
+				Pose->CameraRotation[1] = ViewRotation.Yaw;
+				Pose->CameraRotation[2] = ViewRotation.Roll;
+				Pose->FieldOfView = ViewportClient->ViewFOV;
+				Pose->TargetLocation[0] = ViewportState.FollowTargetLocation.X;
+				Pose->TargetLocation[1] = ViewportState.FollowTargetLocation.Y;
+				Pose->TargetLocation[2] = ViewportState.FollowTargetLocation.Z;
+			}
+
+			// Don't leave the stale image from before it was hidden up for a frame
+			if(bResumed && ViewportClient->Viewport != nullptr)
+			{
+				ViewportClient->Viewport->Draw();
+			}
+		}
+	}
+
+	if(bRecordingTrajectories)
+	{
+		TrajectoryRecorder.EndFrame();
+	}
+
+	if(bPublishingPoses)
+	{
+		PoseStream.EndRecord();
+	}
+
+	SET_DWORD_STAT(STAT_ViewportSync_SyncedViewports, NumSyncedViewports);
+	SET_DWORD_STAT(STAT_ViewportSync_SuspendedViewports, NumSuspendedViewports);
+	SET_DWORD_STAT(STAT_ViewportSync_ThrottledViewports, NumThrottledViewports);
+	SET_DWORD_STAT(STAT_ViewportSync_IdleViewports, NumIdleViewports);
+	SET_DWORD_STAT(STAT_ViewportSync_StreamingViewsAdded, NumStreamingViewsAdded);
+	SET_DWORD_STAT(STAT_ViewportSync_FollowTargetsResolved, FollowStats.NumResolved);
+	SET_DWORD_STAT(STAT_ViewportSync_FollowTargetsPending, FollowStats.NumPending);
+	SET_DWORD_STAT(STAT_ViewportSync_FollowGroupMembers, FollowStats.NumGroupMembers);
+	SET_FLOAT_STAT(STAT_ViewportSync_MaxFollowLag, FollowStats.MaxLag);
+
+	CSV_CUSTOM_STAT(ViewportSync, SyncedViewports, NumSyncedViewports, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ViewportSync, SuspendedViewports, NumSuspendedViewports, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ViewportSync, ThrottledViewports, NumThrottledViewports, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ViewportSync, IdleViewports, NumIdleViewports, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ViewportSync, StreamingViewsAdded, NumStreamingViewsAdded, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ViewportSync, FollowTargetsResolved, FollowStats.NumResolved, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ViewportSync, FollowTargetsPending, FollowStats.NumPending, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ViewportSync, FollowGroupMembers, FollowStats.NumGroupMembers, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ViewportSync, MaxFollowLag, FollowStats.MaxLag, ECsvCustomStatOp::Set);
+
+	// Counted again from the next world tick
+	FollowStats.Reset();
+
+	if(bGoverningScreenPercentage && ScreenPercentageGovernor.Tick(DeltaTime, *GetDefault<UViewportSyncSettings>()))
+	{
+		for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+		{
+			FLiveViewportInfo& ViewportInfo = ViewportStates.ColdAt(ViewportIndex);
+			if(ViewportInfo.ScreenPercentage > 0)
+			{
+				ApplyViewportScreenPercentage(ViewportStates.KeyAt(ViewportIndex), ViewportInfo);
+			}
+		}
+	}
+
+	if(bSchedulingViewports || bFocusPriority)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ViewportSync_ScheduledRedraws);
+		CSV_SCOPED_TIMING_STAT(ViewportSync, ScheduledRedraws);
+
+		Scheduler.Tick(GFrameCounter, CurrentTime, bSchedulingViewports ? Settings->SyncedViewportFrameBudgetMs : 0.0f, [this, &NumStreamingViewsRemoved](FViewportSyncHandle ViewportHandle)
+		{
+			FLevelEditorViewportClient* ViewportClient = ViewportStates.GetKey(ViewportHandle);
+			if(ViewportClient != nullptr && ViewportClient->Viewport != nullptr)
+			{
+				ViewportClient->Viewport->Draw();
+
+				// Take back what this draw told the world, the same as for the editor's own draws above
+				const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+				if(ViewportState != nullptr && ViewportState->SyncedWorldContext != nullptr && ViewportState->StreamingPolicy != EViewportSyncStreamingPolicy::Full
+					&& FViewportSyncStreaming::RemoveRenderedViewLocation(ViewportState->SyncedWorldContext->World(), ViewportClient->GetViewLocation()))
+				{
+					++NumStreamingViewsRemoved;
 				}
 			}
+		});
+	}
+
+	SET_DWORD_STAT(STAT_ViewportSync_StreamingViewsRemoved, NumStreamingViewsRemoved);
+	CSV_CUSTOM_STAT(ViewportSync, StreamingViewsRemoved, NumStreamingViewsRemoved, ECsvCustomStatOp::Set);
+}
+
+void USyncViewportSubsystem::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	if(World == nullptr || World->WorldType != EWorldType::PIE)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ViewportSync_WorldPostActorTick);
+	CSV_SCOPED_TIMING_STAT(ViewportSync, WorldPostActorTick);
+
+	const UViewportSyncSettings* Settings = GetDefault<UViewportSyncSettings>();
+	const float FollowActorMovementThresholdSquared = FMath::Square(Settings->FollowActorMovementThreshold);
+	const float FollowDeltaTime = World->IsPaused() ? 0.0f : DeltaTime;
+	const double CurrentTime = FPlatformTime::Seconds();
+
+	// Every PIE instance ticks its own world, only the viewports watching this one move now
+	const AActor* GlobalFollowActor = nullptr;
+	bool bResolvedGlobalFollowActor = false;
+
+	for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+	{
+		FSyncViewportState& ViewportState = ViewportStates.HotAt(ViewportIndex);
+
+		if(!ViewportState.bSync || ViewportState.bSuspended || ViewportState.bIsPIEViewport || ViewportState.bPIEStartStaged)
+		{
+			continue;
+		}
+
+		if(ViewportState.SyncedWorldContext == nullptr || ViewportState.SyncedWorldContext->World() != World)
+		{
+			continue;
+		}
+
+		ViewportState.Follow.PendingDeltaTime += FollowDeltaTime;
+
+		if(ShouldUpdateFollow(ViewportState, CurrentTime, FApp::GetDeltaTime()))
+		{
+			if(!bResolvedGlobalFollowActor)
+			{
+				GlobalFollowActor = ResolveGlobalFollowActor();
+				bResolvedGlobalFollowActor = true;
+			}
+			UpdateViewportFollow(ViewportIndex, GlobalFollowActor, FollowActorMovementThresholdSquared);
+		}
+	}
+}
+
+const AActor* USyncViewportSubsystem::ResolveGlobalFollowActor()
+{
+	const AActor* GlobalFollowActor = nullptr;
+	if(!GlobalFollowActorOverride.IsNull() && !bGlobalFollowActorPending)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ViewportSync_ResolveFollowActor);
+		CSV_SCOPED_TIMING_STAT(ViewportSync, ResolveFollowActor);
+
+		GlobalFollowActor = GlobalFollowActorOverride.Get();
+
+		if(GlobalFollowActor == nullptr)
+		{
+			bGlobalFollowActorPending = true;
+			PendingFollowTargets.Add(GlobalFollowActorOverride.ToSoftObjectPath(), FViewportSyncHandle());
+		}
+	}
+
+	// Overlays show "Waiting for" vs "Following" so they need to hear about the override appearing or going away
+	if(bGlobalFollowActorResolved != (GlobalFollowActor != nullptr))
+	{
+		bGlobalFollowActorResolved = GlobalFollowActor != nullptr;
+		RefreshAllViewportViewModels();
+	}
+
+	return GlobalFollowActor;
+}
+
+bool USyncViewportSubsystem::ShouldUpdateFollow(FSyncViewportState& ViewportState, double CurrentTime, float DeltaTime)
+{
+	if(!bFocusPriority)
+	{
+		return true;
+	}
+
+	return FViewportSyncFollowCore::ShouldUpdate(ViewportState.Follow, CurrentTime, DeltaTime, GetFocusClassUpdateRate(*GetDefault<UViewportSyncSettings>(), ViewportState.FocusClass));
+}
+
+void USyncViewportSubsystem::UpdateViewportFollow(int32 ViewportIndex, const AActor* GlobalFollowActor, float FollowActorMovementThresholdSquared)
+{
+	FSyncViewportState& ViewportState = ViewportStates.HotAt(ViewportIndex);
+
+	const bool bHasGlobalFollowActorOverride = !GlobalFollowActorOverride.IsNull();
+	const bool bHasGlobalFollowLocationOverride = GlobalFollowLocationOverride.IsSet();
+
+	const float FollowDeltaTime = FViewportSyncFollowCore::ConsumeDeltaTime(ViewportState.Follow);
+
+	// Where the camera's target is this frame, for the trajectory recorder and pose stream
+	ViewportState.bHasFollowTargetLocation = false;
+
+	if(ViewportState.bMirrorPlayer)
+	{
+		MirrorViewportPlayer(ViewportIndex);
+		ViewportState.bFollowUpdated = true;
+		return;
+	}
+
+	// Let the rule pick this frame's follow actor first, the overrides still win over it
+	if(ViewportState.bHasAutoFollow && GlobalFollowActor == nullptr && !bHasGlobalFollowLocationOverride)
+	{
+		UpdateViewportAutoFollow(ViewportIndex);
+	}
+
+	const AActor* FollowActor = GlobalFollowActor != nullptr ? GetActorInViewportWorld(GlobalFollowActor, ViewportState) : nullptr;
+	if(FollowActor == nullptr && ViewportState.bHasFollowActor && !bHasGlobalFollowLocationOverride)
+	{
+		// Only go through the soft pointer when our cached actor has gone stale, and not at all while we wait for it to spawn
+		if(!ViewportState.bFollowActorPending && !ViewportState.ResolvedFollowActor.IsValid())
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ViewportSync_ResolveFollowActor);
+			CSV_SCOPED_TIMING_STAT(ViewportSync, ResolveFollowActor);
+
+			const FLiveViewportInfo& ViewportInfo = ViewportStates.ColdAt(ViewportIndex);
+			ViewportState.ResolvedFollowActor = const_cast<AActor*>(GetActorInViewportWorld(ViewportInfo.FollowActor.Get(), ViewportState));
+
+			if(!ViewportState.ResolvedFollowActor.IsValid())
+			{
+				ViewportState.bFollowActorPending = true;
+				PendingFollowTargets.Add(ViewportInfo.FollowActor.ToSoftObjectPath(), ViewportStates.HandleAt(ViewportIndex));
+			}
+		}
+		FollowActor = ViewportState.ResolvedFollowActor.Get();
+
+		if(ViewportState.bFollowActorResolved != (FollowActor != nullptr))
+		{
+			ViewportState.bFollowActorResolved = FollowActor != nullptr;
+			RefreshViewportViewModel(ViewportStates.HandleAt(ViewportIndex));
+		}
+	}
+
+	if(bHasGlobalFollowLocationOverride)
+	{
+		++FollowStats.NumResolved;
+		FollowViewportLocation(ViewportIndex, GlobalFollowLocationOverride.GetValue(), FollowDeltaTime, FollowActorMovementThresholdSquared);
+	}
+	else if(FollowActor == nullptr && ViewportState.bHasFollowGroup && !bHasGlobalFollowActorOverride)
+	{
+		FViewportSyncFollowGroupFrame GroupFrame;
+		if(FollowViewportGroup(ViewportIndex, FollowDeltaTime, FollowActorMovementThresholdSquared, GroupFrame))
+		{
+			++FollowStats.NumResolved;
+			FollowStats.NumGroupMembers += GroupFrame.NumMembers;
+
+			ViewportState.bHasFollowTargetLocation = true;
+			ViewportState.FollowTargetLocation = GroupFrame.Center;
+
+			const float FollowLag = FVector::Dist(ViewportState.Follow.LastAppliedLocation, GroupFrame.Center);
+			FollowStats.MaxLag = FMath::Max(FollowStats.MaxLag, FollowLag);
+#if CSV_PROFILER
+			if(FCsvProfiler::Get()->IsCapturing())
+			{
+				FCsvProfiler::RecordCustomStat(ViewportStates.ColdAt(ViewportIndex).FollowLagStatName, CSV_CATEGORY_INDEX(ViewportSync), FollowLag, ECsvCustomStatOp::Set);
+			}
+#endif
+		}
+		else
+		{
+			++FollowStats.NumPending;
+		}
+	}
+	else if(FollowActor == nullptr)
+	{
+		if(bHasGlobalFollowActorOverride || ViewportState.bHasFollowActor)
+		{
+			++FollowStats.NumPending;
+		}
+	}
+	else
+	{
+		++FollowStats.NumResolved;
+		FollowViewportLocation(ViewportIndex, FollowActor->GetActorLocation(), FollowDeltaTime, FollowActorMovementThresholdSquared);
+	}
+
+	ViewportState.bFollowUpdated = true;
+}
+
+void USyncViewportSubsystem::FollowViewportLocation(int32 ViewportIndex, const FVector& Location, float FollowDeltaTime, float FollowActorMovementThresholdSquared)
+{
+	FSyncViewportState& ViewportState = ViewportStates.HotAt(ViewportIndex);
+
+	ViewportState.bHasFollowTargetLocation = true;
+	ViewportState.FollowTargetLocation = Location;
+
+	FViewportSyncLevelEditorFollowView FollowView(*ViewportStates.KeyAt(ViewportIndex));
+	float FollowLag = 0.0f;
+	if(FViewportSyncFollowCore::FollowLocation(ViewportState.Follow, FollowView, Location, FollowDeltaTime, FollowActorMovementThresholdSquared, FollowLag))
+	{
+		FollowStats.MaxLag = FMath::Max(FollowStats.MaxLag, FollowLag);
+#if CSV_PROFILER
+		if(FCsvProfiler::Get()->IsCapturing())
+		{
+			FCsvProfiler::RecordCustomStat(ViewportStates.ColdAt(ViewportIndex).FollowLagStatName, CSV_CATEGORY_INDEX(ViewportSync), FollowLag, ECsvCustomStatOp::Set);
 		}
+#endif
 	}
 }
 
@@ -106,163 +629,257 @@ void USyncViewportSubsystem::Deinitialize()
 {
 	GEditor->OnPostEditorTick().RemoveAll(this);
 	GEditor->OnLevelViewportClientListChanged().RemoveAll(this);
+	FWorldDelegates::OnWorldPostActorTick.Remove(WorldPostActorTickHandle);
 
 	FEditorDelegates::PreBeginPIE.RemoveAll(this);
 	FEditorDelegates::PostPIEStarted.RemoveAll(this);
 	FEditorDelegates::EndPIE.RemoveAll(this);
 
+	GetMutableDefault<UViewportSyncSettings>()->OnSettingChanged().RemoveAll(this);
+
+	UnRegisterConsoleCommands();
+	PoseStream.Close();
+	RenderProfileViewExtension.Reset();
+
 	if (FLevelEditorModule* LevelEditorModule = FModuleManager::GetModulePtr<FLevelEditorModule>(LevelEditorModuleName))
 	{
 		UnRegisterCommands(LevelEditorModule->GetGlobalLevelEditorActions());
 	}
 }
 
-void USyncViewportSubsystem::SaveInformationForViewport(FLevelEditorViewportClient* ViewportClient, const FLiveViewportInfo& InfoToSave)
+void USyncViewportSubsystem::SaveInformationForViewport(FLevelEditorViewportClient* ViewportClient, const FSyncViewportState& StateToSave, const FLiveViewportInfo& InfoToSave)
 {
 	// TODO: Saving	
 }
 
-USyncViewportSubsystem::FLiveViewportInfo USyncViewportSubsystem::LoadInformationForViewport(FLevelEditorViewportClient* ViewportClient)
+void USyncViewportSubsystem::LoadInformationForViewport(FLevelEditorViewportClient* ViewportClient, FSyncViewportState& OutState, FLiveViewportInfo& OutInfo)
 {
 	// TODO: Real Loading
 	
 	const UViewportSyncSettings* ViewportDefault = GetDefault<UViewportSyncSettings>();
-	return { ViewportDefault->bSyncByDefault, nullptr };
+
+	OutState.bSync = ViewportDefault->bSyncByDefault;
+	OutInfo.RefreshRate = FViewportSyncRefreshRate::Hz(ViewportDefault->DefaultSyncedViewportRefreshRate);
+	OutState.Follow.FilterSettings = ViewportDefault->MakeFollowFilterSettings();
+	OutState.StreamingPolicy = ViewportDefault->DefaultStreamingPolicy;
 }
 
 
 void USyncViewportSubsystem::OnLevelViewportClientListChanged()
 {
-	const TArray<FLevelEditorViewportClient*> LevelViewportClients = GEditor->GetLevelViewportClients();
+	SCOPE_CYCLE_COUNTER(STAT_ViewportSync_ViewportClientListChanged);
+	CSV_SCOPED_TIMING_STAT(ViewportSync, ViewportClientListChanged);
 
-	// Remove viewports that don't exist anymore.
-	for (auto It = ViewportInfos.CreateIterator(); It; ++It)
+	// The cached active viewport may be one that just went away
+	bActiveViewportClientCached = false;
+
+	const TArray<FLevelEditorViewportClient*>& LevelViewportClients = GEditor->GetLevelViewportClients();
+
+	TSet<FLevelEditorViewportClient*> LevelViewportClientSet;
+	LevelViewportClientSet.Reserve(LevelViewportClients.Num());
+	LevelViewportClientSet.Append(LevelViewportClients);
+
+	// Remove viewports that don't exist anymore. Backwards as removing swaps the last entry into the hole
+	for (int32 ViewportIndex = ViewportStates.Num() - 1; ViewportIndex >= 0; --ViewportIndex)
 	{
-		if (!LevelViewportClients.Contains(It.Key()))
+		FLevelEditorViewportClient* ViewportClient = ViewportStates.KeyAt(ViewportIndex);
+		if (!LevelViewportClientSet.Contains(ViewportClient))
 		{
-			SaveInformationForViewport(It.Key(), It.Value());
+			const FViewportSyncHandle ViewportHandle = ViewportStates.HandleAt(ViewportIndex);
+
+			SaveInformationForViewport(ViewportClient, ViewportStates.HotAt(ViewportIndex), ViewportStates.ColdAt(ViewportIndex));
 
-			RevertViewportSettings(It.Key(), It.Value());
+			if (!ReleaseViewportToPool(ViewportHandle))
+			{
+				RevertViewportSettings(ViewportHandle);
 
-			ViewportInfos.Remove(It.Key());
+				PendingFollowTargets.Remove(ViewportHandle);
+				ReleaseTrackId(ViewportStates.GetHot(ViewportHandle)->TrajectoryTrackId);
+				ViewportStates.Remove(ViewportHandle);
+			}
 		}
 	}
 	
 	// Add recently added viewports that we don't know about yet.
 	for (FLevelEditorViewportClient* LevelViewportClient : LevelViewportClients)
 	{
-		if (!ViewportInfos.Contains(LevelViewportClient))
+		if (!ViewportStates.Contains(LevelViewportClient) && !RestoreViewportFromPool(LevelViewportClient))
 		{
 			// TODO: Load
-			FLiveViewportInfo LoadedInfo = LoadInformationForViewport(LevelViewportClient);
+			FSyncViewportState LoadedState(false);
+			FLiveViewportInfo LoadedInfo(nullptr);
+			LoadInformationForViewport(LevelViewportClient, LoadedState, LoadedInfo);
+			LoadedState.TrajectoryTrackId = AllocateTrackId();
+			LoadedInfo.FollowLagStatName = *FString::Printf(TEXT("FollowLag_Viewport%d"), LoadedState.TrajectoryTrackId);
+			LoadedState.bHasFollowActor = !LoadedInfo.FollowActor.IsNull();
 			
-			ViewportInfos.Emplace(LevelViewportClient, MoveTemp(LoadedInfo));
+			TrajectoryRecorder.SetTrackName(LoadedState.TrajectoryTrackId, GetViewportConfigKey(LevelViewportClient));
+
+			const FViewportSyncHandle ViewportHandle = ViewportStates.Add(LevelViewportClient, MoveTemp(LoadedState), MoveTemp(LoadedInfo));
+			RefreshViewportViewModel(ViewportHandle);
 
 			// We're playing, update all settings
 			if(PIEWorldContext != nullptr)
 			{
-				ApplyViewportSettings(LevelViewportClient, ViewportInfos.FindChecked(LevelViewportClient));
+				ApplyViewportSettings(ViewportHandle);
 			}
 		}
 	}
 }
 
-USyncViewportSubsystem::FLiveViewportInfo::FLiveViewportInfo(bool bShouldSync, const TSoftObjectPtr<AActor>& ActorToFollow)
-	: bIsPIEViewport(false)
-	, bSync(bShouldSync)
-	, FollowActor(ActorToFollow)
-	, PreviousFollowLocation(FVector::ZeroVector)
-{}
-
-TSharedRef<SWidget> USyncViewportSubsystem::FLiveViewportInfo::GetOverlayWidget() const
+bool USyncViewportSubsystem::ReleaseViewportToPool(FViewportSyncHandle ViewportHandle)
 {
-	// Create on demand
-	if(!OverlayWidget.IsValid())
+	FLevelEditorViewportClient* ViewportClient = ViewportStates.GetKey(ViewportHandle);
+	const FName ConfigKey = GetViewportConfigKey(ViewportClient);
+	if (ConfigKey.IsNone())
 	{
-		const USyncViewportSubsystem* ViewportSyncSubSystem = GEditor->GetEditorSubsystem<USyncViewportSubsystem>();
-			
-		SAssignNew(OverlayWidget, SVerticalBox)
-		.Visibility_Lambda([]
-		{
-			if (GetDefault<UViewportSyncSettings>()->bShowOverlay)
-			{
-				return EVisibility::HitTestInvisible;
-			}
-			return EVisibility::Hidden;
+		return false;
+	}
 
-		})
-		+ SVerticalBox::Slot()
-		.VAlign(VAlign_Top)
-		.HAlign(HAlign_Center)
-		.AutoHeight()
-		.Padding(2.0f, 1.0f, 2.0f, 1.0f)
-		[
-			SNew(STextBlock)
-			.Text(LOCTEXT("SyncingViewportLablel", "Syncing Viewport"))
-			.Font(FEditorStyle::GetFontStyle(TEXT("MenuItem.Font")))
-			.ColorAndOpacity(FLinearColor(0.4f, 1.0f, 1.0f))
-			.ShadowOffset(FVector2D(1, 1))
-		]
-		+ SVerticalBox::Slot()
-		.VAlign(VAlign_Top)
-		.HAlign(HAlign_Center)
-		.AutoHeight()
-		[
-			SNew(SHorizontalBox)
-			.Visibility_Lambda([this, ViewportSyncSubSystem]
-			{
-				const TSoftObjectPtr<AActor> GlobalFollowActorOverride = ViewportSyncSubSystem->GetGlobalViewportFollowTargetOverride();
-				const TSoftObjectPtr<AActor> TargetActor = !GlobalFollowActorOverride.IsNull() ? GlobalFollowActorOverride : FollowActor;
+	/*
+	 * The client is on its way out so there's no point restoring its realtime, world or camera settings.
+	 * We only need to drop anything that would otherwise hang on to it.
+	 */
+	Scheduler.RemoveViewport(ViewportHandle);
 
-				if (TargetActor.IsValid() || TargetActor.IsPending())
-				{
-					return EVisibility::HitTestInvisible;
-				}
-				return EVisibility::Hidden;
-			})
-			+ SHorizontalBox::Slot()
-			[
-				SNew(STextBlock)
-				.Text(LOCTEXT("FollowingActor", "Following Actor:"))
-				.Font(FEditorStyle::GetFontStyle(TEXT("MenuItem.Font")))
-				.ShadowOffset(FVector2D(1, 1))
-			]
-			+ SHorizontalBox::Slot()
-			.AutoWidth()
-			.Padding(4.0f, 1.0f, 2.0f, 1.0f)
-			[
-				SNew(STextBlock)
-				.Text_Lambda([this, ViewportSyncSubSystem]
-				{
-					const TSoftObjectPtr<AActor> GlobalFollowActorOverride = ViewportSyncSubSystem->GetGlobalViewportFollowTargetOverride();
-					const TSoftObjectPtr<AActor> TargetActor = !GlobalFollowActorOverride.IsNull() ? GlobalFollowActorOverride : FollowActor;
-					
-					FString FollowActorName;
+	FLiveViewportInfo& ViewportInfo = *ViewportStates.GetCold(ViewportHandle);
+	
+	TSharedPtr<SLevelViewport> Viewport = StaticCastSharedPtr<SLevelViewport>(ViewportClient->GetEditorViewportWidget());
+	if (Viewport.IsValid())
+	{
+		Viewport->RemoveOverlayWidget(ViewportInfo.GetOverlayWidget());
+	}
 
-					if (TargetActor.IsValid())
-					{
-						FollowActorName = FString::Printf(TEXT("Following: '%s'"), *TargetActor->GetActorLabel());
-					}
-					else if (TargetActor.IsPending())
-					{
-						FollowActorName = FString::Printf(TEXT("Waiting for: %s"), *TargetActor.ToSoftObjectPath().GetSubPathString());
-					}
-					else
-					{
-						FollowActorName = TEXT("No follow Actor set");
-					}
-
-					return FText::Format(LOCTEXT("FollowSelectedActor", "{0} {1}"),
-					(
-							!ViewportSyncSubSystem->GetGlobalViewportFollowTargetOverride().IsNull() ? FText::FromString("[Override]") : FText::GetEmpty()),
-						FText::FromString(FollowActorName)
-					);
-				})
-				.Font(FEditorStyle::GetFontStyle(TEXT("MenuItem.Font")))
-						.ColorAndOpacity(FLinearColor(0.4f, 1.0f, 1.0f))
-						.ShadowOffset(FVector2D(1, 1))
-			]
-		];
+	// The next client starts at its own screen percentage, so capture that again rather than restoring this one's
+	ViewportInfo.ScreenPercentage = 0;
+
+	// Same for its show flags and draw distance
+	ViewportInfo.RenderProfileRestoreState.Reset();
+	RenderProfileViewExtension->RemoveViewport(ViewportClient->Viewport);
+
+	// The restored viewport gets a new handle, it'll register again if its actor still hasn't spawned
+	ClearPendingFollowTarget(ViewportHandle);
+
+	// Pooled viewports hang on to their track so they come back recording into it, only dropping one frees it
+	PooledViewports.RemoveAll([this, ConfigKey](const FPooledViewport& PooledViewport)
+	{
+		if (PooledViewport.ConfigKey == ConfigKey)
+		{
+			ReleaseTrackId(PooledViewport.State.TrajectoryTrackId);
+			return true;
+		}
+		return false;
+	});
+
+	if (PooledViewports.Num() >= MaxPooledViewports)
+	{
+		ReleaseTrackId(PooledViewports[0].State.TrajectoryTrackId);
+		PooledViewports.RemoveAt(0);
+	}
+
+	FPooledViewport& PooledViewport = PooledViewports.Emplace_GetRef(ConfigKey);
+	ViewportStates.Remove(ViewportHandle, &PooledViewport.State, &PooledViewport.Info);
+
+	return true;
+}
+
+bool USyncViewportSubsystem::RestoreViewportFromPool(FLevelEditorViewportClient* ViewportClient)
+{
+	const FName ConfigKey = GetViewportConfigKey(ViewportClient);
+	if (ConfigKey.IsNone())
+	{
+		return false;
+	}
+
+	const int32 PooledIndex = PooledViewports.IndexOfByPredicate([ConfigKey](const FPooledViewport& PooledViewport)
+	{
+		return PooledViewport.ConfigKey == ConfigKey;
+	});
+
+	if (PooledIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FPooledViewport& PooledViewport = PooledViewports[PooledIndex];
+
+	// The new client has none of our camera setup yet, everything else (follow cache, smoothing, view model, overlay) carries over
+	PooledViewport.State.Follow.bForceUpdate = true;
+
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Add(ViewportClient, MoveTemp(PooledViewport.State), MoveTemp(PooledViewport.Info));
+	PooledViewports.RemoveAt(PooledIndex);
+
+	if (PIEWorldContext != nullptr)
+	{
+		ApplyViewportSettings(ViewportHandle);
+	}
+
+	return true;
+}
+
+uint16 USyncViewportSubsystem::AllocateTrackId()
+{
+	if (FreeTrackIds.Num() == 0)
+	{
+		UE_LOG(LogViewportSync, Warning, TEXT("More than %d viewports are open or pooled, the new one won't be recorded or published"), FViewportSyncTrajectoryRecorder::MaxTracks);
+		return uint16(FViewportSyncTrajectoryRecorder::MaxTracks);
+	}
+	return FreeTrackIds.Pop(false);
+}
+
+void USyncViewportSubsystem::ReleaseTrackId(uint16 TrackId)
+{
+	if (TrackId < FViewportSyncTrajectoryRecorder::MaxTracks)
+	{
+		TrajectoryRecorder.SetTrackName(TrackId, NAME_None);
+		FreeTrackIds.Add(TrackId);
+	}
+}
+
+USyncViewportSubsystem::FSyncViewportState::FSyncViewportState(bool bShouldSync)
+	: ResolvedFollowActor(nullptr)
+	, SyncedWorldContext(nullptr)
+	, FollowTargetLocation(FVector::ZeroVector)
+	, FocusClass(EViewportSyncFocusClass::Background)
+	, StreamingPolicy(EViewportSyncStreamingPolicy::Full)
+	, RenderedWorldTime(0.0f)
+	, RenderedFOV(0.0f)
+	, RenderedViewLocation(FVector::ZeroVector)
+	, RenderedViewRotation(FRotator::ZeroRotator)
+	, UnchangedTime(0.0f)
+	, TrajectoryTrackId(0)
+	, bIsPIEViewport(false)
+	, bSync(bShouldSync)
+	, bHasFollowActor(false)
+	, bFollowActorResolved(false)
+	, bFollowActorPending(false)
+	, bHasFollowGroup(false)
+	, bPIEStartStaged(false)
+	, bSuspended(false)
+	, bFollowUpdated(false)
+	, bHasFollowTargetLocation(false)
+	, bMirrorPlayer(false)
+	, bHasAutoFollow(false)
+	, bRenderIdle(false)
+{}
+
+USyncViewportSubsystem::FLiveViewportInfo::FLiveViewportInfo(const TSoftObjectPtr<AActor>& ActorToFollow)
+	: FollowActor(ActorToFollow)
+	, ViewModel(MakeShared<FViewportSyncViewModel>())
+	, RefreshRate()
+	, PIEInstance(INDEX_NONE)
+	, ScreenPercentage(0)
+	, bWasPreviewingScreenPercentage(false)
+	, PreviousScreenPercentage(100)
+	, PreviousFOV(0.0f)
+{}
+
+TSharedRef<SWidget> USyncViewportSubsystem::FLiveViewportInfo::GetOverlayWidget() const
+{
+	// Create on demand
+	if(!OverlayWidget.IsValid())
+	{
+		SAssignNew(OverlayWidget, SViewportSyncOverlay, ViewModel);
 	}
 
 	return OverlayWidget.ToSharedRef();
@@ -274,6 +891,12 @@ TSharedRef<SWidget> USyncViewportSubsystem::FLiveViewportInfo::GetOverlayWidget(
 
 void USyncViewportSubsystem::OnPrePIEBegin(const bool bIsSimulating)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ViewportSync_PIEStart);
+	CSV_SCOPED_TIMING_STAT(ViewportSync, PIEStart);
+
+	PIEStartTiming.Reset();
+	PIEStartTiming.BeginTime = FPlatformTime::Seconds();
+
 	/*
 	 * Find and mark our PIE Viewport
 	 */
@@ -281,223 +904,1607 @@ void USyncViewportSubsystem::OnPrePIEBegin(const bool bIsSimulating)
 	FLevelEditorModule& LevelEditorModule = FModuleManager::GetModuleChecked<FLevelEditorModule>(LevelEditorModuleName);
 	
 	const TSharedPtr<SLevelViewport> ActiveLevelViewport = LevelEditorModule.GetFirstActiveLevelViewport();	
-	const TSharedPtr<FSceneViewport> SharedActiveViewport = ActiveLevelViewport->GetSharedActiveViewport();
+	const TSharedPtr<FSceneViewport> SharedActiveViewport = ActiveLevelViewport.IsValid() ? ActiveLevelViewport->GetSharedActiveViewport() : nullptr;
 
-	for (auto& ViewportInfo : ViewportInfos)
+	// Nothing to mark when running without a level editor (e.g. -nullrhi automation), PIE runs in its own window
+	if(SharedActiveViewport.IsValid())
 	{
-		if(ViewportInfo.Key->Viewport == SharedActiveViewport.Get())
+		for (int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
 		{
-			ViewportInfo.Value.bIsPIEViewport = true;
-			break;
+			if(ViewportStates.KeyAt(ViewportIndex)->Viewport == SharedActiveViewport.Get())
+			{
+				ViewportStates.HotAt(ViewportIndex).bIsPIEViewport = true;
+				break;
+			}
 		}
 	}
+
+	PIEStartTiming.PluginStartFrameMs += (FPlatformTime::Seconds() - PIEStartTiming.BeginTime) * 1000.0;
 }
 
 
 void USyncViewportSubsystem::OnPIEPostStarted(const bool bIsSimulating)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ViewportSync_PIEStart);
+	CSV_SCOPED_TIMING_STAT(ViewportSync, PIEStart);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Only set when PIE was started through the editor, fall back to our own start so the share still adds up
+	if(PIEStartTiming.BeginTime == 0.0)
+	{
+		PIEStartTiming.BeginTime = StartTime;
+	}
+
 	PIEWorldContext = GEditor->GetPIEWorldContext();
+
+	PIEWorldContexts.Reset();
+	for(FWorldContext& WorldContext : GEditor->GetWorldContexts())
+	{
+		if(WorldContext.WorldType == EWorldType::PIE && WorldContext.World() != nullptr)
+		{
+			PIEWorldContexts.Add(&WorldContext);
+
+			// Pending follow targets are only looked for again once something that could be them turns up
+			UWorld* World = WorldContext.World();
+			ActorSpawnedHandles.Emplace(World, World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &USyncViewportSubsystem::OnPIEActorSpawned)));
+		}
+	}
+
+	FWorldDelegates::LevelAddedToWorld.AddUObject(this, &USyncViewportSubsystem::OnLevelAddedToWorld);
+
+	// Paths are about to be fixed up for PIE so anything we were waiting on should be looked up fresh
+	PendingFollowTargets.Reset();
+	bGlobalFollowActorPending = false;
+
+	// Latched for the whole session so toggling the setting mid PIE can't leave viewports without realtime or a scheduler
+	bSchedulingViewports = GetDefault<UViewportSyncSettings>()->bScheduleSyncedViewports;
+	bFocusPriority = GetDefault<UViewportSyncSettings>()->bFocusPriority;
+	bFollowAfterWorldTick = GetDefault<UViewportSyncSettings>()->FollowUpdatePoint == EViewportSyncFollowUpdatePoint::AfterWorldTick;
+	bRenderingOnChange = GetDefault<UViewportSyncSettings>()->bRenderOnlyOnChange;
+
+	bGoverningScreenPercentage = GetDefault<UViewportSyncSettings>()->bAdaptiveScreenPercentage;
+	ScreenPercentageGovernor.Reset(GetDefault<UViewportSyncSettings>()->AdaptiveMaxScreenPercentage);
+
+	// Picks up a buffer size changed during the last session, then keeps whatever earlier sessions are still in the ring
+	InitializeTrajectoryRecorder();
+	TrajectoryRecorder.BeginSession();
+	LoadedTrajectory.Reset();
 	
 	if(PIEWorldContext != nullptr)
 	{		
-		for(auto& ViewportInfo : ViewportInfos)
+		for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
 		{
-			if (!ViewportInfo.Value.FollowActor.IsNull())
+			FLiveViewportInfo& ViewportInfo = ViewportStates.ColdAt(ViewportIndex);
+			if (!ViewportInfo.FollowActor.IsNull())
 			{
 				// We reset this so it resolves to the correct PIE instance
-				ViewportInfo.Value.FollowActor.ResetWeakPtr();
-				const_cast<FSoftObjectPath&>(ViewportInfo.Value.FollowActor.ToSoftObjectPath()).FixupForPIE(PIEWorldContext->PIEInstance);
+				ViewportInfo.FollowActor.ResetWeakPtr();
+				const_cast<FSoftObjectPath&>(ViewportInfo.FollowActor.ToSoftObjectPath()).FixupForPIE(PIEWorldContext->PIEInstance);
 			}
-		
-			ApplyViewportSettings(ViewportInfo.Key, ViewportInfo.Value);
+			ViewportStates.HotAt(ViewportIndex).ResolvedFollowActor.Reset();
+			ViewportStates.HotAt(ViewportIndex).MirroredCameraManager.Reset();
+			ViewportStates.HotAt(ViewportIndex).bFollowActorPending = false;
+			ViewportStates.HotAt(ViewportIndex).Follow.Filter.Invalidate();
+			ViewportStates.HotAt(ViewportIndex).Follow.bForceUpdate = true;
+		}
+
+		const UViewportSyncSettings* Settings = GetDefault<UViewportSyncSettings>();
+		if(Settings->bStagePIEStart)
+		{
+			StageViewportSettings(Settings->PIEStartImmediateViewports);
+		}
+		else
+		{
+			for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+			{
+				ApplyViewportSettings(ViewportStates.HandleAt(ViewportIndex));
+			}
+			PIEStartTiming.NumImmediateViewports = ViewportStates.Num();
 		}
 	}
 
+	// Follow paths have been fixed up for PIE
+	RefreshAllViewportViewModels();
+
 	GEditor->OnPostEditorTick().AddUObject(this, &USyncViewportSubsystem::OnPostEditorTick);
+
+	// Cameras move as soon as the world they watch has ticked, so they're drawn from the frame that was just simulated
+	if(bFollowAfterWorldTick)
+	{
+		WorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USyncViewportSubsystem::OnWorldPostActorTick);
+	}
+
+	const double EndTime = FPlatformTime::Seconds();
+	PIEStartTiming.PluginStartFrameMs += (EndTime - StartTime) * 1000.0;
+	PIEStartTiming.StartFrameMs = (EndTime - PIEStartTiming.BeginTime) * 1000.0;
+
+	if(NextStagedViewport >= StagedViewports.Num())
+	{
+		ReportPIEStartTiming();
+	}
 }
 
 void USyncViewportSubsystem::OnPIEEnded(const bool bIsSimulating)
 {
 	PIEWorldContext = nullptr;
+	PIEWorldContexts.Reset();
+	ActorCorrespondence.Reset();
+
+	for(const TPair<TWeakObjectPtr<UWorld>, FDelegateHandle>& ActorSpawnedHandle : ActorSpawnedHandles)
+	{
+		if(UWorld* World = ActorSpawnedHandle.Key.Get())
+		{
+			World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle.Value);
+		}
+	}
+	ActorSpawnedHandles.Reset();
 
-	for(auto& ViewportInfo : ViewportInfos)
+	FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
+
+	PendingFollowTargets.Reset();
+	bGlobalFollowActorPending = false;
+
+	// Stopped before staging got to everyone, what did get set up is still worth reporting
+	if(NextStagedViewport < StagedViewports.Num())
+	{
+		ReportPIEStartTiming();
+	}
+	StagedViewports.Reset();
+	NextStagedViewport = 0;
+
+	for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+	{
+		RevertViewportSettings(ViewportStates.HandleAt(ViewportIndex));
+
+		FSyncViewportState& ViewportState = ViewportStates.HotAt(ViewportIndex);
+		ViewportState.bIsPIEViewport = false;
+		ViewportState.bPIEStartStaged = false;
+		ViewportState.ResolvedFollowActor.Reset();
+		ViewportState.MirroredCameraManager.Reset();
+		ViewportState.bFollowActorPending = false;
+
+		if(ViewportStates.ColdAt(ViewportIndex).FollowGroup.IsValid())
+		{
+			ViewportStates.ColdAt(ViewportIndex).FollowGroup->Reset();
+		}
+
+		if(ViewportStates.ColdAt(ViewportIndex).AutoFollow.IsValid())
+		{
+			// Whatever the rule picked was a PIE actor, it picks again next session
+			ViewportStates.ColdAt(ViewportIndex).AutoFollow->Reset();
+			ViewportStates.ColdAt(ViewportIndex).FollowActor = nullptr;
+			ViewportState.bHasFollowActor = false;
+		}
+	}
+
+	// Pooled viewports were closed mid session, nothing needs reverting but they shouldn't hang on to PIE actors
+	for(FPooledViewport& PooledViewport : PooledViewports)
 	{
-		RevertViewportSettings(ViewportInfo.Key, ViewportInfo.Value);
+		PooledViewport.State.bIsPIEViewport = false;
+		PooledViewport.State.bPIEStartStaged = false;
+		PooledViewport.State.bSuspended = false;
+		PooledViewport.State.bRenderIdle = false;
+		PooledViewport.State.ResolvedFollowActor.Reset();
+		PooledViewport.State.MirroredCameraManager.Reset();
+		PooledViewport.Info.PreviousFOV = 0.0f;
+		PooledViewport.State.SyncedWorldContext = nullptr;
+		PooledViewport.State.bFollowActorPending = false;
+
+		if(PooledViewport.Info.FollowGroup.IsValid())
+		{
+			PooledViewport.Info.FollowGroup->Reset();
+		}
 
-		ViewportInfo.Value.bIsPIEViewport = false;
+		if(PooledViewport.Info.AutoFollow.IsValid())
+		{
+			PooledViewport.Info.AutoFollow->Reset();
+			PooledViewport.Info.FollowActor = nullptr;
+			PooledViewport.State.bHasFollowActor = false;
+		}
 	}
 
+	Scheduler.Reset();
+	bSchedulingViewports = false;
+	bFocusPriority = false;
+	bGoverningScreenPercentage = false;
+
+	FWorldDelegates::OnWorldPostActorTick.Remove(WorldPostActorTickHandle);
+	WorldPostActorTickHandle.Reset();
+	bFollowAfterWorldTick = false;
+
 	// Clear our override so next PIE session they can choose if they want to override it again or not
 	GlobalFollowActorOverride = nullptr;
+	GlobalFollowLocationOverride.Reset();
+	bGlobalFollowActorResolved = false;
+
+	RefreshAllViewportViewModels();
+
+	GEditor->OnPostEditorTick().RemoveAll(this);
+}
+
+void USyncViewportSubsystem::ApplyViewportSettings(FViewportSyncHandle ViewportHandle)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ViewportSync_ApplyViewportSettings);
+	CSV_SCOPED_TIMING_STAT(ViewportSync, ApplyViewportSettings);
+
+	checkf(PIEWorldContext, TEXT("Tried to enable viewport settings but we're currently not in a PIE session"));
+
+	FLevelEditorViewportClient* const Client = ViewportStates.GetKey(ViewportHandle);
+	FSyncViewportState& ViewportState = *ViewportStates.GetHot(ViewportHandle);
+	const FLiveViewportInfo& ViewportInfo = *ViewportStates.GetCold(ViewportHandle);
+
+	ViewportState.bPIEStartStaged = false;
+
+	// Don't apply our PIE viewport settings
+	if(ViewportState.bIsPIEViewport)
+	{
+		return;
+	}
+
+	if(GetDefault<UViewportSyncSettings>()->bShowOverlay)
+	{
+		TSharedPtr<SLevelViewport> Viewport = StaticCastSharedPtr<SLevelViewport>(Client->GetEditorViewportWidget());
+		if(Viewport.IsValid())
+		{
+			Viewport->AddOverlayWidget(ViewportInfo.GetOverlayWidget());
+		}
+		else
+		{
+			UE_LOG(LogViewportSync, Warning, TEXT("Failed to add viewport overlay"));
+		}
+	}
+	
+	if (ViewportState.bSync)
+	{
+		ApplyViewportSync(Client);
+	}
+	
+	if(ViewportInfo.FollowActor.IsValid())
+	{
+		ApplyViewportFollowActor(Client, ViewportInfo.FollowActor.Get());
+	}
+}
+
+void USyncViewportSubsystem::RevertViewportSettings(FViewportSyncHandle ViewportHandle)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ViewportSync_RevertViewportSettings);
+	CSV_SCOPED_TIMING_STAT(ViewportSync, RevertViewportSettings);
+
+	FLevelEditorViewportClient* const Client = ViewportStates.GetKey(ViewportHandle);
+	const FSyncViewportState& ViewportState = *ViewportStates.GetHot(ViewportHandle);
+	const FLiveViewportInfo& ViewportInfo = *ViewportStates.GetCold(ViewportHandle);
+
+	// Staged PIE start never got to it, nothing to revert
+	if(ViewportState.bPIEStartStaged)
+	{
+		return;
+	}
+
+	TSharedPtr<SLevelViewport> Viewport = StaticCastSharedPtr<SLevelViewport>(Client->GetEditorViewportWidget());
+	if(Viewport.IsValid())
+	{
+		Viewport->RemoveOverlayWidget(ViewportInfo.GetOverlayWidget());
+	}
+	
+	if (ViewportState.bSync)
+	{
+		RevertViewportSync(Client);
+	}
+
+	if(!ViewportInfo.FollowActor.IsNull() || ViewportInfo.FollowGroup.IsValid() || ViewportInfo.AutoFollow.IsValid() || !GlobalFollowActorOverride.IsNull() || GlobalFollowLocationOverride.IsSet())
+	{
+		RevertViewportFollowActor(Client);
+	}
+}
+
+void USyncViewportSubsystem::StageViewportSettings(int32 NumImmediateViewports)
+{
+	StagedViewports.Reset(ViewportStates.Num());
+	NextStagedViewport = 0;
+
+	// Neighbors are whatever is on screen closest to the PIE viewport
+	FVector2D PIEViewportCenter(0.0f, 0.0f);
+	bool bHasPIEViewport = false;
+
+	TArray<TPair<float, FViewportSyncHandle>, TInlineAllocator<16>> SortedViewports;
+	TArray<FVector2D, TInlineAllocator<16>> ViewportCenters;
+
+	for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+	{
+		const TSharedPtr<SEditorViewport> Viewport = ViewportStates.KeyAt(ViewportIndex)->GetEditorViewportWidget();
+		const bool bHasWidget = Viewport.IsValid();
+		const FVector2D Center = bHasWidget ? Viewport->GetTickSpaceGeometry().GetAbsolutePositionAtCoordinates(FVector2D(0.5f, 0.5f)) : FVector2D(FLT_MAX, FLT_MAX);
+
+		if(ViewportStates.HotAt(ViewportIndex).bIsPIEViewport && bHasWidget)
+		{
+			PIEViewportCenter = Center;
+			bHasPIEViewport = true;
+		}
+		ViewportCenters.Add(Center);
+	}
+
+	for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+	{
+		// Without a PIE viewport (PIE in a new window) keep the table order
+		const float Distance = bHasPIEViewport ? FVector2D::DistSquared(ViewportCenters[ViewportIndex], PIEViewportCenter) : float(ViewportIndex);
+		SortedViewports.Emplace(Distance, ViewportStates.HandleAt(ViewportIndex));
+	}
+
+	SortedViewports.StableSort([](const TPair<float, FViewportSyncHandle>& A, const TPair<float, FViewportSyncHandle>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	for(const TPair<float, FViewportSyncHandle>& SortedViewport : SortedViewports)
+	{
+		FSyncViewportState& ViewportState = *ViewportStates.GetHot(SortedViewport.Value);
+
+		// The PIE viewport has nothing to set up
+		if(ViewportState.bIsPIEViewport)
+		{
+			continue;
+		}
+
+		if(NumImmediateViewports > 0)
+		{
+			ApplyViewportSettings(SortedViewport.Value);
+			++PIEStartTiming.NumImmediateViewports;
+			--NumImmediateViewports;
+		}
+		else
+		{
+			ViewportState.bPIEStartStaged = true;
+			StagedViewports.Add(SortedViewport.Value);
+		}
+	}
+
+	PIEStartTiming.NumStagedViewports = StagedViewports.Num();
+}
+
+void USyncViewportSubsystem::ApplyStagedViewportSettings(float FrameBudgetMs)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ViewportSync_StagedPIEStart);
+	CSV_SCOPED_TIMING_STAT(ViewportSync, StagedPIEStart);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = StartTime + FrameBudgetMs / 1000.0;
+
+	do
+	{
+		// Viewports closed or already set up since being staged are skipped, ApplyViewportSettings clears the flag
+		const FViewportSyncHandle ViewportHandle = StagedViewports[NextStagedViewport++];
+		const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+		if(ViewportState != nullptr && ViewportState->bPIEStartStaged)
+		{
+			ApplyViewportSettings(ViewportHandle);
+		}
+	}
+	while(NextStagedViewport < StagedViewports.Num() && FPlatformTime::Seconds() < EndTime);
+
+	PIEStartTiming.StagedMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	++PIEStartTiming.StagedFrames;
+
+	if(NextStagedViewport >= StagedViewports.Num())
+	{
+		StagedViewports.Reset();
+		NextStagedViewport = 0;
+
+		ReportPIEStartTiming();
+	}
+}
+
+void USyncViewportSubsystem::FlushStagedViewport(FViewportSyncHandle ViewportHandle)
+{
+	const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+	if(ViewportState != nullptr && ViewportState->bPIEStartStaged)
+	{
+		ApplyViewportSettings(ViewportHandle);
+	}
+}
+
+void USyncViewportSubsystem::ReportPIEStartTiming()
+{
+	const FPIEStartTiming& Timing = PIEStartTiming;
+	const double PluginShare = Timing.StartFrameMs > 0.0 ? Timing.PluginStartFrameMs / Timing.StartFrameMs * 100.0 : 0.0;
+
+	UE_LOG(LogViewportSync, Log, TEXT("PIE start took %.2fms, %.2fms (%.1f%%) of it setting up %d viewport(s). %d viewport(s) staged over %d frame(s) taking %.2fms"),
+		Timing.StartFrameMs, Timing.PluginStartFrameMs, PluginShare, Timing.NumImmediateViewports, Timing.NumStagedViewports, Timing.StagedFrames, Timing.StagedMs);
+
+	SET_FLOAT_STAT(STAT_ViewportSync_LastPIEStartMs, Timing.StartFrameMs);
+	SET_FLOAT_STAT(STAT_ViewportSync_LastPIEStartPluginMs, Timing.PluginStartFrameMs);
+	SET_FLOAT_STAT(STAT_ViewportSync_LastPIEStartStagedMs, Timing.StagedMs);
+	SET_DWORD_STAT(STAT_ViewportSync_LastPIEStartStagedFrames, Timing.StagedFrames);
+
+	CSV_EVENT(ViewportSync, TEXT("PIE start %.2fms, plugin %.2fms, staged %.2fms over %d frames"), Timing.StartFrameMs, Timing.PluginStartFrameMs, Timing.StagedMs, Timing.StagedFrames);
+}
+
+//////////////////////////////////////////////
+// Live Update
+//////////////////////////////////////////////
+
+void USyncViewportSubsystem::SetViewportSyncState(FLevelEditorViewportClient* const ViewportClient, bool bState)
+{
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Find(ViewportClient);
+	FlushStagedViewport(ViewportHandle);
+
+	if(FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle))
+	{
+		ViewportState->bSync = bState;
+		ViewportState->Follow.bForceUpdate = true;
+
+		RefreshViewportViewModel(ViewportHandle);
+		if(PIEWorldContext != nullptr)
+		{
+			UE_LOG(LogViewportSync, Log, TEXT("Setting Viewport Live Updating State to %s"), bState ? TEXT("Enabled") : TEXT("Disabled"));
+			
+			if(bState)
+			{
+				// We enabled it so also enable tracking
+				ApplyViewportSettings(ViewportHandle);
+			}
+			else
+			{
+				RevertViewportSync(ViewportClient);
+
+				// Force it to redraw so we return back to normal and our viewport doesn't have game elements
+				ViewportClient->Viewport->Invalidate();
+			}
+		}
+	}
+}
+
+FWorldContext* USyncViewportSubsystem::FindPIEWorldContext(int32 PIEInstance) const
+{
+	if(PIEInstance != INDEX_NONE)
+	{
+		for(FWorldContext* WorldContext : PIEWorldContexts)
+		{
+			if(WorldContext->PIEInstance == PIEInstance)
+			{
+				return WorldContext;
+			}
+		}
+	}
+	return PIEWorldContext;
+}
+
+const AActor* USyncViewportSubsystem::GetActorInViewportWorld(const AActor* Actor, const FSyncViewportState& ViewportState)
+{
+	if(Actor == nullptr || ViewportState.SyncedWorldContext == nullptr || Actor->GetWorld() == ViewportState.SyncedWorldContext->World())
+	{
+		return Actor;
+	}
+	return ActorCorrespondence.Find(Actor, *ViewportState.SyncedWorldContext);
+}
+
+void USyncViewportSubsystem::ApplyViewportSync(FLevelEditorViewportClient* const ViewportClient)
+{
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Find(ViewportClient);
+	FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+	FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle);
+
+	FWorldContext* WorldContext = FindPIEWorldContext(ViewportInfo != nullptr ? ViewportInfo->PIEInstance : INDEX_NONE);
+	ViewportClient->SetReferenceToWorldContext(*WorldContext);
+
+	if(ViewportState != nullptr)
+	{
+		ViewportState->SyncedWorldContext = WorldContext;
+		ViewportState->bSuspended = false;
+		ViewportState->bRenderIdle = false;
+		ViewportState->UnchangedTime = 0.0f;
+
+		StartViewportRedraws(ViewportHandle, true);
+	}
+	else
+	{
+		SetSyncedRealtime(ViewportClient, true, true);
+	}
+
+	if(bGoverningScreenPercentage && ViewportInfo != nullptr && !ViewportState->bIsPIEViewport)
+	{
+		ApplyViewportScreenPercentage(ViewportClient, *ViewportInfo);
+	}
+
+	if(ViewportInfo != nullptr && !ViewportState->bIsPIEViewport)
+	{
+		ApplyViewportRenderProfile(ViewportClient, *ViewportInfo);
+	}
+}
+
+void USyncViewportSubsystem::RevertViewportSync(FLevelEditorViewportClient* const ViewportClient)
+{
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Find(ViewportClient);
+	Scheduler.RemoveViewport(ViewportHandle);
+
+	if(FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle))
+	{
+		RevertViewportScreenPercentage(ViewportClient, *ViewportInfo);
+		RevertViewportRenderProfile(ViewportClient, *ViewportInfo);
+		RevertViewportMirror(ViewportClient, *ViewportInfo);
+	}
+
+	if(FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle))
+	{
+		ViewportState->SyncedWorldContext = nullptr;
+
+		// Idling is the same, the realtime value comes back below
+		ViewportState->bRenderIdle = false;
+
+		// Suspending only swapped the realtime value, our override (or stored realtime) is still there to restore
+		if(ViewportState->bSuspended)
+		{
+			ViewportState->bSuspended = false;
+			RefreshViewportViewModel(ViewportHandle);
+		}
+	}
+
+	ViewportClient->SetReferenceToWorldContext(GEditor->GetEditorWorldContext());
+
+#if ENGINE_MAJOR_VERSION <= 4 && ENGINE_MINOR_VERSION <= 24
+	ViewportClient->RestoreRealtime(true);
+#else
+	ViewportClient->RemoveRealtimeOverride();
+#endif
+}
+
+bool USyncViewportSubsystem::IsViewportScheduled(const FLiveViewportInfo& ViewportInfo) const
+{
+	return bFocusPriority || (bSchedulingViewports && !ViewportInfo.RefreshRate.IsEveryFrame());
+}
+
+void USyncViewportSubsystem::ScheduleViewport(FViewportSyncHandle ViewportHandle, const FSyncViewportState& ViewportState, const FLiveViewportInfo& ViewportInfo)
+{
+	// Refresh rates picked from the menu only count when scheduling is turned on, focus priority alone runs everything every frame until capped
+	Scheduler.AddViewport(ViewportHandle, bSchedulingViewports ? ViewportInfo.RefreshRate : FViewportSyncRefreshRate());
+
+	if(bFocusPriority)
+	{
+		Scheduler.SetMaxRate(ViewportHandle, GetFocusClassUpdateRate(*GetDefault<UViewportSyncSettings>(), ViewportState.FocusClass));
+	}
+}
+
+void USyncViewportSubsystem::SetSyncedRealtime(FLevelEditorViewportClient* const ViewportClient, bool bRealtime, bool bFirstSync)
+{
+#if ENGINE_MAJOR_VERSION <= 4 && ENGINE_MINOR_VERSION <= 24
+	// Only storing the first time keeps the realtime value from before we synced for RevertViewportSync
+	ViewportClient->SetRealtime(bRealtime, bFirstSync);
+#else
+	if(!bFirstSync)
+	{
+		ViewportClient->RemoveRealtimeOverride();
+	}
+	ViewportClient->SetRealtimeOverride(bRealtime, LOCTEXT("ViewportSync", "Viewport Sync"));
+#endif
+}
+
+void USyncViewportSubsystem::StartViewportRedraws(FViewportSyncHandle ViewportHandle, bool bFirstSync)
+{
+	const FSyncViewportState& ViewportState = *ViewportStates.GetHot(ViewportHandle);
+	const FLiveViewportInfo& ViewportInfo = *ViewportStates.GetCold(ViewportHandle);
+
+	// When scheduling we turn realtime *off* so the only redraws this viewport gets are the ones the scheduler hands out
+	const bool bScheduled = IsViewportScheduled(ViewportInfo);
+	SetSyncedRealtime(ViewportStates.GetKey(ViewportHandle), !bScheduled, bFirstSync);
+
+	if(bScheduled)
+	{
+		ScheduleViewport(ViewportHandle, ViewportState, ViewportInfo);
+	}
+}
+
+void USyncViewportSubsystem::StopViewportRedraws(FViewportSyncHandle ViewportHandle)
+{
+	Scheduler.RemoveViewport(ViewportHandle);
+	SetSyncedRealtime(ViewportStates.GetKey(ViewportHandle), false);
+}
+
+void USyncViewportSubsystem::SuspendViewport(FViewportSyncHandle ViewportHandle)
+{
+	ViewportStates.GetHot(ViewportHandle)->bSuspended = true;
+
+	StopViewportRedraws(ViewportHandle);
+
+	UE_LOG(LogViewportSync, Verbose, TEXT("Suspended hidden synced viewport"));
+
+	RefreshViewportViewModel(ViewportHandle);
+}
+
+void USyncViewportSubsystem::ResumeViewport(FViewportSyncHandle ViewportHandle)
+{
+	FSyncViewportState& ViewportState = *ViewportStates.GetHot(ViewportHandle);
+
+	ViewportState.bSuspended = false;
+
+	// It may have been idle when it was hidden, it needs to draw whatever changed while it was
+	ViewportState.bRenderIdle = false;
+	ViewportState.UnchangedTime = 0.0f;
+
+	// Wherever the target went while we were hidden, go straight there rather than smoothing across
+	ViewportState.Follow.Filter.Invalidate();
+	ViewportState.Follow.bForceUpdate = true;
+
+	StartViewportRedraws(ViewportHandle);
+
+	UE_LOG(LogViewportSync, Verbose, TEXT("Resumed synced viewport"));
+
+	RefreshViewportViewModel(ViewportHandle);
+}
+
+void USyncViewportSubsystem::UpdateViewportRenderOnChange(int32 ViewportIndex, float DeltaTime, float SettleTime)
+{
+	FSyncViewportState& ViewportState = ViewportStates.HotAt(ViewportIndex);
+	const FLevelEditorViewportClient* ViewportClient = ViewportStates.KeyAt(ViewportIndex);
+
+	// Doesn't advance while the world is paused or stopped at a breakpoint, and doesn't need to be compared with a tolerance
+	const float WorldTime = ViewportState.SyncedWorldContext->World() != nullptr ? ViewportState.SyncedWorldContext->World()->GetTimeSeconds() : 0.0f;
+	const FVector ViewLocation = ViewportClient->GetViewLocation();
+	const FRotator ViewRotation = ViewportClient->GetViewRotation();
+
+	const bool bChanged = WorldTime != ViewportState.RenderedWorldTime
+		|| ViewportClient->ViewFOV != ViewportState.RenderedFOV
+		|| !ViewLocation.Equals(ViewportState.RenderedViewLocation)
+		|| !ViewRotation.Equals(ViewportState.RenderedViewRotation);
+
+	if(bChanged)
+	{
+		ViewportState.RenderedWorldTime = WorldTime;
+		ViewportState.RenderedFOV = ViewportClient->ViewFOV;
+		ViewportState.RenderedViewLocation = ViewLocation;
+		ViewportState.RenderedViewRotation = ViewRotation;
+		ViewportState.UnchangedTime = 0.0f;
+
+		if(ViewportState.bRenderIdle)
+		{
+			WakeViewport(ViewportStates.HandleAt(ViewportIndex));
+		}
+	}
+	else if(!ViewportState.bRenderIdle)
+	{
+		ViewportState.UnchangedTime += DeltaTime;
+
+		if(ViewportState.UnchangedTime >= SettleTime)
+		{
+			IdleViewport(ViewportStates.HandleAt(ViewportIndex));
+		}
+	}
+}
+
+void USyncViewportSubsystem::IdleViewport(FViewportSyncHandle ViewportHandle)
+{
+	ViewportStates.GetHot(ViewportHandle)->bRenderIdle = true;
+
+	StopViewportRedraws(ViewportHandle);
+
+	UE_LOG(LogViewportSync, Verbose, TEXT("Idled synced viewport, nothing in it is changing"));
+}
+
+void USyncViewportSubsystem::WakeViewport(FViewportSyncHandle ViewportHandle)
+{
+	ViewportStates.GetHot(ViewportHandle)->bRenderIdle = false;
+
+	StartViewportRedraws(ViewportHandle);
+
+	UE_LOG(LogViewportSync, Verbose, TEXT("Woke idle synced viewport"));
+}
+
+void USyncViewportSubsystem::ApplyViewportRenderProfile(FLevelEditorViewportClient* const ViewportClient, FLiveViewportInfo& ViewportInfo)
+{
+	// Already applied, e.g. sync was switched on again while it was on
+	if(ViewportInfo.RenderProfileRestoreState.bApplied)
+	{
+		return;
+	}
+
+	const UViewportSyncSettings* Settings = GetDefault<UViewportSyncSettings>();
+	const FName ProfileName = ViewportInfo.RenderProfile.IsNone() ? Settings->DefaultRenderProfile : ViewportInfo.RenderProfile;
+
+	const FViewportSyncRenderProfile* Profile = Settings->FindRenderProfile(ProfileName);
+	if(Profile == nullptr)
+	{
+		if(!ProfileName.IsNone())
+		{
+			UE_LOG(LogViewportSync, Warning, TEXT("No render profile called %s, leaving the viewport as it is"), *ProfileName.ToString());
+		}
+		return;
+	}
+
+	// Full rendering, nothing to apply (or restore later)
+	if(!Profile->HasOverrides())
+	{
+		return;
+	}
+
+	Profile->Apply(*ViewportClient, ViewportInfo.RenderProfileRestoreState);
+	RenderProfileViewExtension->SetLODDistanceScale(ViewportClient->Viewport, Profile->LODDistanceScale);
+}
+
+void USyncViewportSubsystem::RevertViewportRenderProfile(FLevelEditorViewportClient* const ViewportClient, FLiveViewportInfo& ViewportInfo)
+{
+	ViewportInfo.RenderProfileRestoreState.Restore(*ViewportClient);
+	RenderProfileViewExtension->RemoveViewport(ViewportClient->Viewport);
+}
+
+void USyncViewportSubsystem::ApplyViewportScreenPercentage(FLevelEditorViewportClient* const ViewportClient, FLiveViewportInfo& ViewportInfo)
+{
+	// Only remember what the user had the first time we take over
+	if(ViewportInfo.ScreenPercentage == 0)
+	{
+		ViewportInfo.bWasPreviewingScreenPercentage = ViewportClient->IsPreviewingScreenPercentage();
+		ViewportInfo.PreviousScreenPercentage = ViewportClient->GetPreviewScreenPercentage();
+	}
+
+	ViewportInfo.ScreenPercentage = ScreenPercentageGovernor.GetScreenPercentage();
+
+	ViewportClient->SetPreviewingScreenPercentage(true);
+	ViewportClient->SetPreviewScreenPercentage(ViewportInfo.ScreenPercentage);
+
+	RefreshViewportViewModel(ViewportStates.Find(ViewportClient));
+}
+
+void USyncViewportSubsystem::RevertViewportScreenPercentage(FLevelEditorViewportClient* const ViewportClient, FLiveViewportInfo& ViewportInfo)
+{
+	if(ViewportInfo.ScreenPercentage == 0)
+	{
+		return;
+	}
+
+	ViewportClient->SetPreviewScreenPercentage(ViewportInfo.PreviousScreenPercentage);
+	ViewportClient->SetPreviewingScreenPercentage(ViewportInfo.bWasPreviewingScreenPercentage);
+
+	ViewportInfo.ScreenPercentage = 0;
+
+	RefreshViewportViewModel(ViewportStates.Find(ViewportClient));
+}
+
+void USyncViewportSubsystem::SetViewportRefreshRate(FLevelEditorViewportClient* ViewportClient, FViewportSyncRefreshRate RefreshRate)
+{
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Find(ViewportClient);
+	FlushStagedViewport(ViewportHandle);
+
+	if(FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle))
+	{
+		const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+		const bool bWasScheduled = IsViewportScheduled(*ViewportInfo);
+		ViewportInfo->RefreshRate = RefreshRate;
+
+		UE_LOG(LogViewportSync, Log, TEXT("Setting Viewport Refresh Rate to %s"), *RefreshRate.GetDisplayText().ToString());
+
+		if(PIEWorldContext != nullptr && bSchedulingViewports && ViewportState->bSync && !ViewportState->bIsPIEViewport)
+		{
+			// Switching between scheduled and realtime needs the realtime override re-applied
+			if(bWasScheduled != IsViewportScheduled(*ViewportInfo))
+			{
+				RevertViewportSync(ViewportClient);
+				ApplyViewportSync(ViewportClient);
+			}
+			else
+			{
+				Scheduler.SetRefreshRate(ViewportHandle, RefreshRate);
+			}
+		}
+	}
+}
+
+void USyncViewportSubsystem::SetViewportPIEInstance(FLevelEditorViewportClient* ViewportClient, int32 PIEInstance)
+{
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Find(ViewportClient);
+	FlushStagedViewport(ViewportHandle);
+
+	if(FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle))
+	{
+		ViewportInfo->PIEInstance = PIEInstance;
+
+		UE_LOG(LogViewportSync, Log, TEXT("Setting Viewport PIE Instance to %d"), PIEInstance);
+
+		FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+
+		// The follow actor has to be looked up again in the new world
+		ViewportState->ResolvedFollowActor.Reset();
+		ViewportState->Follow.Filter.Invalidate();
+		ClearPendingFollowTarget(ViewportHandle);
+		ViewportState->Follow.bForceUpdate = true;
+
+		if(ViewportInfo->FollowGroup.IsValid())
+		{
+			ViewportInfo->FollowGroup->MarkNeedsRebuild();
+		}
+
+		if(ViewportInfo->AutoFollow.IsValid())
+		{
+			ViewportInfo->AutoFollow->MarkNeedsRebuild();
+		}
+
+		if(PIEWorldContext != nullptr && ViewportState->bSync && !ViewportState->bIsPIEViewport)
+		{
+			RevertViewportSync(ViewportClient);
+			ApplyViewportSync(ViewportClient);
+
+			// Freshly opened layouts (and the benchmark's clients) don't have an FViewport yet
+			if(ViewportClient->Viewport != nullptr)
+			{
+				ViewportClient->Viewport->Invalidate();
+			}
+		}
+
+		RefreshViewportViewModel(ViewportHandle);
+	}
+}
+
+void USyncViewportSubsystem::SetViewportFollowFilter(FLevelEditorViewportClient* ViewportClient, EViewportSyncFollowFilter Filter)
+{
+	if(FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportStates.Find(ViewportClient)))
+	{
+		ViewportState->Follow.FilterSettings.Filter = Filter;
+
+		UE_LOG(LogViewportSync, Log, TEXT("Setting Viewport Follow Filter to %s"), *FViewportSyncFollowFilterSettings::GetDisplayText(Filter).ToString());
+	}
+}
+
+void USyncViewportSubsystem::SetViewportStreamingPolicy(FLevelEditorViewportClient* ViewportClient, EViewportSyncStreamingPolicy Policy)
+{
+	if(FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportStates.Find(ViewportClient)))
+	{
+		ViewportState->StreamingPolicy = Policy;
+
+		UE_LOG(LogViewportSync, Log, TEXT("Setting Viewport Streaming Policy to %s"), *FViewportSyncStreaming::GetDisplayText(Policy).ToString());
+	}
+}
+
+void USyncViewportSubsystem::SetViewportRenderProfile(FLevelEditorViewportClient* ViewportClient, FName ProfileName)
+{
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Find(ViewportClient);
+	FlushStagedViewport(ViewportHandle);
+
+	if(FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle))
+	{
+		ViewportInfo->RenderProfile = ProfileName;
+
+		UE_LOG(LogViewportSync, Log, TEXT("Setting Viewport Render Profile to %s"), *ProfileName.ToString());
+
+		// Put the old profile's changes back before the new one remembers what it replaces
+		if(ViewportStates.GetHot(ViewportHandle)->SyncedWorldContext != nullptr)
+		{
+			RevertViewportRenderProfile(ViewportClient, *ViewportInfo);
+			ApplyViewportRenderProfile(ViewportClient, *ViewportInfo);
+		}
+	}
+}
+
+bool USyncViewportSubsystem::IsViewportRenderProfile(FLevelEditorViewportClient* ViewportClient, FName ProfileName) const
+{
+	if(const FLiveViewportInfo* ViewportInfo = GetDataForViewport(ViewportClient))
+	{
+		return (ViewportInfo->RenderProfile.IsNone() ? GetDefault<UViewportSyncSettings>()->DefaultRenderProfile : ViewportInfo->RenderProfile) == ProfileName;
+	}
+	return false;
+}
+
+void USyncViewportSubsystem::RefreshViewportViewModel(FViewportSyncHandle ViewportHandle)
+{
+	const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+	const FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle);
+
+	if(ViewportState != nullptr && ViewportInfo != nullptr)
+	{
+		// Only worth calling out when the viewport isn't showing the instance everything else is
+		FText WorldText;
+		if(ViewportState->SyncedWorldContext != nullptr && ViewportState->SyncedWorldContext != PIEWorldContext)
+		{
+			WorldText = GetWorldContextDisplayText(*ViewportState->SyncedWorldContext);
+		}
+
+		const FText FollowGroupText = ViewportInfo->FollowGroup.IsValid() ? ViewportInfo->FollowGroup->GetDesc().GetDisplayText() : FText::GetEmpty();
+
+		const FText MirrorPlayerText = ViewportInfo->Mirror.IsEnabled() ? FViewportSyncPlayerMirror::GetDisplayText(ViewportInfo->Mirror.PlayerIndex) : FText::GetEmpty();
+
+		const FText AutoFollowText = ViewportInfo->AutoFollow.IsValid() ? ViewportInfo->AutoFollow->GetRule().GetDisplayText() : FText::GetEmpty();
+
+		ViewportInfo->ViewModel->Update(ViewportInfo->FollowActor, GlobalFollowActorOverride, GlobalFollowLocationOverride.IsSet(), FollowGroupText, MirrorPlayerText, AutoFollowText, ViewportState->bSync, ViewportState->bSuspended, ViewportInfo->ScreenPercentage, WorldText);
+	}
+}
+
+void USyncViewportSubsystem::RefreshAllViewportViewModels()
+{
+	for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+	{
+		RefreshViewportViewModel(ViewportStates.HandleAt(ViewportIndex));
+	}
+}
+
+void USyncViewportSubsystem::OnSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Pick up new tuning values but keep each viewport's own choice of filter
+	const FViewportSyncFollowFilterSettings DefaultFilterSettings = GetDefault<UViewportSyncSettings>()->MakeFollowFilterSettings();
+	for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+	{
+		FViewportSyncFollowFilterSettings& FilterSettings = ViewportStates.HotAt(ViewportIndex).Follow.FilterSettings;
+		const EViewportSyncFollowFilter Filter = FilterSettings.Filter;
+		FilterSettings = DefaultFilterSettings;
+		FilterSettings.Filter = Filter;
+	}
+
+	// Resizing the recorder allocates, so mid session it waits for the next one
+	if(PIEWorldContext == nullptr)
+	{
+		InitializeTrajectoryRecorder();
+	}
+
+	UpdatePoseStream();
+
+	// The profiles may have been edited, give every synced viewport its profile again
+	for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+	{
+		const FSyncViewportState& ViewportState = ViewportStates.HotAt(ViewportIndex);
+		if(ViewportState.SyncedWorldContext != nullptr && !ViewportState.bIsPIEViewport)
+		{
+			FLevelEditorViewportClient* const ViewportClient = ViewportStates.KeyAt(ViewportIndex);
+			RevertViewportRenderProfile(ViewportClient, ViewportStates.ColdAt(ViewportIndex));
+			ApplyViewportRenderProfile(ViewportClient, ViewportStates.ColdAt(ViewportIndex));
+		}
+	}
+
+	RefreshAllViewportViewModels();
+}
+
+//////////////////////////////////////////////
+// Trajectory Recording
+//////////////////////////////////////////////
+
+static FString GetDefaultTrajectoryFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ViewportSync") / TEXT("Trajectories.vstraj");
+}
+
+void USyncViewportSubsystem::InitializeTrajectoryRecorder()
+{
+	const UViewportSyncSettings* Settings = GetDefault<UViewportSyncSettings>();
+	TrajectoryRecorder.Initialize(Settings->bRecordTrajectories ? Settings->TrajectoryBufferSizeMB * 1024 * 1024 : 0);
+}
+
+void USyncViewportSubsystem::UpdatePoseStream()
+{
+	const UViewportSyncSettings* Settings = GetDefault<UViewportSyncSettings>();
+	const FString DesiredName = Settings->bPublishPoseStream ? Settings->PoseStreamName : FString();
+
+	if(DesiredName != PoseStreamName || PoseStream.IsOpen() == DesiredName.IsEmpty())
+	{
+		PoseStream.Close();
+		PoseStreamName = DesiredName;
+
+		if(!PoseStreamName.IsEmpty())
+		{
+			PoseStream.Open(PoseStreamName);
+		}
+	}
+}
+
+bool USyncViewportSubsystem::SaveTrajectories(const FString& FilePath) const
+{
+	return TrajectoryRecorder.SaveToFile(FilePath);
+}
+
+bool USyncViewportSubsystem::LoadTrajectories(const FString& FilePath)
+{
+	if(FilePath.IsEmpty())
+	{
+		TrajectoryRecorder.Decode(LoadedTrajectory);
+	}
+	else if(!FViewportSyncTrajectoryRecorder::LoadFromFile(FilePath, LoadedTrajectory))
+	{
+		return false;
+	}
+
+	UE_LOG(LogViewportSync, Log, TEXT("Loaded %d viewport trajectories covering %.1f seconds"), LoadedTrajectory.Tracks.Num(), LoadedTrajectory.GetDuration());
+	return true;
+}
+
+void USyncViewportSubsystem::ScrubTrajectories(double Time)
+{
+	if(PIEWorldContext != nullptr)
+	{
+		UE_LOG(LogViewportSync, Warning, TEXT("Stop the PIE session before scrubbing through viewport trajectories"));
+		return;
+	}
+
+	if(LoadedTrajectory.Tracks.Num() == 0 && !LoadTrajectories(FString()))
+	{
+		return;
+	}
+
+	UWorld* EditorWorld = GEditor->GetEditorWorldContext().World();
+	if(EditorWorld != nullptr)
+	{
+		FlushPersistentDebugLines(EditorWorld);
+	}
+
+	// Enough segments to see the shape of a long session without flooding the line batcher
+	static const int32 MaxPathSegments = 2000;
+
+	for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+	{
+		FLevelEditorViewportClient* ViewportClient = ViewportStates.KeyAt(ViewportIndex);
+
+		// Match by layout first so a saved recording finds its viewport again, then by track for ones without a layout key
+		const FViewportSyncTrajectoryTrack* Track = LoadedTrajectory.FindTrack(GetViewportConfigKey(ViewportClient));
+		if(Track == nullptr)
+		{
+			const uint16 TrackId = ViewportStates.HotAt(ViewportIndex).TrajectoryTrackId;
+			Track = LoadedTrajectory.Tracks.FindByPredicate([TrackId](const FViewportSyncTrajectoryTrack& InTrack) { return InTrack.TrackId == TrackId; });
+		}
+
+		FViewportSyncTrajectorySample Sample;
+		if(Track == nullptr || !LoadedTrajectory.Evaluate(*Track, Time, Sample))
+		{
+			continue;
+		}
+
+		ViewportClient->SetViewLocation(Sample.CameraLocation);
+		ViewportClient->SetViewRotation(Sample.CameraRotation);
+		ViewportClient->Invalidate();
+
+		if(EditorWorld != nullptr)
+		{
+			const TArray<FViewportSyncTrajectorySample>& Samples = Track->Samples;
+			const int32 Stride = FMath::Max(1, Samples.Num() / MaxPathSegments);
+			for(int32 SampleIndex = Stride; SampleIndex < Samples.Num(); SampleIndex += Stride)
+			{
+				const FViewportSyncTrajectorySample& From = Samples[SampleIndex - Stride];
+				const FViewportSyncTrajectorySample& To = Samples[SampleIndex];
+
+				DrawDebugLine(EditorWorld, From.CameraLocation, To.CameraLocation, FColor::Cyan, true);
+				if(From.bHasTarget && To.bHasTarget)
+				{
+					DrawDebugLine(EditorWorld, From.TargetLocation, To.TargetLocation, FColor::Orange, true);
+				}
+			}
+		}
+	}
+}
+
+void USyncViewportSubsystem::RegisterConsoleCommands()
+{
+	IConsoleManager& ConsoleManager = IConsoleManager::Get();
+
+	ConsoleCommands.Add(ConsoleManager.RegisterConsoleCommand(
+		TEXT("ViewportSync.Trajectory.Save"),
+		TEXT("Writes the recorded viewport camera trajectories to a file.\n")
+		TEXT("Usage: ViewportSync.Trajectory.Save [Path], defaults to Saved/ViewportSync/Trajectories.vstraj"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args)
+		{
+			SaveTrajectories(Args.Num() > 0 ? Args[0] : GetDefaultTrajectoryFilePath());
+		}),
+		ECVF_Default
+	));
+
+	ConsoleCommands.Add(ConsoleManager.RegisterConsoleCommand(
+		TEXT("ViewportSync.Trajectory.Load"),
+		TEXT("Loads viewport camera trajectories to scrub through, from a file or with no path the current recording.\n")
+		TEXT("Usage: ViewportSync.Trajectory.Load [Path]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args)
+		{
+			LoadTrajectories(Args.Num() > 0 ? Args[0] : FString());
+		}),
+		ECVF_Default
+	));
+
+	ConsoleCommands.Add(ConsoleManager.RegisterConsoleCommand(
+		TEXT("ViewportSync.Trajectory.Scrub"),
+		TEXT("Moves each viewport's camera to where it was at a point in the loaded trajectories and draws the recorded paths.\n")
+		TEXT("Usage: ViewportSync.Trajectory.Scrub <Seconds>"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args)
+		{
+			ScrubTrajectories(Args.Num() > 0 ? FCString::Atod(*Args[0]) : 0.0);
+		}),
+		ECVF_Default
+	));
+}
+
+void USyncViewportSubsystem::UnRegisterConsoleCommands()
+{
+	for(IConsoleObject* ConsoleCommand : ConsoleCommands)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(ConsoleCommand);
+	}
+	ConsoleCommands.Reset();
+}
+
+//////////////////////////////////////////////
+// Follow
+//////////////////////////////////////////////
+
+void USyncViewportSubsystem::SetGlobalViewportFollowTargetOverride(AActor* FollowTarget)
+{
+	GlobalFollowActorOverride = FollowTarget;
+	GlobalFollowLocationOverride.Reset();
+
+	ClearPendingFollowTarget(FViewportSyncHandle());
+
+	RefreshAllViewportViewModels();
+}
+
+void USyncViewportSubsystem::SetGlobalViewportFollowLocationOverride(const TOptional<FVector>& Location)
+{
+	// Moving the point around doesn't change what the overlays say, only starting or stopping following one does
+	const bool bReplacesActorOverride = Location.IsSet() && !GlobalFollowActorOverride.IsNull();
+	const bool bChangesViewModels = bReplacesActorOverride || Location.IsSet() != GlobalFollowLocationOverride.IsSet();
+
+	GlobalFollowLocationOverride = Location;
+
+	if(bReplacesActorOverride)
+	{
+		GlobalFollowActorOverride = nullptr;
+		ClearPendingFollowTarget(FViewportSyncHandle());
+	}
+
+	if(bChangesViewModels)
+	{
+		RefreshAllViewportViewModels();
+	}
+}
+
+void USyncViewportSubsystem::MarkEvent(const FVector& Location, FName Label)
+{
+	const float Duration = GetDefault<UViewportSyncSettings>()->EventMarkerDuration;
+
+	// Synced viewports can be watching any instance, and they all share the same coordinates
+	for(const FWorldContext* WorldContext : PIEWorldContexts)
+	{
+		if(UWorld* World = WorldContext->World())
+		{
+			DrawDebugPoint(World, Location, 16.0f, FColor::Yellow, false, Duration);
+			if(!Label.IsNone())
+			{
+				DrawDebugString(World, Location, Label.ToString(), nullptr, FColor::Yellow, Duration);
+			}
+		}
+	}
+
+	CSV_EVENT(ViewportSync, TEXT("%s"), Label.IsNone() ? TEXT("Event") : *Label.ToString());
+
+	UE_LOG(LogViewportSync, Verbose, TEXT("Event '%s' marked at %s"), *Label.ToString(), *Location.ToString());
+}
+
+void USyncViewportSubsystem::ExecuteQueuedCommands()
+{
+	// No more than the queue holds, so threads that never stop sending can't keep us here
+	const uint32 MaxCommands = CommandQueue->GetCapacity();
+
+	FViewportSyncCommand Command;
+	FViewportSyncCommand FollowCommand;
+	bool bHasFollowCommand = false;
+	uint32 NumCommands = 0;
+
+	while(NumCommands < MaxCommands && CommandQueue->Dequeue(Command))
+	{
+		++NumCommands;
+
+		if(Command.Type == FViewportSyncCommand::EType::MarkEvent)
+		{
+			MarkEvent(Command.Location, Command.Label);
+		}
+		else
+		{
+			// Only the last one would still be in effect by the time anything follows, the rest would just refresh every overlay
+			FollowCommand = MoveTemp(Command);
+			bHasFollowCommand = true;
+		}
+	}
+
+	if(bHasFollowCommand)
+	{
+		switch(FollowCommand.Type)
+		{
+		case FViewportSyncCommand::EType::FollowActor:
+			// Gone before we got to it, there's nothing left to follow
+			if(AActor* Actor = Cast<AActor>(FollowCommand.Actor.Get()))
+			{
+				if(GlobalFollowActorOverride.Get() != Actor || GlobalFollowLocationOverride.IsSet())
+				{
+					SetGlobalViewportFollowTargetOverride(Actor);
+				}
+			}
+			break;
+		case FViewportSyncCommand::EType::FollowLocation:
+			SetGlobalViewportFollowLocationOverride(FollowCommand.Location);
+			break;
+		default:
+			if(!GlobalFollowActorOverride.IsNull() || GlobalFollowLocationOverride.IsSet())
+			{
+				SetGlobalViewportFollowTargetOverride(nullptr);
+			}
+			break;
+		}
+	}
+
+	if(const uint32 NumDropped = CommandQueue->TakeNumDropped())
+	{
+		UE_LOG(LogViewportSync, Warning, TEXT("Dropped %u commands, more than %u were sent in a single frame"), NumDropped, MaxCommands);
+	}
+
+	SET_DWORD_STAT(STAT_ViewportSync_QueuedCommands, NumCommands);
+	CSV_CUSTOM_STAT(ViewportSync, QueuedCommands, static_cast<int32>(NumCommands), ECsvCustomStatOp::Set);
+}
+
+void USyncViewportSubsystem::ClearPendingFollowTarget(FViewportSyncHandle ViewportHandle)
+{
+	PendingFollowTargets.Remove(ViewportHandle);
+	RearmPendingFollowTarget(ViewportHandle);
+}
+
+void USyncViewportSubsystem::RearmPendingFollowTarget(FViewportSyncHandle ViewportHandle)
+{
+	if(!ViewportHandle.IsSet())
+	{
+		bGlobalFollowActorPending = false;
+	}
+	else if(FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle))
+	{
+		ViewportState->bFollowActorPending = false;
+	}
+}
+
+void USyncViewportSubsystem::OnPIEActorSpawned(AActor* Actor)
+{
+	if(Actor == nullptr)
+	{
+		return;
+	}
+
+	// Class and tag groups, and auto follow candidates, grow as matching actors spawn
+	for(int32 ViewportIndex = 0; ViewportIndex < ViewportStates.Num(); ++ViewportIndex)
+	{
+		if(ViewportStates.HotAt(ViewportIndex).bHasFollowGroup)
+		{
+			ViewportStates.ColdAt(ViewportIndex).FollowGroup->OnActorSpawned(Actor);
+		}
+		else if(ViewportStates.HotAt(ViewportIndex).bHasAutoFollow)
+		{
+			ViewportStates.ColdAt(ViewportIndex).AutoFollow->OnActorSpawned(Actor);
+		}
+	}
+
+	if(PendingFollowTargets.IsEmpty())
+	{
+		return;
+	}
+
+	/*
+	 * Names match for anything spawned in the default instance or streamed in with a level. Viewports watching another instance
+	 * wait on that instance's copy, which (if it was spawned by replication) has its own name, so any spawn in their world counts
+	 */
+	const UWorld* SpawnWorld = Actor->GetWorld();
+	const bool bSpawnedInDefaultWorld = PIEWorldContext != nullptr && SpawnWorld == PIEWorldContext->World();
+
+	PendingFollowTargets.TakeMatching(Actor->GetFName(),
+		[this, SpawnWorld, bSpawnedInDefaultWorld](FViewportSyncHandle ViewportHandle)
+		{
+			const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+			return !bSpawnedInDefaultWorld && ViewportState != nullptr && ViewportState->SyncedWorldContext != nullptr && ViewportState->SyncedWorldContext->World() == SpawnWorld;
+		},
+		[this](FViewportSyncHandle ViewportHandle)
+		{
+			RearmPendingFollowTarget(ViewportHandle);
+		});
+}
+
+void USyncViewportSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if(World == nullptr || World->WorldType != EWorldType::PIE)
+	{
+		return;
+	}
+
+	// A level's worth of actors showed up without any spawn notifications, let everyone have another look
+	PendingFollowTargets.TakeAll([this](FViewportSyncHandle ViewportHandle)
+	{
+		RearmPendingFollowTarget(ViewportHandle);
+	});
+}
+
+void USyncViewportSubsystem::SetViewportFollowActor(FLevelEditorViewportClient* const ViewportClient, const AActor* Actor)
+{
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Find(ViewportClient);
+	FlushStagedViewport(ViewportHandle);
+
+	// Following and mirroring both drive the camera, picking an actor (or clearing it) ends mirroring, and the user's pick wins over auto follow's
+	StopViewportMirror(ViewportHandle);
+	StopViewportAutoFollow(ViewportHandle);
+
+	FollowActorInViewport(ViewportHandle, Actor);
+}
+
+void USyncViewportSubsystem::FollowActorInViewport(FViewportSyncHandle ViewportHandle, const AActor* Actor)
+{
+	FLevelEditorViewportClient* ViewportClient = ViewportStates.GetKey(ViewportHandle);
+
+	if (FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle))
+	{
+		ViewportInfo->FollowActor = Actor;
+
+		FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+		ViewportState->ResolvedFollowActor = const_cast<AActor*>(GetActorInViewportWorld(Actor, *ViewportState));
+		ViewportState->bHasFollowActor = Actor != nullptr;
+		ViewportInfo->FollowGroup.Reset();
+		ViewportState->bHasFollowGroup = false;
+		ViewportState->Follow.Filter.Invalidate();
+		ClearPendingFollowTarget(ViewportHandle);
+		ViewportState->Follow.bForceUpdate = true;
+
+		RefreshViewportViewModel(ViewportHandle);
+
+		UE_LOG(LogViewportSync, Log, TEXT("Set the follow actor to %s"), Actor != nullptr ? *Actor->GetActorLabel() : TEXT("None"));
+
+		if (ViewportInfo->FollowActor.IsValid())
+		{	
+			// We check that the world is valid here because I don't want to take away user control while PIE is not active
+			if (PIEWorldContext)
+			{
+				ApplyViewportFollowActor(ViewportClient, ViewportInfo->FollowActor.Get());
+			}
+		}
+		else
+		{
+			RevertViewportFollowActor(ViewportClient);
+		}
+	}
+}
+
+void USyncViewportSubsystem::SetViewportFollowGroup(FLevelEditorViewportClient* ViewportClient, const FViewportSyncFollowGroupDesc& GroupDesc)
+{
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Find(ViewportClient);
+	FlushStagedViewport(ViewportHandle);
+	StopViewportMirror(ViewportHandle);
+	StopViewportAutoFollow(ViewportHandle);
+
+	if (FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle))
+	{
+		ViewportInfo->FollowActor = nullptr;
+		ViewportInfo->FollowGroup = MakeShared<FViewportSyncFollowGroup>(GroupDesc);
+
+		FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+		ViewportState->ResolvedFollowActor.Reset();
+		ViewportState->bHasFollowActor = false;
+		ViewportState->bHasFollowGroup = true;
+		ViewportState->bFollowActorResolved = false;
+		ViewportState->Follow.Filter.Invalidate();
+		ClearPendingFollowTarget(ViewportHandle);
+		ViewportState->Follow.bForceUpdate = true;
+
+		RefreshViewportViewModel(ViewportHandle);
+
+		UE_LOG(LogViewportSync, Log, TEXT("Set the follow group to %s"), *GroupDesc.GetDisplayText().ToString());
+
+		// The camera is taken over by the tick once the group has been found in the viewport's world
+	}
+}
+
+void USyncViewportSubsystem::SetViewportMirror(FLevelEditorViewportClient* ViewportClient, const FViewportSyncPlayerMirror& Mirror)
+{
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Find(ViewportClient);
+	FlushStagedViewport(ViewportHandle);
+	StopViewportMirror(ViewportHandle);
+
+	FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+	FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle);
+	if(ViewportState == nullptr || ViewportInfo == nullptr || !Mirror.IsEnabled())
+	{
+		return;
+	}
+
+	StopViewportAutoFollow(ViewportHandle);
+
+	// Mirroring replaces following, and the camera can't be locked to an orbit while we set it directly
+	ViewportInfo->FollowActor = nullptr;
+	ViewportInfo->FollowGroup.Reset();
+	ViewportState->ResolvedFollowActor.Reset();
+	ViewportState->bHasFollowActor = false;
+	ViewportState->bHasFollowGroup = false;
+	ViewportState->bFollowActorResolved = false;
+	ClearPendingFollowTarget(ViewportHandle);
+	RevertViewportFollowActor(ViewportClient);
+
+	ViewportInfo->Mirror = Mirror;
+	ViewportState->bMirrorPlayer = true;
+	ViewportState->Follow.bForceUpdate = true;
+
+	RefreshViewportViewModel(ViewportHandle);
+
+	UE_LOG(LogViewportSync, Log, TEXT("Set the viewport to mirror %s"), *FViewportSyncPlayerMirror::GetDisplayText(Mirror.PlayerIndex).ToString());
+}
+
+void USyncViewportSubsystem::MirrorViewportPlayer(int32 ViewportIndex)
+{
+	FSyncViewportState& ViewportState = ViewportStates.HotAt(ViewportIndex);
+	FLiveViewportInfo& ViewportInfo = ViewportStates.ColdAt(ViewportIndex);
+
+	// Controllers come and go (respawns, seamless travel) so look again whenever the cached camera manager has gone
+	APlayerCameraManager* CameraManager = ViewportState.MirroredCameraManager.Get();
+	if(CameraManager == nullptr)
+	{
+		CameraManager = FViewportSyncPlayerMirror::FindCameraManager(ViewportState.SyncedWorldContext != nullptr ? ViewportState.SyncedWorldContext->World() : nullptr, ViewportInfo.Mirror.PlayerIndex);
+		ViewportState.MirroredCameraManager = CameraManager;
+	}
+
+	if(CameraManager == nullptr)
+	{
+		++FollowStats.NumPending;
+		return;
+	}
+
+	FLevelEditorViewportClient* ViewportClient = ViewportStates.KeyAt(ViewportIndex);
+
+	// First frame of this mirror, remember the FOV to give back and make sure nothing else is steering the camera
+	if(ViewportInfo.PreviousFOV <= 0.0f)
+	{
+		ViewportInfo.PreviousFOV = ViewportClient->ViewFOV;
+		RevertViewportFollowActor(ViewportClient);
+	}
+
+	if(ViewportInfo.Mirror.Apply(*ViewportClient, *CameraManager))
+	{
+		++FollowStats.NumResolved;
+	}
+	else
+	{
+		++FollowStats.NumPending;
+	}
+}
+
+void USyncViewportSubsystem::StopViewportMirror(FViewportSyncHandle ViewportHandle)
+{
+	FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+	FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle);
+	if(ViewportState == nullptr || ViewportInfo == nullptr || !ViewportState->bMirrorPlayer)
+	{
+		return;
+	}
+
+	RevertViewportMirror(ViewportStates.GetKey(ViewportHandle), *ViewportInfo);
+
+	ViewportInfo->Mirror = FViewportSyncPlayerMirror();
+	ViewportState->MirroredCameraManager.Reset();
+	ViewportState->bMirrorPlayer = false;
+
+	RefreshViewportViewModel(ViewportHandle);
+}
+
+void USyncViewportSubsystem::RevertViewportMirror(FLevelEditorViewportClient* const ViewportClient, FLiveViewportInfo& ViewportInfo)
+{
+	if(ViewportInfo.PreviousFOV > 0.0f)
+	{
+		ViewportClient->ViewFOV = ViewportInfo.PreviousFOV;
+		ViewportInfo.PreviousFOV = 0.0f;
+		ViewportClient->Invalidate();
+	}
+}
+
+void USyncViewportSubsystem::SetViewportAutoFollow(FLevelEditorViewportClient* ViewportClient, const FViewportSyncAutoFollowRule& Rule)
+{
+	const FViewportSyncHandle ViewportHandle = ViewportStates.Find(ViewportClient);
+	FlushStagedViewport(ViewportHandle);
+
+	FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+	FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle);
+	if(ViewportState == nullptr || ViewportInfo == nullptr)
+	{
+		return;
+	}
+
+	if(Rule.ActorClass == nullptr)
+	{
+		UE_LOG(LogViewportSync, Warning, TEXT("Auto follow needs a class to pick actors from, ignoring it"));
+		return;
+	}
+
+	StopViewportMirror(ViewportHandle);
+
+	// Start from nothing (this drops any follow group too), the tick picks the first target once PIE is running
+	FollowActorInViewport(ViewportHandle, nullptr);
+
+	ViewportInfo->AutoFollow = MakeShared<FViewportSyncAutoFollow>(Rule, GetDefault<UViewportSyncSettings>()->AutoFollowCellSize);
+	ViewportState->bHasAutoFollow = true;
+
+	RefreshViewportViewModel(ViewportHandle);
 
-	GEditor->OnPostEditorTick().RemoveAll(this);
+	UE_LOG(LogViewportSync, Log, TEXT("Set the viewport to auto follow %s"), *Rule.GetDisplayText().ToString());
 }
 
-void USyncViewportSubsystem::ApplyViewportSettings(FLevelEditorViewportClient* const Client, const FLiveViewportInfo& ViewportInfo)
+void USyncViewportSubsystem::UpdateViewportAutoFollow(int32 ViewportIndex)
 {
-	checkf(PIEWorldContext, TEXT("Tried to enable viewport settings but we're currently not in a PIE session"));
+	SCOPE_CYCLE_COUNTER(STAT_ViewportSync_AutoFollow);
+	CSV_SCOPED_TIMING_STAT(ViewportSync, AutoFollow);
 
-	// Don't apply our PIE viewport settings
-	if(ViewportInfo.bIsPIEViewport)
+	FSyncViewportState& ViewportState = ViewportStates.HotAt(ViewportIndex);
+	FViewportSyncAutoFollow& AutoFollow = *ViewportStates.ColdAt(ViewportIndex).AutoFollow;
+
+	UWorld* World = ViewportState.SyncedWorldContext != nullptr ? ViewportState.SyncedWorldContext->World() : nullptr;
+	if(World == nullptr)
 	{
 		return;
 	}
 
-	if(GetDefault<UViewportSyncSettings>()->bShowOverlay)
-	{
-		TSharedPtr<SLevelViewport> Viewport = StaticCastSharedPtr<SLevelViewport>(Client->GetEditorViewportWidget());
-		if(Viewport.IsValid())
-		{
-			Viewport->AddOverlayWidget(ViewportInfo.GetOverlayWidget());
-		}
-		else
-		{
-			UE_LOG(LogViewportSync, Warning, TEXT("Failed to add viewport overlay"));
-		}
-	}
-	
-	if (ViewportInfo.bSync)
-	{
-		ApplyViewportSync(Client);
-	}
-	
-	if(ViewportInfo.FollowActor.IsValid())
+	if(AutoFollow.NeedsRebuild() || AutoFollow.GetWorld() != World)
 	{
-		ApplyViewportFollowActor(Client, ViewportInfo.FollowActor.Get());
+		AutoFollow.Rebuild(World);
 	}
-}
 
-void USyncViewportSubsystem::RevertViewportSettings(FLevelEditorViewportClient* const Client, const FLiveViewportInfo& ViewportInfo)
-{
-	TSharedPtr<SLevelViewport> Viewport = StaticCastSharedPtr<SLevelViewport>(Client->GetEditorViewportWidget());
-	if(Viewport.IsValid())
-	{
-		Viewport->RemoveOverlayWidget(ViewportInfo.GetOverlayWidget());
-	}
-	
-	if (ViewportInfo.bSync)
+	// Distances are measured from the player, or from the viewport's own camera when there isn't one
+	FVector Origin = ViewportStates.KeyAt(ViewportIndex)->GetViewLocation();
+	if(const APlayerCameraManager* CameraManager = FViewportSyncPlayerMirror::FindCameraManager(World, AutoFollow.GetRule().PlayerIndex))
 	{
-		RevertViewportSync(Client);
+		Origin = CameraManager->GetCameraLocation();
 	}
 
-	if(!ViewportInfo.FollowActor.IsNull() || !GlobalFollowActorOverride.IsNull())
+	const AActor* Target = AutoFollow.Update(Origin, World->GetTimeSeconds(), GetDefault<UViewportSyncSettings>()->AutoFollowRefreshBudget);
+
+	// A new pick goes through the same path as the user picking it, a target that went away without a replacement clears it
+	if(Target != ViewportState.ResolvedFollowActor.Get() || (Target == nullptr && ViewportState.bHasFollowActor))
 	{
-		RevertViewportFollowActor(Client);
+		FollowActorInViewport(ViewportStates.HandleAt(ViewportIndex), Target);
 	}
 }
 
-//////////////////////////////////////////////
-// Live Update
-//////////////////////////////////////////////
-
-void USyncViewportSubsystem::SetViewportSyncState(FLevelEditorViewportClient* const ViewportClient, bool bState)
+void USyncViewportSubsystem::StopViewportAutoFollow(FViewportSyncHandle ViewportHandle)
 {
-	if(FLiveViewportInfo* ViewportInfo = ViewportInfos.Find(ViewportClient))
+	FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportHandle);
+	FLiveViewportInfo* ViewportInfo = ViewportStates.GetCold(ViewportHandle);
+	if(ViewportState == nullptr || ViewportInfo == nullptr || !ViewportState->bHasAutoFollow)
 	{
-		ViewportInfo->bSync = bState;
-		if(PIEWorldContext != nullptr)
-		{
-			UE_LOG(LogViewportSync, Log, TEXT("Setting Viewport Live Updating State to %s"), bState ? TEXT("Enabled") : TEXT("Disabled"));
-			
-			if(bState)
-			{
-				// We enabled it so also enable tracking
-				ApplyViewportSettings(ViewportClient, *ViewportInfo);
-			}
-			else
-			{
-				RevertViewportSync(ViewportClient);
-
-				// Force it to redraw so we return back to normal and our viewport doesn't have game elements
-				ViewportClient->Viewport->Invalidate();
-			}
-		}
+		return;
 	}
-}
 
-void USyncViewportSubsystem::ApplyViewportSync(FLevelEditorViewportClient* const ViewportClient)
-{
-	ViewportClient->SetReferenceToWorldContext(*PIEWorldContext);
-#if ENGINE_MAJOR_VERSION <= 4 && ENGINE_MINOR_VERSION <= 24
-	ViewportClient->SetRealtime(true, true);
-#else
-	ViewportClient->SetRealtimeOverride(true, LOCTEXT("ViewportSync", "Viewport Sync"));
-#endif
+	ViewportInfo->AutoFollow.Reset();
+	ViewportState->bHasAutoFollow = false;
+
+	RefreshViewportViewModel(ViewportHandle);
 }
 
-void USyncViewportSubsystem::RevertViewportSync(FLevelEditorViewportClient* const ViewportClient)
+bool USyncViewportSubsystem::FollowViewportGroup(int32 ViewportIndex, float FollowDeltaTime, float FollowActorMovementThresholdSquared, FViewportSyncFollowGroupFrame& OutFrame)
 {
-	ViewportClient->SetReferenceToWorldContext(GEditor->GetEditorWorldContext());
+	SCOPE_CYCLE_COUNTER(STAT_ViewportSync_FrameFollowGroup);
+	CSV_SCOPED_TIMING_STAT(ViewportSync, FrameFollowGroup);
 
-#if ENGINE_MAJOR_VERSION <= 4 && ENGINE_MINOR_VERSION <= 24
-	ViewportClient->RestoreRealtime(true);
-#else
-	ViewportClient->RemoveRealtimeOverride();
-#endif
-}
+	FLevelEditorViewportClient* ViewportClient = ViewportStates.KeyAt(ViewportIndex);
+	FSyncViewportState& ViewportState = ViewportStates.HotAt(ViewportIndex);
+	FViewportSyncFollowGroup& FollowGroup = *ViewportStates.ColdAt(ViewportIndex).FollowGroup;
 
-//////////////////////////////////////////////
-// Follow
-//////////////////////////////////////////////
+	UWorld* World = ViewportState.SyncedWorldContext != nullptr ? ViewportState.SyncedWorldContext->World() : nullptr;
+	if(FollowGroup.NeedsRebuild() || FollowGroup.GetWorld() != World)
+	{
+		FollowGroup.Rebuild(World, [this, &ViewportState](AActor* Actor)
+		{
+			return const_cast<AActor*>(GetActorInViewportWorld(Actor, ViewportState));
+		});
+	}
 
-void USyncViewportSubsystem::SetGlobalViewportFollowTargetOverride(AActor* FollowTarget)
-{
-	GlobalFollowActorOverride = FollowTarget;
-}
+	const bool bFramed = FollowGroup.ComputeFrame(OutFrame);
 
-void USyncViewportSubsystem::SetViewportFollowActor(FLevelEditorViewportClient* const ViewportClient, const AActor* Actor)
-{
-	if (FLiveViewportInfo* ViewportInfo = ViewportInfos.Find(ViewportClient))
+	if(ViewportState.bFollowActorResolved != bFramed)
 	{
-		ViewportInfo->FollowActor = Actor;
-
-		UE_LOG(LogViewportSync, Log, TEXT("Set the follow actor to %s"), Actor != nullptr ? *Actor->GetActorLabel() : TEXT("None"));
+		ViewportState.bFollowActorResolved = bFramed;
+		RefreshViewportViewModel(ViewportStates.HandleAt(ViewportIndex));
+	}
 
-		if (ViewportInfo->FollowActor.IsValid())
-		{	
-			// We check that the world is valid here because I don't want to take away user control while PIE is not active
-			if (PIEWorldContext)
-			{
-				ApplyViewportFollowActor(ViewportClient, ViewportInfo->FollowActor.Get());
-			}
-		}
-		else
-		{
-			RevertViewportFollowActor(ViewportClient);
-		}
+	if(!bFramed)
+	{
+		return false;
 	}
+
+	FViewportSyncLevelEditorFollowView FollowView(*ViewportClient);
+	FViewportSyncFollowCore::FrameLocation(ViewportState.Follow, FollowView, OutFrame.Center, OutFrame.Radius, GetDefault<UViewportSyncSettings>()->FollowGroupFramePadding, FollowDeltaTime, FollowActorMovementThresholdSquared);
+
+	return true;
 }
 
 void USyncViewportSubsystem::ApplyViewportFollowActor(FLevelEditorViewportClient* const ViewportClient, const AActor* Actor)
 {
-	// This will be modified during the camera lock and we want to restore it
-	const FRotator ViewportViewPreLock	= ViewportClient->GetViewRotation();
-	const FVector PreViewportLockLoc	= ViewportClient->GetViewLocation();
-	
-	ViewportClient->bUsingOrbitCamera = true;
-
-	// This is done so we can set the DefaultOrbit<Type> values because otherwise when we try and lock the viewport client it assert will invalid transforms
-	ViewportClient->SetCameraSetup(
-		FVector::ZeroVector,
-		FRotator::ZeroRotator,
-		FVector::ZeroVector,
-		FVector::ZeroVector,
-		FVector::ZeroVector,
-		FRotator::ZeroRotator
-	);
-	
-	if(!ViewportClient->IsCameraLocked())
-	{
-		// This is *actually* a toggle so only apply when we're not locked
-		ViewportClient->SetCameraLock();
-	}
-
-	// Restore our values Pre-lock
-	ViewportClient->SetViewRotation(ViewportViewPreLock);
-	ViewportClient->SetViewLocation(PreViewportLockLoc);
+	ApplyViewportFollowLocation(ViewportClient, Actor->GetActorLocation());
+}
 
-	// Recalculate our view now so our viewport correctly updates
-	ViewportClient->SetLookAtLocation(Actor->GetActorLocation(), true);
+void USyncViewportSubsystem::ApplyViewportFollowLocation(FLevelEditorViewportClient* const ViewportClient, const FVector& Location)
+{
+	FViewportSyncLevelEditorFollowView(*ViewportClient).BeginFollow(Location);
 }
 
 void USyncViewportSubsystem::RevertViewportFollowActor(FLevelEditorViewportClient* const ViewportClient)
@@ -521,12 +2528,24 @@ FLevelEditorViewportClient* USyncViewportSubsystem::GetActiveViewportClient()
 	return static_cast<FLevelEditorViewportClient*>(&LevelEditor->GetActiveViewportInterface()->GetAssetViewportClient());
 }
 
+FLevelEditorViewportClient* USyncViewportSubsystem::GetCachedActiveViewportClient()
+{
+	// The level editor picks its active viewport from the current one, so that changing is what makes the lookup worth doing again
+	if(!bActiveViewportClientCached || CachedForCurrentViewportClient != GCurrentLevelEditingViewportClient)
+	{
+		CachedActiveViewportClient = GetActiveViewportClient();
+		CachedForCurrentViewportClient = GCurrentLevelEditingViewportClient;
+		bActiveViewportClientCached = true;
+	}
+	return CachedActiveViewportClient;
+}
+
 void USyncViewportSubsystem::RegisterCommands(TSharedRef<FUICommandList> CommandList)
 {
 	CommandList->MapAction(FViewportSyncEditorCommands::Get().ToggleViewportSync,
 		FExecuteAction::CreateLambda([this]
 		{
-			if(FLevelEditorViewportClient* ViewportClient = GetActiveViewportClient())
+			if(FLevelEditorViewportClient* ViewportClient = GetCachedActiveViewportClient())
 			{
 				SetViewportSyncState(ViewportClient, !IsViewportSyncing(ViewportClient));
 			}		
@@ -534,7 +2553,8 @@ void USyncViewportSubsystem::RegisterCommands(TSharedRef<FUICommandList> Command
 		FCanExecuteAction::CreateLambda([]{ return true; }),
 		FGetActionCheckState::CreateLambda([this]()
 		{
-			return IsViewportSyncing(GetActiveViewportClient()) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+			// Polled every frame while the menu/toolbar is up. Same viewport as the execute action so the check box shows what a click toggles
+			return IsViewportSyncing(GetCachedActiveViewportClient()) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
 		})
 	);
 
@@ -546,7 +2566,17 @@ void USyncViewportSubsystem::RegisterCommands(TSharedRef<FUICommandList> Command
 			
 			FLevelEditorViewportClient* ViewportClient = GetActiveViewportClient();
 			
-			if(SelectedActors.Num() > 0 && ViewportClient != nullptr)
+			if(ViewportClient == nullptr)
+			{
+				return;
+			}
+
+			// With more than one actor selected keep all of them in frame
+			if(SelectedActors.Num() > 1)
+			{
+				SetViewportFollowGroup(ViewportClient, FViewportSyncFollowGroupDesc::FromActors(SelectedActors));
+			}
+			else if(SelectedActors.Num() > 0)
 			{
 				SetViewportFollowActor(ViewportClient, SelectedActors[0]);
 			}	
@@ -598,11 +2628,258 @@ void USyncViewportSubsystem::BuildMenuListForViewport(FMenuBuilder& MenuBuilder,
 			EUserInterfaceActionType::Button
 		);
 
+		FUIAction MirrorPlayerSubMenu;
+		MirrorPlayerSubMenu.CanExecuteAction.BindUObject(this, &USyncViewportSubsystem::IsViewportSyncing, ViewportClient);
+
+		MenuBuilder.AddSubMenu(
+			LOCTEXT("MirrorPlayer", "Mirror Player"),
+			LOCTEXT("MirrorPlayerTooltip", "Show exactly what a PIE player sees instead of following an actor"),
+			FNewMenuDelegate::CreateUObject(this, &USyncViewportSubsystem::CreateMirrorPlayerMenuForViewport, ViewportClient),
+			MirrorPlayerSubMenu,
+			NAME_None,
+			EUserInterfaceActionType::Button
+		);
+
 		BuildCurrentFollowActorWidgetForViewport(MenuBuilder, ViewportClient);
+
+		FUIAction PIEInstanceSubMenu;
+		PIEInstanceSubMenu.CanExecuteAction.BindUObject(this, &USyncViewportSubsystem::IsViewportSyncing, ViewportClient);
+
+		MenuBuilder.AddSubMenu(
+			LOCTEXT("PIEInstance", "PIE Instance"),
+			LOCTEXT("PIEInstanceTooltip", "Which PIE instance (server or client) this Viewport shows"),
+			FNewMenuDelegate::CreateUObject(this, &USyncViewportSubsystem::CreatePIEInstanceMenuForViewport, ViewportClient),
+			PIEInstanceSubMenu,
+			NAME_None,
+			EUserInterfaceActionType::Button
+		);
+
+		FUIAction FollowFilterSubMenu;
+		FollowFilterSubMenu.CanExecuteAction.BindUObject(this, &USyncViewportSubsystem::IsViewportSyncing, ViewportClient);
+
+		MenuBuilder.AddSubMenu(
+			LOCTEXT("FollowSmoothing", "Follow Smoothing"),
+			LOCTEXT("FollowSmoothingTooltip", "How this Viewport smooths out the movement of the actor it follows"),
+			FNewMenuDelegate::CreateUObject(this, &USyncViewportSubsystem::CreateFollowFilterMenuForViewport, ViewportClient),
+			FollowFilterSubMenu,
+			NAME_None,
+			EUserInterfaceActionType::Button
+		);
+
+		FUIAction StreamingSubMenu;
+		StreamingSubMenu.CanExecuteAction.BindUObject(this, &USyncViewportSubsystem::IsViewportSyncing, ViewportClient);
+
+		MenuBuilder.AddSubMenu(
+			LOCTEXT("Streaming", "Streaming"),
+			LOCTEXT("StreamingTooltip", "How much the PIE world streams in around this Viewport's camera"),
+			FNewMenuDelegate::CreateUObject(this, &USyncViewportSubsystem::CreateStreamingPolicyMenuForViewport, ViewportClient),
+			StreamingSubMenu,
+			NAME_None,
+			EUserInterfaceActionType::Button
+		);
+
+		FUIAction RenderProfileSubMenu;
+		RenderProfileSubMenu.CanExecuteAction.BindUObject(this, &USyncViewportSubsystem::IsViewportSyncing, ViewportClient);
+
+		MenuBuilder.AddSubMenu(
+			LOCTEXT("RenderProfile", "Render Profile"),
+			LOCTEXT("RenderProfileTooltip", "Which show flag, LOD and draw distance overrides this Viewport uses while synced"),
+			FNewMenuDelegate::CreateUObject(this, &USyncViewportSubsystem::CreateRenderProfileMenuForViewport, ViewportClient),
+			RenderProfileSubMenu,
+			NAME_None,
+			EUserInterfaceActionType::Button
+		);
+
+		// Only meaningful when the scheduler is driving redraws
+		if(GetDefault<UViewportSyncSettings>()->bScheduleSyncedViewports)
+		{
+			FUIAction RefreshRateSubMenu;
+			RefreshRateSubMenu.CanExecuteAction.BindUObject(this, &USyncViewportSubsystem::IsViewportSyncing, ViewportClient);
+
+			MenuBuilder.AddSubMenu(
+				LOCTEXT("RefreshRate", "Refresh Rate"),
+				LOCTEXT("RefreshRateTooltip", "How often this synced Viewport is redrawn during PIE"),
+				FNewMenuDelegate::CreateUObject(this, &USyncViewportSubsystem::CreateRefreshRateMenuForViewport, ViewportClient),
+				RefreshRateSubMenu,
+				NAME_None,
+				EUserInterfaceActionType::Button
+			);
+		}
 	}
 	MenuBuilder.EndSection();
 }
 
+void USyncViewportSubsystem::CreateRefreshRateMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient)
+{
+	const FViewportSyncRefreshRate RefreshRates[] =
+	{
+		FViewportSyncRefreshRate(),
+		FViewportSyncRefreshRate::Hz(60.0f),
+		FViewportSyncRefreshRate::Hz(30.0f),
+		FViewportSyncRefreshRate::Hz(15.0f),
+		FViewportSyncRefreshRate::EveryNthFrame(2),
+		FViewportSyncRefreshRate::EveryNthFrame(4),
+	};
+
+	for(const FViewportSyncRefreshRate& RefreshRate : RefreshRates)
+	{
+		MenuBuilder.AddMenuEntry(
+			RefreshRate.GetDisplayText(),
+			FText::GetEmpty(),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateUObject(this, &USyncViewportSubsystem::SetViewportRefreshRate, ViewportClient, RefreshRate),
+				FCanExecuteAction(),
+				FIsActionChecked::CreateUObject(this, &USyncViewportSubsystem::IsViewportRefreshRate, ViewportClient, RefreshRate)
+			),
+			NAME_None,
+			EUserInterfaceActionType::RadioButton
+		);
+	}
+}
+
+void USyncViewportSubsystem::CreatePIEInstanceMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient)
+{
+	const auto AddInstanceEntry = [this, &MenuBuilder, ViewportClient](const FText& Label, int32 PIEInstance)
+	{
+		MenuBuilder.AddMenuEntry(
+			Label,
+			FText::GetEmpty(),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateUObject(this, &USyncViewportSubsystem::SetViewportPIEInstance, ViewportClient, PIEInstance),
+				FCanExecuteAction(),
+				FIsActionChecked::CreateUObject(this, &USyncViewportSubsystem::IsViewportPIEInstance, ViewportClient, PIEInstance)
+			),
+			NAME_None,
+			EUserInterfaceActionType::RadioButton
+		);
+	};
+
+	AddInstanceEntry(LOCTEXT("DefaultPIEInstance", "Default"), INDEX_NONE);
+
+	if(PIEWorldContexts.Num() > 0)
+	{
+		for(const FWorldContext* WorldContext : PIEWorldContexts)
+		{
+			AddInstanceEntry(GetWorldContextDisplayText(*WorldContext), WorldContext->PIEInstance);
+		}
+	}
+	else
+	{
+		// Can't tell which is the server until we're playing, instances are numbered the same every session though
+		static const int32 MaxPIEInstancesOutsidePIE = 5;
+		for(int32 PIEInstance = 0; PIEInstance < MaxPIEInstancesOutsidePIE; ++PIEInstance)
+		{
+			AddInstanceEntry(FText::Format(LOCTEXT("PIEInstanceNumber", "Instance {0}"), FText::AsNumber(PIEInstance)), PIEInstance);
+		}
+	}
+}
+
+void USyncViewportSubsystem::CreateFollowFilterMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient)
+{
+	const EViewportSyncFollowFilter Filters[] =
+	{
+		EViewportSyncFollowFilter::None,
+		EViewportSyncFollowFilter::ConstantSpeed,
+		EViewportSyncFollowFilter::CriticallyDamped,
+		EViewportSyncFollowFilter::OneEuro,
+	};
+
+	for(const EViewportSyncFollowFilter Filter : Filters)
+	{
+		MenuBuilder.AddMenuEntry(
+			FViewportSyncFollowFilterSettings::GetDisplayText(Filter),
+			FText::GetEmpty(),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateUObject(this, &USyncViewportSubsystem::SetViewportFollowFilter, ViewportClient, Filter),
+				FCanExecuteAction(),
+				FIsActionChecked::CreateUObject(this, &USyncViewportSubsystem::IsViewportFollowFilter, ViewportClient, Filter)
+			),
+			NAME_None,
+			EUserInterfaceActionType::RadioButton
+		);
+	}
+}
+
+void USyncViewportSubsystem::CreateMirrorPlayerMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient)
+{
+	// Outside of PIE there's nobody to count yet, offer the usual split screen players
+	int32 NumPlayers = 4;
+	if(const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportStates.Find(ViewportClient)))
+	{
+		if(const UWorld* World = ViewportState->SyncedWorldContext != nullptr ? ViewportState->SyncedWorldContext->World() : nullptr)
+		{
+			NumPlayers = World->GetNumPlayerControllers();
+		}
+	}
+
+	for(int32 PlayerIndex = INDEX_NONE; PlayerIndex < NumPlayers; ++PlayerIndex)
+	{
+		MenuBuilder.AddMenuEntry(
+			FViewportSyncPlayerMirror::GetDisplayText(PlayerIndex),
+			FText::GetEmpty(),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateLambda([this, ViewportClient, PlayerIndex]()
+				{
+					SetViewportMirror(ViewportClient, GetDefault<UViewportSyncSettings>()->MakePlayerMirror(PlayerIndex));
+				}),
+				FCanExecuteAction(),
+				FIsActionChecked::CreateUObject(this, &USyncViewportSubsystem::IsViewportMirroringPlayer, ViewportClient, PlayerIndex)
+			),
+			NAME_None,
+			EUserInterfaceActionType::RadioButton
+		);
+	}
+}
+
+void USyncViewportSubsystem::CreateStreamingPolicyMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient)
+{
+	const EViewportSyncStreamingPolicy Policies[] =
+	{
+		EViewportSyncStreamingPolicy::Full,
+		EViewportSyncStreamingPolicy::Reduced,
+		EViewportSyncStreamingPolicy::None,
+	};
+
+	for(const EViewportSyncStreamingPolicy Policy : Policies)
+	{
+		MenuBuilder.AddMenuEntry(
+			FViewportSyncStreaming::GetDisplayText(Policy),
+			FText::GetEmpty(),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateUObject(this, &USyncViewportSubsystem::SetViewportStreamingPolicy, ViewportClient, Policy),
+				FCanExecuteAction(),
+				FIsActionChecked::CreateUObject(this, &USyncViewportSubsystem::IsViewportStreamingPolicy, ViewportClient, Policy)
+			),
+			NAME_None,
+			EUserInterfaceActionType::RadioButton
+		);
+	}
+}
+
+void USyncViewportSubsystem::CreateRenderProfileMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient)
+{
+	for(const FViewportSyncRenderProfile& Profile : GetDefault<UViewportSyncSettings>()->RenderProfiles)
+	{
+		MenuBuilder.AddMenuEntry(
+			FText::FromName(Profile.Name),
+			FText::GetEmpty(),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateUObject(this, &USyncViewportSubsystem::SetViewportRenderProfile, ViewportClient, Profile.Name),
+				FCanExecuteAction(),
+				FIsActionChecked::CreateUObject(this, &USyncViewportSubsystem::IsViewportRenderProfile, ViewportClient, Profile.Name)
+			),
+			NAME_None,
+			EUserInterfaceActionType::RadioButton
+		);
+	}
+}
+
 void USyncViewportSubsystem::CreateFollowActorMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient)
 {
 	// Set up a menu entry to add the selected actor(s) to the sequencer
@@ -618,7 +2895,9 @@ void USyncViewportSubsystem::CreateFollowActorMenuForViewport(FMenuBuilder& Menu
 	{
 		SelectedActor = SelectedActors[0];
 		
-		SelectedActorDisplayName	= FText::Format(LOCTEXT("FollowSelectedActor", "Follow '{0}'"), FText::FromString(SelectedActor->GetActorLabel()));
+		SelectedActorDisplayName	= SelectedActors.Num() > 1
+										? FText::Format(LOCTEXT("FollowSelectedActors", "Follow {0} Selected Actors"), FText::AsNumber(SelectedActors.Num()))
+										: FText::Format(LOCTEXT("FollowSelectedActor", "Follow '{0}'"), FText::FromString(SelectedActor->GetActorLabel()));
 		SelectedActorIcon			= FSlateIconFinder::FindIconForClass(SelectedActor->GetClass());
 	}
 	else
@@ -635,6 +2914,41 @@ void USyncViewportSubsystem::CreateFollowActorMenuForViewport(FMenuBuilder& Menu
 			FText(), 
 			SelectedActorIcon
 		);
+
+		// Groups that pick up matching actors as they spawn
+		const TSubclassOf<AActor> SelectedClass = SelectedActor->GetClass();
+		MenuBuilder.AddMenuEntry(
+			FText::Format(LOCTEXT("FollowAllOfClass", "Follow All '{0}'"), SelectedClass->GetDisplayNameText()),
+			LOCTEXT("FollowAllOfClassTooltip", "Keep every actor of this class in frame, including ones spawned later"),
+			SelectedActorIcon,
+			FUIAction(FExecuteAction::CreateLambda([this, ViewportClient, SelectedClass]()
+			{
+				SetViewportFollowGroup(ViewportClient, FViewportSyncFollowGroupDesc::FromClass(SelectedClass));
+			}))
+		);
+
+		MenuBuilder.AddMenuEntry(
+			FText::Format(LOCTEXT("AutoFollowNearestOfClass", "Auto Follow Nearest '{0}'"), SelectedClass->GetDisplayNameText()),
+			LOCTEXT("AutoFollowNearestOfClassTooltip", "Follow whichever actor of this class is closest to the player, switching as that changes"),
+			SelectedActorIcon,
+			FUIAction(FExecuteAction::CreateLambda([this, ViewportClient, SelectedClass]()
+			{
+				SetViewportAutoFollow(ViewportClient, GetDefault<UViewportSyncSettings>()->MakeNearestAutoFollowRule(SelectedClass));
+			}))
+		);
+
+		for (const FName& Tag : SelectedActor->Tags)
+		{
+			MenuBuilder.AddMenuEntry(
+				FText::Format(LOCTEXT("FollowAllWithTag", "Follow All Tagged '{0}'"), FText::FromName(Tag)),
+				LOCTEXT("FollowAllWithTagTooltip", "Keep every actor with this tag in frame, including ones spawned later"),
+				FSlateIcon(),
+				FUIAction(FExecuteAction::CreateLambda([this, ViewportClient, Tag]()
+				{
+					SetViewportFollowGroup(ViewportClient, FViewportSyncFollowGroupDesc::FromTag(Tag));
+				}))
+			);
+		}
 	}
 
 	/* Scene outliner for picking a follow actor */
@@ -685,28 +2999,7 @@ void USyncViewportSubsystem::CreateFollowActorMenuForViewport(FMenuBuilder& Menu
 void USyncViewportSubsystem::BuildCurrentFollowActorWidgetForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient)
 {
 	const FLiveViewportInfo* ViewportInfo = GetDataForViewport(ViewportClient);
-
-	const auto ActorName = [ViewportInfo, &GlobalFollowActorOverride = GlobalFollowActorOverride]()
-	{
-		FString SelectedActorDetail;
-
-		const TSoftObjectPtr<AActor> TargetActor = !GlobalFollowActorOverride.IsNull() ? GlobalFollowActorOverride : ViewportInfo->FollowActor;
-		
-		if (TargetActor.IsValid())
-		{
-			SelectedActorDetail = FString::Printf(TEXT("Following: '%s'"), *TargetActor->GetActorLabel());
-		}
-		else if (TargetActor.IsPending())
-		{
-			SelectedActorDetail = FString::Printf(TEXT("Waiting for: %s"), *TargetActor.ToSoftObjectPath().GetSubPathString());
-		}
-		else
-		{
-			SelectedActorDetail = TEXT("No follow Actor set");
-		}
-
-		return FText::Format(LOCTEXT("FollowSelectedActor", "{0} {1}"), (!GlobalFollowActorOverride.IsNull() ? FText::FromString("[Override]") : FText::GetEmpty()), FText::FromString(SelectedActorDetail));
-	};
+	const TSharedRef<FViewportSyncViewModel> ViewModel = ViewportInfo->ViewModel;
 	
 	MenuBuilder.AddWidget(
 		SNew(SHorizontalBox)
@@ -725,7 +3018,7 @@ void USyncViewportSubsystem::BuildCurrentFollowActorWidgetForViewport(FMenuBuild
 				.ForegroundColor(FSlateColor::UseForeground())
 				.ButtonStyle(FEditorStyle::Get(), "NoBorder")
 				.ContentPadding(0.0f)
-				.Text_Lambda(ActorName)
+				.Text(ViewModel, &FViewportSyncViewModel::GetFollowText)
 		]
 		+ SHorizontalBox::Slot()
 		.VAlign(VAlign_Center)
@@ -736,17 +3029,10 @@ void USyncViewportSubsystem::BuildCurrentFollowActorWidgetForViewport(FMenuBuild
 				{
 					this->SetViewportFollowActor(ViewportClient, nullptr);
 				})
-				.Visibility_Lambda([this, ViewportClient, ViewportInfo]()
-				{
-					if (IsViewportSyncing(ViewportClient) && !ViewportInfo->FollowActor.IsNull())
-					{
-						return EVisibility::Visible;
-					}
-					return EVisibility::Hidden;
-				})
+				.Visibility(ViewModel, &FViewportSyncViewModel::GetClearFollowVisibility)
 				.ForegroundColor(FSlateColor::UseForeground())
 				.HAlign(HAlign_Fill)
-				.ToolTipText(LOCTEXT("ClearFollow", "Remove followed Actor"))
+				.ToolTipText(LOCTEXT("ClearFollow", "Remove followed Actor or group, or stop mirroring a player"))
 				.ButtonStyle(FEditorStyle::Get(), "NoBorder")
 				.Content()
 				[			
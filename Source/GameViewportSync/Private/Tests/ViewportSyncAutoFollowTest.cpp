@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncAutoFollow.h"
+
+// UE Includes
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncAutoFollowMostRelevantTest, "ViewportSync.AutoFollow.MostRelevant", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncAutoFollowMostRelevantTest::RunTest(const FString& Parameters)
+{
+	// Average cost of picking a target out of 10k candidates, a full scan of them is several times this
+	const double MaxUpdateMs = 0.1;
+	const int32 NumPerSide = 100;
+	const float Spacing = 200.0f;
+	const FName ImportantTag(TEXT("Important"));
+
+	// A world of our own so nothing in the open level gets in the way
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<AActor*> Candidates;
+	Candidates.Reserve(NumPerSide * NumPerSide);
+	for (int32 X = 0; X < NumPerSide; ++X)
+	{
+		for (int32 Y = 0; Y < NumPerSide; ++Y)
+		{
+			AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(FVector(X * Spacing, Y * Spacing, 0.0f), FRotator::ZeroRotator, SpawnParameters);
+			Actor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+			if (Candidates.Num() % 97 == 0)
+			{
+				Actor->Tags.Add(ImportantTag);
+			}
+			Candidates.Add(Actor);
+		}
+	}
+
+	// Important candidates are worth being up to 2000 units further away
+	const auto Relevance = [ImportantTag](const AActor& Actor, const FVector& Location, const FVector& Origin)
+	{
+		return -FVector::Dist(Origin, Location) + (Actor.ActorHasTag(ImportantTag) ? 2000.0f : 0.0f);
+	};
+
+	const auto RelevanceBound = [](float Distance)
+	{
+		return -Distance + 2000.0f;
+	};
+
+	const auto ScoreByDistance = [](const AActor& Actor, const FVector& Location, const FVector& Origin)
+	{
+		return -FVector::Dist(Origin, Location);
+	};
+
+	TArray<FVector> Origins;
+	for (int32 Index = 0; Index < 16; ++Index)
+	{
+		Origins.Add(FVector(FMath::FRandRange(0.0f, NumPerSide * Spacing), FMath::FRandRange(0.0f, NumPerSide * Spacing), 0.0f));
+	}
+
+	const auto RunRule = [this, World, &Candidates, &Origins, MaxUpdateMs](const TCHAR* RuleName, FViewportSyncAutoFollowRule Rule, TFunctionRef<float(const AActor&, const FVector&, const FVector&)> ReferenceScore)
+	{
+		Rule.Hysteresis = 0.0f;
+		Rule.MinRetargetTime = 0.0f;
+
+		FViewportSyncAutoFollow AutoFollow(Rule, 1000.0f);
+		AutoFollow.Rebuild(World);
+		TestEqual(FString::Printf(TEXT("%s candidates"), RuleName), AutoFollow.Num(), Candidates.Num());
+
+		// Same pick as scoring every candidate
+		for (const FVector& Origin : Origins)
+		{
+			AActor* Expected = nullptr;
+			float ExpectedScore = -MAX_flt;
+			for (AActor* Candidate : Candidates)
+			{
+				const float CandidateScore = ReferenceScore(*Candidate, Candidate->GetActorLocation(), Origin);
+				if (CandidateScore > ExpectedScore)
+				{
+					Expected = Candidate;
+					ExpectedScore = CandidateScore;
+				}
+			}
+
+			AActor* Picked = AutoFollow.Update(Origin, 0.0, 64);
+			TestTrue(FString::Printf(TEXT("%s picks the best scoring candidate from %s"), RuleName, *Origin.ToString()), Picked != nullptr && FMath::IsNearlyEqual(ReferenceScore(*Picked, Picked->GetActorLocation(), Origin), ExpectedScore));
+		}
+
+		const int32 NumUpdates = 1000;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumUpdates; ++Index)
+		{
+			AutoFollow.Update(Origins[Index % Origins.Num()], 0.0, 64);
+		}
+		const double UpdateMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumUpdates;
+
+		AddInfo(FString::Printf(TEXT("%s update takes %.4fms with %d candidates"), RuleName, UpdateMs, Candidates.Num()));
+		TestTrue(FString::Printf(TEXT("%s update takes %.4fms (target %.2fms)"), RuleName, UpdateMs, MaxUpdateMs), UpdateMs <= MaxUpdateMs);
+	};
+
+	// No search radius, the default distance score and a bounded custom score both stop once nothing further out can win
+	RunRule(TEXT("Closest"), FViewportSyncAutoFollowRule::MostRelevant(AStaticMeshActor::StaticClass(), nullptr), ScoreByDistance);
+	RunRule(TEXT("Bounded relevance"), FViewportSyncAutoFollowRule::MostRelevant(AStaticMeshActor::StaticClass(), Relevance, 0, RelevanceBound), Relevance);
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
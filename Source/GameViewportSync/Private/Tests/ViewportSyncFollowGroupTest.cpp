@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncFollowGroup.h"
+
+// UE Includes
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ViewportSyncFollowGroupTest
+{
+	/* The frame worked out one member at a time, in double precision */
+	static FViewportSyncFollowGroupFrame ComputeReferenceFrame(const TArray<AActor*>& Actors, const TArray<float>& Weights, EViewportSyncFollowGroupFraming Framing)
+	{
+		FVector Min(BIG_NUMBER);
+		FVector Max(-BIG_NUMBER);
+		double SumX = 0.0;
+		double SumY = 0.0;
+		double SumZ = 0.0;
+		double TotalWeight = 0.0;
+
+		for (int32 Index = 0; Index < Actors.Num(); ++Index)
+		{
+			const FVector Location = Actors[Index]->GetActorLocation();
+			Min = Min.ComponentMin(Location);
+			Max = Max.ComponentMax(Location);
+			SumX += static_cast<double>(Location.X) * Weights[Index];
+			SumY += static_cast<double>(Location.Y) * Weights[Index];
+			SumZ += static_cast<double>(Location.Z) * Weights[Index];
+			TotalWeight += Weights[Index];
+		}
+
+		FViewportSyncFollowGroupFrame Frame;
+		Frame.Center = Framing == EViewportSyncFollowGroupFraming::Centroid ? FVector(SumX / TotalWeight, SumY / TotalWeight, SumZ / TotalWeight) : (Min + Max) * 0.5f;
+		Frame.Radius = (Max - Frame.Center).ComponentMax(Frame.Center - Min).Size();
+		Frame.NumMembers = Actors.Num();
+		return Frame;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowGroupTest, "ViewportSync.FollowGroup", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowGroupTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncFollowGroupTest;
+
+	// Average cost of framing a group this big, the budget for a crowd the camera keeps in shot
+	const int32 NumTimedMembers = 5000;
+	const double MaxComputeMs = 0.1;
+
+	// A world of our own so nothing in the open level gets in the way
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	FRandomStream Random(1234);
+
+	TArray<AActor*> Actors;
+	TArray<float> Weights;
+	for (int32 Index = 0; Index < NumTimedMembers; ++Index)
+	{
+		const FVector Location(Random.FRandRange(-10000.0f, 10000.0f), Random.FRandRange(-10000.0f, 10000.0f), Random.FRandRange(0.0f, 2000.0f));
+		AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator, SpawnParameters);
+		Actor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+		Actors.Add(Actor);
+		Weights.Add(Random.FRandRange(0.5f, 2.0f));
+	}
+
+	const auto MapActor = [](AActor* Actor)
+	{
+		return Actor;
+	};
+
+	const auto MakeDesc = [&Actors, &Weights](int32 NumMembers, EViewportSyncFollowGroupFraming Framing)
+	{
+		FViewportSyncFollowGroupDesc Desc = FViewportSyncFollowGroupDesc::FromActors(TArray<AActor*>(Actors.GetData(), NumMembers), Framing);
+		Desc.Weights = TArray<float>(Weights.GetData(), NumMembers);
+		return Desc;
+	};
+
+	// Sizes that leave a partial vector at the end, and ones either side of a chunk and of going parallel
+	const int32 GroupSizes[] = { 1, 2, 3, 5, 7, 255, 257, 1023, 1025, 1027, NumTimedMembers };
+	const EViewportSyncFollowGroupFraming Framings[] = { EViewportSyncFollowGroupFraming::Bounds, EViewportSyncFollowGroupFraming::Centroid };
+
+	for (const EViewportSyncFollowGroupFraming Framing : Framings)
+	{
+		const TCHAR* FramingName = Framing == EViewportSyncFollowGroupFraming::Centroid ? TEXT("Centroid") : TEXT("Bounds");
+
+		for (const int32 GroupSize : GroupSizes)
+		{
+			FViewportSyncFollowGroup Group(MakeDesc(GroupSize, Framing));
+			Group.Rebuild(World, MapActor);
+
+			const FViewportSyncFollowGroupFrame Expected = ComputeReferenceFrame(TArray<AActor*>(Actors.GetData(), GroupSize), TArray<float>(Weights.GetData(), GroupSize), Framing);
+
+			FViewportSyncFollowGroupFrame Frame;
+			if (!TestTrue(FString::Printf(TEXT("%s frame of %d members"), FramingName, GroupSize), Group.ComputeFrame(Frame)))
+			{
+				continue;
+			}
+
+			TestEqual(FString::Printf(TEXT("%s members of %d"), FramingName, GroupSize), Frame.NumMembers, Expected.NumMembers);
+			TestTrue(FString::Printf(TEXT("%s center of %d members is %s, expected %s"), FramingName, GroupSize, *Frame.Center.ToString(), *Expected.Center.ToString()), Frame.Center.Equals(Expected.Center, 1.0f));
+			TestTrue(FString::Printf(TEXT("%s radius of %d members is %f, expected %f"), FramingName, GroupSize, Frame.Radius, Expected.Radius), FMath::IsNearlyEqual(Frame.Radius, Expected.Radius, 1.0f));
+		}
+	}
+
+	// Destroyed members drop out of the frame and the group
+	{
+		FViewportSyncFollowGroup Group(MakeDesc(7, EViewportSyncFollowGroupFraming::Bounds));
+		Group.Rebuild(World, MapActor);
+
+		Actors[6]->Destroy();
+		const FViewportSyncFollowGroupFrame Expected = ComputeReferenceFrame(TArray<AActor*>(Actors.GetData(), 6), TArray<float>(Weights.GetData(), 6), EViewportSyncFollowGroupFraming::Bounds);
+
+		FViewportSyncFollowGroupFrame Frame;
+		TestTrue(TEXT("Frame after a member is destroyed"), Group.ComputeFrame(Frame));
+		TestEqual(TEXT("Members after a member is destroyed"), Frame.NumMembers, 6);
+		TestTrue(TEXT("Center after a member is destroyed"), Frame.Center.Equals(Expected.Center, 1.0f));
+		TestEqual(TEXT("Group after a member is destroyed"), Group.Num(), 6);
+
+		Actors[6] = World->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParameters);
+	}
+
+	// Timed on the full group, after a warm up so the buffers are already sized
+	{
+		FViewportSyncFollowGroup Group(MakeDesc(NumTimedMembers, EViewportSyncFollowGroupFraming::Centroid));
+		Group.Rebuild(World, MapActor);
+
+		FViewportSyncFollowGroupFrame Frame;
+		Group.ComputeFrame(Frame);
+
+		const int32 NumComputes = 200;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumComputes; ++Index)
+		{
+			Group.ComputeFrame(Frame);
+		}
+		const double ComputeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumComputes;
+
+		AddInfo(FString::Printf(TEXT("Framing %d members takes %.4fms"), NumTimedMembers, ComputeMs));
+		TestTrue(FString::Printf(TEXT("Framing %d members takes %.4fms (target %.2fms)"), NumTimedMembers, ComputeMs, MaxComputeMs), ComputeMs <= MaxComputeMs);
+	}
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
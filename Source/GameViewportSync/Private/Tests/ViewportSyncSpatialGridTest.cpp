@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncSpatialGrid.h"
+
+// UE Includes
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncSpatialGridTest, "ViewportSync.SpatialGrid", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncSpatialGridTest::RunTest(const FString& Parameters)
+{
+	// A world of our own so nothing in the open level gets in the way
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const auto SpawnAt = [World, &SpawnParameters](const FVector& Location)
+	{
+		AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator, SpawnParameters);
+		Actor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+		return Actor;
+	};
+
+	AStaticMeshActor* Near = SpawnAt(FVector(0.0f, 0.0f, 0.0f));
+	AStaticMeshActor* NextCell = SpawnAt(FVector(1500.0f, 0.0f, 0.0f));
+	AStaticMeshActor* Far = SpawnAt(FVector(5000.0f, 5000.0f, 0.0f));
+
+	FViewportSyncSpatialGrid Grid(1000.0f);
+	Grid.Add(Near);
+	Grid.Add(NextCell);
+	Grid.Add(Far);
+	Grid.Add(nullptr);
+
+	TestEqual(TEXT("Null actors aren't added"), Grid.Num(), 3);
+
+	float DistanceSquared = 0.0f;
+	TestTrue(TEXT("Nearest across a cell boundary"), Grid.FindNearest(FVector(1400.0f, 0.0f, 0.0f), 0.0f, DistanceSquared) == NextCell);
+	TestEqual(TEXT("Distance to the nearest"), DistanceSquared, 100.0f * 100.0f);
+	TestTrue(TEXT("Nearest in the same cell"), Grid.FindNearest(FVector(0.0f, 100.0f, 0.0f), 0.0f, DistanceSquared) == Near);
+	TestTrue(TEXT("Nearest several cells out with no limit"), Grid.FindNearest(FVector(9000.0f, 9000.0f, 0.0f), 0.0f, DistanceSquared) == Far);
+	TestNull(TEXT("Nothing within the max distance"), Grid.FindNearest(FVector(3000.0f, 3000.0f, 0.0f), 500.0f, DistanceSquared));
+
+	const auto CountInRadius = [&Grid](const FVector& Origin, float Radius)
+	{
+		int32 Count = 0;
+		Grid.ForEachInRadius(Origin, Radius, [&Count](AActor* Actor, const FVector& Location)
+		{
+			++Count;
+		});
+		return Count;
+	};
+
+	TestEqual(TEXT("Radius query"), CountInRadius(FVector::ZeroVector, 2000.0f), 2);
+	TestEqual(TEXT("Radius query with no radius returns everything"), CountInRadius(FVector::ZeroVector, 0.0f), 3);
+
+	// Queries use the cached location until a refresh moves the actor into its new cell
+	Far->SetActorLocation(FVector(100.0f, 0.0f, 0.0f));
+	TestTrue(TEXT("Moved actor is found where it was before a refresh"), Grid.FindNearest(FVector(9000.0f, 9000.0f, 0.0f), 0.0f, DistanceSquared) == Far);
+	TestEqual(TEXT("Moved actor isn't in its new cell before a refresh"), CountInRadius(FVector::ZeroVector, 500.0f), 1);
+
+	Grid.Refresh(0);
+	TestTrue(TEXT("Moved actor is found in its new cell after a refresh"), Grid.FindNearest(FVector(200.0f, 0.0f, 0.0f), 0.0f, DistanceSquared) == Far);
+	TestEqual(TEXT("Radius query after a refresh"), CountInRadius(FVector::ZeroVector, 500.0f), 2);
+
+	// Destroyed actors are skipped straight away and dropped on the next refresh
+	NextCell->Destroy();
+	TestTrue(TEXT("Destroyed actor isn't returned"), Grid.FindNearest(FVector(1400.0f, 0.0f, 0.0f), 0.0f, DistanceSquared) != NextCell);
+
+	Grid.Refresh(0);
+	TestEqual(TEXT("Destroyed actor is dropped"), Grid.Num(), 2);
+	TestEqual(TEXT("Radius query after dropping"), CountInRadius(FVector::ZeroVector, 0.0f), 2);
+
+	Grid.Reset();
+	TestEqual(TEXT("Reset"), Grid.Num(), 0);
+	TestNull(TEXT("Nothing to find after a reset"), Grid.FindNearest(FVector::ZeroVector, 0.0f, DistanceSquared));
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncActorCorrespondence.h"
+
+// UE Includes
+#include "Engine/Engine.h"
+#include "Engine/NetDriver.h"
+#include "Engine/PackageMapClient.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+AActor* FViewportSyncActorCorrespondence::Find(const AActor* SourceActor, const FWorldContext& TargetWorldContext)
+{
+	UWorld* TargetWorld = TargetWorldContext.World();
+	if (SourceActor == nullptr || TargetWorld == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (SourceActor->GetWorld() == TargetWorld)
+	{
+		return const_cast<AActor*>(SourceActor);
+	}
+
+	const TPair<FObjectKey, FObjectKey> Key(SourceActor, TargetWorld);
+	if (const TWeakObjectPtr<AActor>* CachedActor = Cache.Find(Key))
+	{
+		if (CachedActor->IsValid())
+		{
+			return CachedActor->Get();
+		}
+	}
+
+	AActor* TargetActor = FindByNetGUID(SourceActor, TargetWorld);
+	if (TargetActor == nullptr)
+	{
+		TargetActor = FindByPath(SourceActor, TargetWorldContext.PIEInstance);
+	}
+
+	// Don't cache misses, the actor might just not have replicated yet
+	if (TargetActor != nullptr && TargetActor->GetWorld() == TargetWorld)
+	{
+		Cache.Add(Key, TargetActor);
+		return TargetActor;
+	}
+
+	return nullptr;
+}
+
+void FViewportSyncActorCorrespondence::Reset()
+{
+	Cache.Reset();
+}
+
+AActor* FViewportSyncActorCorrespondence::FindByNetGUID(const AActor* SourceActor, UWorld* TargetWorld)
+{
+	const UNetDriver* SourceNetDriver = SourceActor->GetWorld()->GetNetDriver();
+	const UNetDriver* TargetNetDriver = TargetWorld->GetNetDriver();
+
+	if (SourceNetDriver == nullptr || TargetNetDriver == nullptr || !SourceNetDriver->GuidCache.IsValid() || !TargetNetDriver->GuidCache.IsValid())
+	{
+		return nullptr;
+	}
+
+	const FNetworkGUID NetGUID = SourceNetDriver->GuidCache->GetNetGUID(SourceActor);
+	if (!NetGUID.IsValid())
+	{
+		return nullptr;
+	}
+
+	return Cast<AActor>(TargetNetDriver->GuidCache->GetObjectFromNetGUID(NetGUID, false));
+}
+
+AActor* FViewportSyncActorCorrespondence::FindByPath(const AActor* SourceActor, int32 TargetPIEInstance)
+{
+	FSoftObjectPath TargetPath(UWorld::RemovePIEPrefix(SourceActor->GetPathName()));
+	TargetPath.FixupForPIE(TargetPIEInstance);
+
+	return Cast<AActor>(TargetPath.ResolveObject());
+}
@@ -0,0 +1,179 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncAutoFollow.h"
+
+// UE Includes
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+#define LOCTEXT_NAMESPACE "ViewportSyncAutoFollow"
+
+FViewportSyncAutoFollowRule FViewportSyncAutoFollowRule::Nearest(TSubclassOf<AActor> InActorClass, int32 InPlayerIndex)
+{
+	FViewportSyncAutoFollowRule Rule;
+	Rule.Mode = EViewportSyncAutoFollowMode::Nearest;
+	Rule.ActorClass = InActorClass;
+	Rule.PlayerIndex = InPlayerIndex;
+	return Rule;
+}
+
+FViewportSyncAutoFollowRule FViewportSyncAutoFollowRule::MostRelevant(TSubclassOf<AActor> InActorClass, TFunction<float(const AActor&, const FVector&, const FVector&)> InRelevance, int32 InPlayerIndex, TFunction<float(float)> InRelevanceBound)
+{
+	FViewportSyncAutoFollowRule Rule;
+	Rule.Mode = EViewportSyncAutoFollowMode::MostRelevant;
+	Rule.ActorClass = InActorClass;
+	Rule.Relevance = MoveTemp(InRelevance);
+	Rule.RelevanceBound = MoveTemp(InRelevanceBound);
+	Rule.PlayerIndex = InPlayerIndex;
+	return Rule;
+}
+
+bool FViewportSyncAutoFollowRule::Matches(const AActor* Actor) const
+{
+	return ActorClass != nullptr && Actor->IsA(ActorClass);
+}
+
+FText FViewportSyncAutoFollowRule::GetDisplayText() const
+{
+	const FText ClassName = ActorClass != nullptr ? ActorClass->GetDisplayNameText() : FText::GetEmpty();
+	return Mode == EViewportSyncAutoFollowMode::Nearest
+		? FText::Format(LOCTEXT("Nearest", "Nearest '{0}'"), ClassName)
+		: FText::Format(LOCTEXT("MostRelevant", "Most Relevant '{0}'"), ClassName);
+}
+
+FViewportSyncAutoFollow::FViewportSyncAutoFollow(const FViewportSyncAutoFollowRule& InRule, float CellSize)
+	: Rule(InRule)
+	, Grid(CellSize)
+	, LastRetargetTime(0.0)
+	, bNeedsRebuild(true)
+{}
+
+void FViewportSyncAutoFollow::Rebuild(UWorld* InWorld)
+{
+	Grid.Reset();
+	Target.Reset();
+	LastRetargetTime = 0.0;
+
+	World = InWorld;
+	bNeedsRebuild = false;
+
+	if (InWorld != nullptr && Rule.ActorClass != nullptr)
+	{
+		for (TActorIterator<AActor> It(InWorld, Rule.ActorClass); It; ++It)
+		{
+			Grid.Add(*It);
+		}
+	}
+}
+
+void FViewportSyncAutoFollow::OnActorSpawned(AActor* Actor)
+{
+	if (!bNeedsRebuild && Actor->GetWorld() == World.Get() && Rule.Matches(Actor))
+	{
+		Grid.Add(Actor);
+	}
+}
+
+AActor* FViewportSyncAutoFollow::Update(const FVector& Origin, double CurrentTime, int32 RefreshBudget)
+{
+	Grid.Refresh(RefreshBudget);
+
+	AActor* Current = Target.Get();
+
+	// Settle on a target for a while before looking for a better one
+	if (Current != nullptr && CurrentTime - LastRetargetTime < Rule.MinRetargetTime)
+	{
+		return Current;
+	}
+
+	// The current target is measured where it is now rather than where the grid last saw it
+	const FVector CurrentLocation = Current != nullptr ? Current->GetActorLocation() : FVector::ZeroVector;
+	if (Current != nullptr && Rule.SearchRadius > 0.0f && FVector::DistSquared(Origin, CurrentLocation) > FMath::Square(Rule.SearchRadius))
+	{
+		Current = nullptr;
+	}
+
+	AActor* Best = nullptr;
+	bool bSwitch = false;
+
+	if (Rule.Mode == EViewportSyncAutoFollowMode::Nearest)
+	{
+		float BestDistanceSquared = 0.0f;
+		Best = Grid.FindNearest(Origin, Rule.SearchRadius, BestDistanceSquared);
+
+		// Has to be closer by more than the hysteresis, so two candidates about as far away don't fight over the camera
+		bSwitch = Current == nullptr || (Best != nullptr && BestDistanceSquared < FVector::DistSquared(Origin, CurrentLocation) * FMath::Square(1.0f - Rule.Hysteresis));
+	}
+	else
+	{
+		float BestScore = 0.0f;
+		Best = FindMostRelevant(Origin, BestScore);
+
+		if (Current == nullptr)
+		{
+			bSwitch = true;
+		}
+		else if (Best != nullptr)
+		{
+			const float CurrentScore = Score(*Current, CurrentLocation, Origin);
+			bSwitch = BestScore > CurrentScore + FMath::Abs(CurrentScore) * Rule.Hysteresis;
+		}
+	}
+
+	if (bSwitch && Best != Target.Get())
+	{
+		Target = Best;
+		LastRetargetTime = CurrentTime;
+	}
+
+	return Target.Get();
+}
+
+void FViewportSyncAutoFollow::Reset()
+{
+	Grid.Reset();
+	Target.Reset();
+	World.Reset();
+	bNeedsRebuild = true;
+}
+
+AActor* FViewportSyncAutoFollow::FindMostRelevant(const FVector& Origin, float& OutScore) const
+{
+	AActor* Best = nullptr;
+	float BestScore = -MAX_flt;
+
+	const auto Visit = [this, &Origin, &Best, &BestScore](AActor* Actor, const FVector& Location)
+	{
+		const float ActorScore = Score(*Actor, Location, Origin);
+		if (ActorScore > BestScore)
+		{
+			Best = Actor;
+			BestScore = ActorScore;
+		}
+	};
+
+	// Without a bound on the score any candidate could win, so they all get scored
+	if (Rule.Relevance && !Rule.RelevanceBound)
+	{
+		Grid.ForEachInRadius(Origin, Rule.SearchRadius, Visit);
+	}
+	else
+	{
+		// Stop at the first ring where nothing can beat the best so far, the default score is just how close a candidate is
+		Grid.ForEachOutward(Origin, Rule.SearchRadius, [this, &Best, &BestScore](float RingDistance)
+		{
+			return Best == nullptr || (Rule.RelevanceBound ? Rule.RelevanceBound(RingDistance) : -RingDistance) > BestScore;
+		},
+		Visit);
+	}
+
+	OutScore = BestScore;
+	return Best;
+}
+
+float FViewportSyncAutoFollow::Score(const AActor& Actor, const FVector& Location, const FVector& Origin) const
+{
+	return Rule.Relevance ? Rule.Relevance(Actor, Location, Origin) : -FVector::Dist(Origin, Location);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncCommandQueue.h"
+
+// UE Includes
+#include "GameFramework/Actor.h"
+
+bool FViewportSyncCommandSender::FollowActor(const AActor* Actor) const
+{
+	if (Actor == nullptr)
+	{
+		return ClearFollow();
+	}
+
+	FViewportSyncCommand Command;
+	Command.Type = FViewportSyncCommand::EType::FollowActor;
+	Command.Actor = Actor;
+	return Send(Command);
+}
+
+bool FViewportSyncCommandSender::FollowLocation(const FVector& Location) const
+{
+	FViewportSyncCommand Command;
+	Command.Type = FViewportSyncCommand::EType::FollowLocation;
+	Command.Location = Location;
+	return Send(Command);
+}
+
+bool FViewportSyncCommandSender::ClearFollow() const
+{
+	FViewportSyncCommand Command;
+	Command.Type = FViewportSyncCommand::EType::ClearFollow;
+	return Send(Command);
+}
+
+bool FViewportSyncCommandSender::MarkEvent(const FVector& Location, FName Label) const
+{
+	FViewportSyncCommand Command;
+	Command.Type = FViewportSyncCommand::EType::MarkEvent;
+	Command.Location = Location;
+	Command.Label = Label;
+	return Send(Command);
+}
+
+bool FViewportSyncCommandSender::Send(const FViewportSyncCommand& Command) const
+{
+	return Queue.IsValid() && Queue->Enqueue(Command);
+}
@@ -0,0 +1,339 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncFollowGroup.h"
+
+// UE Includes
+#include "Async/ParallelFor.h"
+#include "Components/SceneComponent.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+#define LOCTEXT_NAMESPACE "ViewportSyncFollowGroup"
+
+namespace ViewportSyncFollowGroup
+{
+	// Members per chunk, has to be a multiple of 4 for the vector loads
+	static const int32 ChunkSize = 256;
+
+	// Below this the worker thread handoff costs more than it saves
+	static const int32 MinMembersForParallel = 1024;
+
+	static float HorizontalMin(VectorRegister Vector)
+	{
+		float Values[4];
+		VectorStore(Vector, Values);
+		return FMath::Min(FMath::Min(Values[0], Values[1]), FMath::Min(Values[2], Values[3]));
+	}
+
+	static float HorizontalMax(VectorRegister Vector)
+	{
+		float Values[4];
+		VectorStore(Vector, Values);
+		return FMath::Max(FMath::Max(Values[0], Values[1]), FMath::Max(Values[2], Values[3]));
+	}
+
+	static float HorizontalSum(VectorRegister Vector)
+	{
+		float Values[4];
+		VectorStore(Vector, Values);
+		return (Values[0] + Values[1]) + (Values[2] + Values[3]);
+	}
+}
+
+FViewportSyncFollowGroupDesc FViewportSyncFollowGroupDesc::FromActors(const TArray<AActor*>& InActors, EViewportSyncFollowGroupFraming InFraming)
+{
+	FViewportSyncFollowGroupDesc Desc;
+	Desc.Source = EViewportSyncFollowGroupSource::Actors;
+	Desc.Framing = InFraming;
+	Desc.Actors.Reserve(InActors.Num());
+	for (AActor* Actor : InActors)
+	{
+		Desc.Actors.Add(Actor);
+	}
+	return Desc;
+}
+
+FViewportSyncFollowGroupDesc FViewportSyncFollowGroupDesc::FromClass(TSubclassOf<AActor> InActorClass, EViewportSyncFollowGroupFraming InFraming)
+{
+	FViewportSyncFollowGroupDesc Desc;
+	Desc.Source = EViewportSyncFollowGroupSource::Class;
+	Desc.Framing = InFraming;
+	Desc.ActorClass = InActorClass;
+	return Desc;
+}
+
+FViewportSyncFollowGroupDesc FViewportSyncFollowGroupDesc::FromTag(FName InTag, EViewportSyncFollowGroupFraming InFraming)
+{
+	FViewportSyncFollowGroupDesc Desc;
+	Desc.Source = EViewportSyncFollowGroupSource::Tag;
+	Desc.Framing = InFraming;
+	Desc.Tag = InTag;
+	return Desc;
+}
+
+bool FViewportSyncFollowGroupDesc::Matches(const AActor* Actor) const
+{
+	switch (Source)
+	{
+	case EViewportSyncFollowGroupSource::Class:
+		return ActorClass != nullptr && Actor->IsA(ActorClass);
+	case EViewportSyncFollowGroupSource::Tag:
+		return !Tag.IsNone() && Actor->ActorHasTag(Tag);
+	default:
+		return false;
+	}
+}
+
+FText FViewportSyncFollowGroupDesc::GetDisplayText() const
+{
+	switch (Source)
+	{
+	case EViewportSyncFollowGroupSource::Class:
+		return FText::Format(LOCTEXT("ClassGroup", "All '{0}'"), ActorClass != nullptr ? ActorClass->GetDisplayNameText() : FText::GetEmpty());
+	case EViewportSyncFollowGroupSource::Tag:
+		return FText::Format(LOCTEXT("TagGroup", "Tagged '{0}'"), FText::FromName(Tag));
+	default:
+		return FText::Format(LOCTEXT("ActorsGroup", "{0} Actors"), FText::AsNumber(Actors.Num()));
+	}
+}
+
+FViewportSyncFollowGroup::FViewportSyncFollowGroup(const FViewportSyncFollowGroupDesc& InDesc)
+	: Desc(InDesc)
+	, bNeedsRebuild(true)
+{}
+
+void FViewportSyncFollowGroup::Rebuild(UWorld* InWorld, TFunctionRef<AActor*(AActor*)> MapActor)
+{
+	Members.Reset();
+	MemberWeights.Reset();
+
+	World = InWorld;
+	bNeedsRebuild = false;
+
+	if (InWorld != nullptr)
+	{
+		switch (Desc.Source)
+		{
+		case EViewportSyncFollowGroupSource::Actors:
+			{
+				for (int32 ActorIndex = 0; ActorIndex < Desc.Actors.Num(); ++ActorIndex)
+				{
+					if (AActor* Actor = Desc.Actors[ActorIndex].Get())
+					{
+						AddMember(MapActor(Actor), Desc.Weights.IsValidIndex(ActorIndex) ? Desc.Weights[ActorIndex] : 1.0f);
+					}
+				}
+				break;
+			}
+		case EViewportSyncFollowGroupSource::Class:
+			{
+				if (Desc.ActorClass != nullptr)
+				{
+					for (TActorIterator<AActor> It(InWorld, Desc.ActorClass); It; ++It)
+					{
+						AddMember(*It, 1.0f);
+					}
+				}
+				break;
+			}
+		case EViewportSyncFollowGroupSource::Tag:
+			{
+				for (TActorIterator<AActor> It(InWorld); It; ++It)
+				{
+					if (It->ActorHasTag(Desc.Tag))
+					{
+						AddMember(*It, 1.0f);
+					}
+				}
+				break;
+			}
+		}
+	}
+
+	ResizeBuffers();
+}
+
+void FViewportSyncFollowGroup::OnActorSpawned(AActor* Actor)
+{
+	if (!bNeedsRebuild && Actor->GetWorld() == World.Get() && Desc.Matches(Actor))
+	{
+		AddMember(Actor, 1.0f);
+		ResizeBuffers();
+	}
+}
+
+void FViewportSyncFollowGroup::Reset()
+{
+	Members.Reset();
+	MemberWeights.Reset();
+	World.Reset();
+	bNeedsRebuild = true;
+}
+
+void FViewportSyncFollowGroup::AddMember(AActor* Actor, float Weight)
+{
+	if (Actor != nullptr)
+	{
+		Members.Add(Actor);
+		MemberWeights.Add(FMath::Max(Weight, 0.0f));
+	}
+}
+
+void FViewportSyncFollowGroup::ResizeBuffers()
+{
+	using namespace ViewportSyncFollowGroup;
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Members.Num(), ChunkSize);
+	const int32 BufferSize = NumChunks * ChunkSize;
+
+	// Never shrink, groups tend to come back to the same size
+	PositionsX.SetNumUninitialized(BufferSize, false);
+	PositionsY.SetNumUninitialized(BufferSize, false);
+	PositionsZ.SetNumUninitialized(BufferSize, false);
+	PackedWeights.SetNumUninitialized(BufferSize, false);
+	ChunkResults.SetNumUninitialized(NumChunks, false);
+}
+
+bool FViewportSyncFollowGroup::ComputeFrame(FViewportSyncFollowGroupFrame& OutFrame)
+{
+	using namespace ViewportSyncFollowGroup;
+
+	const int32 NumMembers = Members.Num();
+	const int32 NumChunks = ChunkResults.Num();
+	if (NumMembers == 0)
+	{
+		return false;
+	}
+
+	ParallelFor(NumChunks, [this, NumMembers](int32 ChunkIndex)
+	{
+		const int32 ChunkBegin = ChunkIndex * ChunkSize;
+		const int32 ChunkEnd = FMath::Min(ChunkBegin + ChunkSize, NumMembers);
+
+		float* RESTRICT X = PositionsX.GetData();
+		float* RESTRICT Y = PositionsY.GetData();
+		float* RESTRICT Z = PositionsZ.GetData();
+		float* RESTRICT W = PackedWeights.GetData();
+
+		// Gather, packing the live members to the front of the chunk
+		int32 WriteIndex = ChunkBegin;
+		for (int32 MemberIndex = ChunkBegin; MemberIndex < ChunkEnd; ++MemberIndex)
+		{
+			const AActor* Actor = Members[MemberIndex].Get();
+			const USceneComponent* RootComponent = Actor != nullptr ? Actor->GetRootComponent() : nullptr;
+			if (RootComponent != nullptr)
+			{
+				const FVector Location = RootComponent->GetComponentLocation();
+				X[WriteIndex] = Location.X;
+				Y[WriteIndex] = Location.Y;
+				Z[WriteIndex] = Location.Z;
+				W[WriteIndex] = MemberWeights[MemberIndex];
+				++WriteIndex;
+			}
+		}
+
+		FChunkResult& Result = ChunkResults[ChunkIndex];
+		Result.NumValid = WriteIndex - ChunkBegin;
+		if (Result.NumValid == 0)
+		{
+			return;
+		}
+
+		// Pad to a multiple of 4 with a copy of the last member that weighs nothing, it can't change the min/max or the sums
+		while ((WriteIndex - ChunkBegin) & 3)
+		{
+			X[WriteIndex] = X[WriteIndex - 1];
+			Y[WriteIndex] = Y[WriteIndex - 1];
+			Z[WriteIndex] = Z[WriteIndex - 1];
+			W[WriteIndex] = 0.0f;
+			++WriteIndex;
+		}
+
+		VectorRegister MinX = VectorLoad(X + ChunkBegin);
+		VectorRegister MinY = VectorLoad(Y + ChunkBegin);
+		VectorRegister MinZ = VectorLoad(Z + ChunkBegin);
+		VectorRegister MaxX = MinX;
+		VectorRegister MaxY = MinY;
+		VectorRegister MaxZ = MinZ;
+		VectorRegister SumX = VectorZero();
+		VectorRegister SumY = VectorZero();
+		VectorRegister SumZ = VectorZero();
+		VectorRegister SumW = VectorZero();
+
+		for (int32 Index = ChunkBegin; Index < WriteIndex; Index += 4)
+		{
+			const VectorRegister VX = VectorLoad(X + Index);
+			const VectorRegister VY = VectorLoad(Y + Index);
+			const VectorRegister VZ = VectorLoad(Z + Index);
+			const VectorRegister VW = VectorLoad(W + Index);
+
+			MinX = VectorMin(MinX, VX);
+			MinY = VectorMin(MinY, VY);
+			MinZ = VectorMin(MinZ, VZ);
+			MaxX = VectorMax(MaxX, VX);
+			MaxY = VectorMax(MaxY, VY);
+			MaxZ = VectorMax(MaxZ, VZ);
+
+			SumX = VectorMultiplyAdd(VX, VW, SumX);
+			SumY = VectorMultiplyAdd(VY, VW, SumY);
+			SumZ = VectorMultiplyAdd(VZ, VW, SumZ);
+			SumW = VectorAdd(SumW, VW);
+		}
+
+		Result.Min = FVector(HorizontalMin(MinX), HorizontalMin(MinY), HorizontalMin(MinZ));
+		Result.Max = FVector(HorizontalMax(MaxX), HorizontalMax(MaxY), HorizontalMax(MaxZ));
+		Result.WeightedSum = FVector(HorizontalSum(SumX), HorizontalSum(SumY), HorizontalSum(SumZ));
+		Result.TotalWeight = HorizontalSum(SumW);
+
+	}, NumMembers < MinMembersForParallel);
+
+	FVector Min(BIG_NUMBER);
+	FVector Max(-BIG_NUMBER);
+	FVector WeightedSum = FVector::ZeroVector;
+	float TotalWeight = 0.0f;
+	int32 NumValid = 0;
+
+	for (const FChunkResult& Result : ChunkResults)
+	{
+		if (Result.NumValid > 0)
+		{
+			Min = Min.ComponentMin(Result.Min);
+			Max = Max.ComponentMax(Result.Max);
+			WeightedSum += Result.WeightedSum;
+			TotalWeight += Result.TotalWeight;
+			NumValid += Result.NumValid;
+		}
+	}
+
+	// Members that have been destroyed are dropped here, on the game thread, rather than in the gather
+	if (NumValid < NumMembers)
+	{
+		for (int32 MemberIndex = Members.Num() - 1; MemberIndex >= 0; --MemberIndex)
+		{
+			if (!Members[MemberIndex].IsValid())
+			{
+				Members.RemoveAtSwap(MemberIndex, 1, false);
+				MemberWeights.RemoveAtSwap(MemberIndex, 1, false);
+			}
+		}
+		ResizeBuffers();
+	}
+
+	if (NumValid == 0)
+	{
+		return false;
+	}
+
+	const FVector BoundsCenter = (Min + Max) * 0.5f;
+	const FVector Center = (Desc.Framing == EViewportSyncFollowGroupFraming::Centroid && TotalWeight > KINDA_SMALL_NUMBER) ? WeightedSum / TotalWeight : BoundsCenter;
+
+	// Furthest corner of the bounds from wherever we ended up centering
+	const FVector Extent = (Max - Center).ComponentMax(Center - Min);
+
+	OutFrame.Center = Center;
+	OutFrame.Radius = Extent.Size();
+	OutFrame.NumMembers = NumValid;
+	return true;
+}
+
+#undef LOCTEXT_NAMESPACE
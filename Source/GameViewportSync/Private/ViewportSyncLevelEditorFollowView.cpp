@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncLevelEditorFollowView.h"
+
+// UE Includes
+#include "UnrealClient.h"
+
+void FViewportSyncLevelEditorFollowView::BeginFollow(const FVector& Location)
+{
+	// This will be modified during the camera lock and we want to restore it
+	const FRotator ViewportViewPreLock	= ViewportClient.GetViewRotation();
+	const FVector PreViewportLockLoc	= ViewportClient.GetViewLocation();
+
+	ViewportClient.bUsingOrbitCamera = true;
+
+	// This is done so we can set the DefaultOrbit<Type> values because otherwise when we try and lock the viewport client it assert will invalid transforms
+	ViewportClient.SetCameraSetup(
+		FVector::ZeroVector,
+		FRotator::ZeroRotator,
+		FVector::ZeroVector,
+		FVector::ZeroVector,
+		FVector::ZeroVector,
+		FRotator::ZeroRotator
+	);
+
+	if (!ViewportClient.IsCameraLocked())
+	{
+		// This is *actually* a toggle so only apply when we're not locked
+		ViewportClient.SetCameraLock();
+	}
+
+	// Restore our values Pre-lock
+	ViewportClient.SetViewRotation(ViewportViewPreLock);
+	ViewportClient.SetViewLocation(PreViewportLockLoc);
+
+	// Recalculate our view now so our viewport correctly updates
+	ViewportClient.SetLookAtLocation(Location, true);
+}
+
+float FViewportSyncLevelEditorFollowView::GetAspectRatio() const
+{
+	const FIntPoint ViewportSize = ViewportClient.Viewport != nullptr ? ViewportClient.Viewport->GetSizeXY() : FIntPoint::ZeroValue;
+	return ViewportSize.X > 0 && ViewportSize.Y > 0 ? static_cast<float>(ViewportSize.X) / ViewportSize.Y : 0.0f;
+}
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LevelEditorViewport.h"
+#include "ViewportSyncFollowCore.h"
+
+/**
+ * Lets the follow core steer a level editor viewport. Cheap enough to make on the stack for each update
+ */
+class FViewportSyncLevelEditorFollowView : public IViewportSyncFollowView
+{
+public:
+	explicit FViewportSyncLevelEditorFollowView(FLevelEditorViewportClient& InViewportClient)
+		: ViewportClient(InViewportClient)
+	{}
+
+	// Begin IViewportSyncFollowView
+	virtual bool IsFollowing() const override { return ViewportClient.bUsingOrbitCamera; }
+	virtual void BeginFollow(const FVector& Location) override;
+	virtual FVector GetLookAtLocation() const override { return ViewportClient.GetLookAtLocation(); }
+	virtual FVector GetViewLocation() const override { return ViewportClient.GetViewLocation(); }
+	virtual void SetOrbit(const FVector& Location, float Distance) override { ViewportClient.SetViewLocationForOrbiting(Location, Distance); }
+	virtual bool IsPerspective() const override { return ViewportClient.IsPerspective(); }
+	virtual float GetFOV() const override { return ViewportClient.ViewFOV; }
+	virtual float GetAspectRatio() const override;
+	// End IViewportSyncFollowView
+
+private:
+	FLevelEditorViewportClient& ViewportClient;
+};
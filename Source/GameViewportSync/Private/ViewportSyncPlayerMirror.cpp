@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncPlayerMirror.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "EditorViewportClient.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+#define LOCTEXT_NAMESPACE "ViewportSyncPlayerMirror"
+
+FViewportSyncPlayerMirror::FViewportSyncPlayerMirror()
+	: PlayerIndex(INDEX_NONE)
+	, FOVOverride(0.0f)
+	, LocationOffset(FVector::ZeroVector)
+	, RotationOffset(FRotator::ZeroRotator)
+{}
+
+FViewportSyncPlayerMirror::FViewportSyncPlayerMirror(int32 InPlayerIndex)
+	: FViewportSyncPlayerMirror()
+{
+	PlayerIndex = InPlayerIndex;
+}
+
+APlayerCameraManager* FViewportSyncPlayerMirror::FindCameraManager(UWorld* World, int32 PlayerIndex)
+{
+	if (World == nullptr || PlayerIndex < 0)
+	{
+		return nullptr;
+	}
+
+	int32 Index = 0;
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator, ++Index)
+	{
+		if (Index == PlayerIndex)
+		{
+			const APlayerController* PlayerController = Iterator->Get();
+			return PlayerController != nullptr ? PlayerController->PlayerCameraManager : nullptr;
+		}
+	}
+	return nullptr;
+}
+
+bool FViewportSyncPlayerMirror::Apply(FEditorViewportClient& ViewportClient, const APlayerCameraManager& CameraManager) const
+{
+	if (!ViewportClient.IsPerspective())
+	{
+		return false;
+	}
+
+	// Cached by the camera manager's update at the end of the world tick, so it's the POV the game renders this frame
+	const FMinimalViewInfo& POV = CameraManager.GetCameraCachePOV();
+	const FQuat CameraRotation = POV.Rotation.Quaternion();
+
+	ViewportClient.SetViewLocation(POV.Location + CameraRotation.RotateVector(LocationOffset));
+	ViewportClient.SetViewRotation((CameraRotation * RotationOffset.Quaternion()).Rotator());
+	ViewportClient.ViewFOV = FOVOverride > 0.0f ? FOVOverride : POV.FOV;
+
+	return true;
+}
+
+FText FViewportSyncPlayerMirror::GetDisplayText(int32 PlayerIndex)
+{
+	return PlayerIndex != INDEX_NONE ? FText::Format(LOCTEXT("Player", "Player {0}"), FText::AsNumber(PlayerIndex)) : LOCTEXT("Off", "Off");
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncPoseStreamWriter.h"
+
+// UE Includes
+#include "HAL/PlatformProcess.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogViewportSyncPoseStream, Log, All);
+
+bool FViewportSyncPoseStreamWriter::Open(const FString& Name)
+{
+	Close();
+
+	const uint32 AccessMode = static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Read) | static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Write);
+	Region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, true, AccessMode, VIEWPORTSYNC_POSESTREAM_SIZE);
+	if (Region == nullptr)
+	{
+		UE_LOG(LogViewportSyncPoseStream, Warning, TEXT("Failed to create the '%s' shared memory region, camera poses won't be published"), *Name);
+		return false;
+	}
+
+	uint8* Memory = static_cast<uint8*>(Region->GetAddress());
+	FMemory::Memzero(Memory, VIEWPORTSYNC_POSESTREAM_SIZE);
+
+	Header = reinterpret_cast<FViewportSyncPoseStreamHeader*>(Memory);
+	Records = reinterpret_cast<FViewportSyncPoseStreamRecord*>(Memory + sizeof(FViewportSyncPoseStreamHeader));
+
+	Header->Version = VIEWPORTSYNC_POSESTREAM_VERSION;
+	Header->HeaderSize = sizeof(FViewportSyncPoseStreamHeader);
+	Header->RecordSize = sizeof(FViewportSyncPoseStreamRecord);
+	Header->Capacity = VIEWPORTSYNC_POSESTREAM_CAPACITY;
+	Header->MaxViewports = VIEWPORTSYNC_POSESTREAM_MAX_VIEWPORTS;
+	Header->WriterProcessId = FPlatformProcess::GetCurrentProcessId();
+
+	// Readers check the magic last, so they never see a half initialized header
+	FPlatformMisc::MemoryBarrier();
+	Header->Magic = VIEWPORTSYNC_POSESTREAM_MAGIC;
+
+	UE_LOG(LogViewportSyncPoseStream, Log, TEXT("Publishing synced camera poses to shared memory '%s'"), *Name);
+	return true;
+}
+
+void FViewportSyncPoseStreamWriter::Close()
+{
+	if (Region == nullptr)
+	{
+		return;
+	}
+
+	if (CurrentRecord != nullptr)
+	{
+		EndRecord();
+	}
+
+	Header->WriterProcessId = 0;
+	FPlatformMisc::MemoryBarrier();
+
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+
+	Region = nullptr;
+	Header = nullptr;
+	Records = nullptr;
+}
+
+void FViewportSyncPoseStreamWriter::BeginRecord(uint64 FrameNumber, double Time)
+{
+	if (Header == nullptr)
+	{
+		return;
+	}
+
+	CurrentRecord = &Records[Header->WriteCount % VIEWPORTSYNC_POSESTREAM_CAPACITY];
+
+	// Odd, anyone copying this slot out will throw the copy away
+	CurrentRecord->Sequence = CurrentRecord->Sequence + 1;
+	FPlatformMisc::MemoryBarrier();
+
+	CurrentRecord->FrameNumber = FrameNumber;
+	CurrentRecord->Time = Time;
+	CurrentRecord->NumViewports = 0;
+}
+
+FViewportSyncPoseStreamViewport* FViewportSyncPoseStreamWriter::AddViewport()
+{
+	if (CurrentRecord == nullptr || CurrentRecord->NumViewports >= VIEWPORTSYNC_POSESTREAM_MAX_VIEWPORTS)
+	{
+		return nullptr;
+	}
+
+	return &CurrentRecord->Viewports[CurrentRecord->NumViewports++];
+}
+
+void FViewportSyncPoseStreamWriter::EndRecord()
+{
+	if (CurrentRecord == nullptr)
+	{
+		return;
+	}
+
+	// Everything in the slot has to land before it reads as complete, and before the count says it's there
+	FPlatformMisc::MemoryBarrier();
+	CurrentRecord->Sequence = CurrentRecord->Sequence + 1;
+	FPlatformMisc::MemoryBarrier();
+	Header->WriteCount = Header->WriteCount + 1;
+
+	CurrentRecord = nullptr;
+}
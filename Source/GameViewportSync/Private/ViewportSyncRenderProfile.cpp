@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncRenderProfile.h"
+
+#include "EditorViewportClient.h"
+#include "SceneView.h"
+#include "UnrealClient.h"
+
+// Editor only primitives, turning these off also leaves nothing for a hit proxy pass to draw
+static const TCHAR* const EditorPrimitiveShowFlags[] =
+{
+	TEXT("SelectionOutline"),
+	TEXT("BillboardSprites"),
+	TEXT("ModeWidgets"),
+};
+
+FViewportSyncRenderProfile::FViewportSyncRenderProfile()
+	: bOverrideDynamicShadows(false)
+	, bDynamicShadows(true)
+	, bOverridePostProcessing(false)
+	, bPostProcessing(true)
+	, bOverrideTranslucency(false)
+	, bTranslucency(true)
+	, bOverrideParticles(false)
+	, bParticles(true)
+	, bOverrideEditorPrimitives(false)
+	, bEditorPrimitives(true)
+	, LODDistanceScale(1.0f)
+	, MaxDrawDistance(0.0f)
+{}
+
+FViewportSyncRenderProfile::FViewportSyncRenderProfile(FName InName)
+	: FViewportSyncRenderProfile()
+{
+	Name = InName;
+}
+
+bool FViewportSyncRenderProfile::HasOverrides() const
+{
+	return bOverrideDynamicShadows
+		|| bOverridePostProcessing
+		|| bOverrideTranslucency
+		|| bOverrideParticles
+		|| bOverrideEditorPrimitives
+		|| LODDistanceScale != 1.0f
+		|| MaxDrawDistance > 0.0f;
+}
+
+void FViewportSyncRenderProfile::Apply(FEditorViewportClient& ViewportClient, FViewportSyncRenderProfileRestoreState& OutRestoreState) const
+{
+	checkf(!OutRestoreState.bApplied, TEXT("Render profile applied twice, the first one would never be restored"));
+
+	const auto OverrideShowFlag = [&ViewportClient, &OutRestoreState](const TCHAR* ShowFlagName, bool bValue)
+	{
+		const int32 ShowFlagIndex = FEngineShowFlags::FindIndexByName(ShowFlagName);
+		if (ShowFlagIndex != INDEX_NONE)
+		{
+			OutRestoreState.ShowFlags.Emplace(ShowFlagIndex, ViewportClient.EngineShowFlags.GetSingleFlag(ShowFlagIndex));
+			ViewportClient.EngineShowFlags.SetSingleFlag(ShowFlagIndex, bValue);
+		}
+	};
+
+	if (bOverrideDynamicShadows)
+	{
+		OverrideShowFlag(TEXT("DynamicShadows"), bDynamicShadows);
+	}
+
+	if (bOverridePostProcessing)
+	{
+		OverrideShowFlag(TEXT("PostProcessing"), bPostProcessing);
+	}
+
+	if (bOverrideTranslucency)
+	{
+		OverrideShowFlag(TEXT("Translucency"), bTranslucency);
+	}
+
+	if (bOverrideParticles)
+	{
+		OverrideShowFlag(TEXT("Particles"), bParticles);
+	}
+
+	if (bOverrideEditorPrimitives)
+	{
+		for (const TCHAR* ShowFlagName : EditorPrimitiveShowFlags)
+		{
+			OverrideShowFlag(ShowFlagName, bEditorPrimitives);
+		}
+	}
+
+	OutRestoreState.bOverrodeFarClipPlane = MaxDrawDistance > 0.0f;
+	if (OutRestoreState.bOverrodeFarClipPlane)
+	{
+		OutRestoreState.FarClipPlaneOverride = ViewportClient.GetFarClipPlaneOverride();
+		ViewportClient.OverrideFarClipPlane(MaxDrawDistance);
+	}
+
+	OutRestoreState.bApplied = true;
+
+	ViewportClient.Invalidate();
+}
+
+TArray<FViewportSyncRenderProfile> FViewportSyncRenderProfile::GetDefaultProfiles()
+{
+	TArray<FViewportSyncRenderProfile> Profiles;
+
+	// Whatever the viewport was already showing
+	Profiles.Emplace(TEXT("Full"));
+
+	// Still looks like the game, minus the expensive bits a side view rarely needs
+	FViewportSyncRenderProfile& Lite = Profiles.Emplace_GetRef(TEXT("Lite"));
+	Lite.bOverrideDynamicShadows = true;
+	Lite.bDynamicShadows = false;
+	Lite.bOverrideParticles = true;
+	Lite.bParticles = false;
+	Lite.bOverrideEditorPrimitives = true;
+	Lite.bEditorPrimitives = false;
+	Lite.LODDistanceScale = 1.5f;
+	Lite.MaxDrawDistance = 100000.0f;
+
+	// Just enough to see where everything is
+	FViewportSyncRenderProfile& Overview = Profiles.Emplace_GetRef(TEXT("Overview"));
+	Overview.bOverrideDynamicShadows = true;
+	Overview.bDynamicShadows = false;
+	Overview.bOverridePostProcessing = true;
+	Overview.bPostProcessing = false;
+	Overview.bOverrideTranslucency = true;
+	Overview.bTranslucency = false;
+	Overview.bOverrideParticles = true;
+	Overview.bParticles = false;
+	Overview.bOverrideEditorPrimitives = true;
+	Overview.bEditorPrimitives = false;
+	Overview.LODDistanceScale = 3.0f;
+
+	return Profiles;
+}
+
+void FViewportSyncRenderProfileRestoreState::Restore(FEditorViewportClient& ViewportClient)
+{
+	if (!bApplied)
+	{
+		return;
+	}
+
+	// Backwards, in case a flag was overridden more than once
+	for (int32 Index = ShowFlags.Num() - 1; Index >= 0; --Index)
+	{
+		ViewportClient.EngineShowFlags.SetSingleFlag(ShowFlags[Index].Key, ShowFlags[Index].Value);
+	}
+
+	if (bOverrodeFarClipPlane)
+	{
+		ViewportClient.OverrideFarClipPlane(FarClipPlaneOverride);
+	}
+
+	ViewportClient.Invalidate();
+
+	Reset();
+}
+
+void FViewportSyncRenderProfileRestoreState::Reset()
+{
+	ShowFlags.Reset();
+	FarClipPlaneOverride = 0.0f;
+	bOverrodeFarClipPlane = false;
+	bApplied = false;
+}
+
+void FViewportSyncRenderProfileViewExtension::SetLODDistanceScale(const FViewport* Viewport, float LODDistanceScale)
+{
+	if (LODDistanceScale == 1.0f)
+	{
+		RemoveViewport(Viewport);
+	}
+	else
+	{
+		LODDistanceScales.Add(Viewport, LODDistanceScale);
+	}
+}
+
+void FViewportSyncRenderProfileViewExtension::RemoveViewport(const FViewport* Viewport)
+{
+	LODDistanceScales.Remove(Viewport);
+}
+
+void FViewportSyncRenderProfileViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView)
+{
+	if (const float* LODDistanceScale = LODDistanceScales.Find(InViewFamily.RenderTarget))
+	{
+		InView.LODDistanceFactor *= *LODDistanceScale;
+	}
+}
+
+bool FViewportSyncRenderProfileViewExtension::IsActiveThisFrame(FViewport* InViewport) const
+{
+	return InViewport != nullptr && LODDistanceScales.Contains(InViewport);
+}
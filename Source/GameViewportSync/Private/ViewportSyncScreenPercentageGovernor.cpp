@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncScreenPercentageGovernor.h"
+#include "ViewportSyncSettings.h"
+
+void FViewportSyncScreenPercentageGovernor::Reset(int32 InitialScreenPercentage)
+{
+	SmoothedFrameTime = 0.0f;
+	ScreenPercentage = InitialScreenPercentage;
+	FramesSinceLastChange = 0;
+}
+
+bool FViewportSyncScreenPercentageGovernor::Tick(float FrameTime, const UViewportSyncSettings& Settings)
+{
+	const int32 MinScreenPercentage = FMath::Min(Settings.AdaptiveMinScreenPercentage, Settings.AdaptiveMaxScreenPercentage);
+	const int32 MaxScreenPercentage = Settings.AdaptiveMaxScreenPercentage;
+
+	SmoothedFrameTime = SmoothedFrameTime > 0.0f ? FMath::Lerp(SmoothedFrameTime, FrameTime, 0.1f) : FrameTime;
+	++FramesSinceLastChange;
+
+	const int32 PreviousScreenPercentage = ScreenPercentage;
+	ScreenPercentage = FMath::Clamp(ScreenPercentage, MinScreenPercentage, MaxScreenPercentage);
+
+	if (Settings.AdaptiveTargetFrameRate > 0.0f && FramesSinceLastChange >= Settings.AdaptiveCooldownFrames)
+	{
+		const float TargetFrameTime = 1.0f / Settings.AdaptiveTargetFrameRate;
+
+		if (SmoothedFrameTime > TargetFrameTime * (1.0f + Settings.AdaptiveHysteresis))
+		{
+			ScreenPercentage = FMath::Max(ScreenPercentage - Settings.AdaptiveScreenPercentageStep, MinScreenPercentage);
+		}
+		else if (SmoothedFrameTime < TargetFrameTime * (1.0f - Settings.AdaptiveHysteresis))
+		{
+			ScreenPercentage = FMath::Min(ScreenPercentage + Settings.AdaptiveScreenPercentageStep, MaxScreenPercentage);
+		}
+	}
+
+	if (ScreenPercentage != PreviousScreenPercentage)
+	{
+		FramesSinceLastChange = 0;
+		return true;
+	}
+	return false;
+}
@@ -1,4 +1,43 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 
-#include "ViewportSyncSettings.h"
\ No newline at end of file
+#include "ViewportSyncSettings.h"
+
+const FViewportSyncRenderProfile* UViewportSyncSettings::FindRenderProfile(FName ProfileName) const
+{
+	return RenderProfiles.FindByPredicate([ProfileName](const FViewportSyncRenderProfile& Profile)
+	{
+		return Profile.Name == ProfileName;
+	});
+}
+
+static_assert(static_cast<uint8>(EViewportSyncFollowFilterSetting::OneEuro) == static_cast<uint8>(EViewportSyncFollowFilter::OneEuro), "EViewportSyncFollowFilterSetting is out of step with EViewportSyncFollowFilter");
+
+FViewportSyncFollowFilterSettings UViewportSyncSettings::MakeFollowFilterSettings() const
+{
+	FViewportSyncFollowFilterSettings FilterSettings;
+	FilterSettings.Filter			= static_cast<EViewportSyncFollowFilter>(FollowFilter);
+	FilterSettings.ConstantSpeed	= FollowActorSmoothSpeed;
+	FilterSettings.SmoothTime		= FollowSmoothTime;
+	FilterSettings.OneEuroMinCutoff	= FollowOneEuroMinCutoff;
+	FilterSettings.OneEuroBeta		= FollowOneEuroBeta;
+	FilterSettings.PredictionTime	= FollowPredictionTime;
+	return FilterSettings;
+}
+
+FViewportSyncPlayerMirror UViewportSyncSettings::MakePlayerMirror(int32 PlayerIndex) const
+{
+	FViewportSyncPlayerMirror Mirror(PlayerIndex);
+	Mirror.FOVOverride = MirrorFOVOverride;
+	Mirror.LocationOffset = MirrorLocationOffset;
+	Mirror.RotationOffset = MirrorRotationOffset;
+	return Mirror;
+}
+
+FViewportSyncAutoFollowRule UViewportSyncSettings::MakeNearestAutoFollowRule(TSubclassOf<AActor> ActorClass) const
+{
+	FViewportSyncAutoFollowRule Rule = FViewportSyncAutoFollowRule::Nearest(ActorClass);
+	Rule.Hysteresis = AutoFollowHysteresis;
+	Rule.MinRetargetTime = AutoFollowMinRetargetTime;
+	return Rule;
+}
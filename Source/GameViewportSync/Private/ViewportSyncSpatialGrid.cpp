@@ -0,0 +1,248 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncSpatialGrid.h"
+
+// UE Includes
+#include "GameFramework/Actor.h"
+
+FViewportSyncSpatialGrid::FViewportSyncSpatialGrid(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.0f))
+	, InvCellSize(1.0f / FMath::Max(InCellSize, 1.0f))
+	, MinCell(MAX_int32, MAX_int32)
+	, MaxCell(MIN_int32, MIN_int32)
+	, RefreshCursor(0)
+{}
+
+void FViewportSyncSpatialGrid::Add(AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	const int32 EntryIndex = Entries.AddDefaulted();
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Actor = Actor;
+	Entry.Location = Actor->GetActorLocation();
+
+	AddToCell(EntryIndex, GetCell(Entry.Location));
+}
+
+void FViewportSyncSpatialGrid::Refresh(int32 MaxActors)
+{
+	const int32 NumToRefresh = MaxActors > 0 ? FMath::Min(MaxActors, Entries.Num()) : Entries.Num();
+
+	for (int32 Count = 0; Count < NumToRefresh && Entries.Num() > 0; ++Count)
+	{
+		if (RefreshCursor >= Entries.Num())
+		{
+			RefreshCursor = 0;
+		}
+
+		FEntry& Entry = Entries[RefreshCursor];
+		const AActor* Actor = Entry.Actor.Get();
+		if (Actor == nullptr)
+		{
+			// The last entry is swapped in here, it gets looked at next
+			RemoveEntry(RefreshCursor);
+			continue;
+		}
+
+		Entry.Location = Actor->GetActorLocation();
+
+		const FIntPoint Cell = GetCell(Entry.Location);
+		if (GetCellKey(Cell) != Entry.CellKey)
+		{
+			RemoveFromCell(RefreshCursor);
+			AddToCell(RefreshCursor, Cell);
+		}
+
+		++RefreshCursor;
+	}
+}
+
+AActor* FViewportSyncSpatialGrid::FindNearest(const FVector& Origin, float MaxDistance, float& OutDistanceSquared) const
+{
+	AActor* Nearest = nullptr;
+	float NearestDistanceSquared = MaxDistance > 0.0f ? FMath::Square(MaxDistance) : MAX_flt;
+
+	ForEachOutward(Origin, MaxDistance, [&Nearest, &NearestDistanceSquared](float RingDistance)
+	{
+		return Nearest == nullptr || FMath::Square(RingDistance) <= NearestDistanceSquared;
+	},
+	[&Origin, &Nearest, &NearestDistanceSquared](AActor* Actor, const FVector& Location)
+	{
+		const float DistanceSquared = FVector::DistSquared(Origin, Location);
+		if (DistanceSquared < NearestDistanceSquared)
+		{
+			Nearest = Actor;
+			NearestDistanceSquared = DistanceSquared;
+		}
+	});
+
+	OutDistanceSquared = NearestDistanceSquared;
+	return Nearest;
+}
+
+void FViewportSyncSpatialGrid::ForEachOutward(const FVector& Origin, float MaxDistance, TFunctionRef<bool(float RingDistance)> ShouldContinue, TFunctionRef<void(AActor* Actor, const FVector& Location)> Callback) const
+{
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	const FIntPoint Center = GetCell(Origin);
+	const float MaxDistanceSquared = MaxDistance > 0.0f ? FMath::Square(MaxDistance) : MAX_flt;
+
+	// Far enough out to have covered every cell anything has been in
+	const int32 MaxRing = MaxDistance > 0.0f
+		? FMath::CeilToInt(MaxDistance * InvCellSize) + 1
+		: FMath::Max(FMath::Max(FMath::Abs(Center.X - MinCell.X), FMath::Abs(MaxCell.X - Center.X)), FMath::Max(FMath::Abs(Center.Y - MinCell.Y), FMath::Abs(MaxCell.Y - Center.Y)));
+
+	const auto VisitCell = [this, &Origin, MaxDistanceSquared, &Callback](FIntPoint Cell)
+	{
+		ForEachInCell(Cell, [&Origin, MaxDistanceSquared, &Callback](AActor* Actor, const FVector& Location)
+		{
+			if (FVector::DistSquared(Origin, Location) <= MaxDistanceSquared)
+			{
+				Callback(Actor, Location);
+			}
+		});
+	};
+
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		// Everything in this ring is at least Ring - 1 cells away from Origin
+		if (!ShouldContinue(FMath::Max(Ring - 1, 0) * CellSize))
+		{
+			break;
+		}
+
+		if (Ring == 0)
+		{
+			VisitCell(Center);
+			continue;
+		}
+
+		for (int32 X = -Ring; X <= Ring; ++X)
+		{
+			VisitCell(FIntPoint(Center.X + X, Center.Y - Ring));
+			VisitCell(FIntPoint(Center.X + X, Center.Y + Ring));
+		}
+
+		for (int32 Y = -Ring + 1; Y < Ring; ++Y)
+		{
+			VisitCell(FIntPoint(Center.X - Ring, Center.Y + Y));
+			VisitCell(FIntPoint(Center.X + Ring, Center.Y + Y));
+		}
+	}
+}
+
+void FViewportSyncSpatialGrid::ForEachInRadius(const FVector& Origin, float Radius, TFunctionRef<void(AActor* Actor, const FVector& Location)> Callback) const
+{
+	if (Radius <= 0.0f)
+	{
+		for (const FEntry& Entry : Entries)
+		{
+			if (AActor* Actor = Entry.Actor.Get())
+			{
+				Callback(Actor, Entry.Location);
+			}
+		}
+		return;
+	}
+
+	const float RadiusSquared = FMath::Square(Radius);
+	const FIntPoint First = GetCell(Origin - FVector(Radius));
+	const FIntPoint Last = GetCell(Origin + FVector(Radius));
+
+	for (int32 X = First.X; X <= Last.X; ++X)
+	{
+		for (int32 Y = First.Y; Y <= Last.Y; ++Y)
+		{
+			ForEachInCell(FIntPoint(X, Y), [&Origin, RadiusSquared, &Callback](AActor* Actor, const FVector& Location)
+			{
+				if (FVector::DistSquared(Origin, Location) <= RadiusSquared)
+				{
+					Callback(Actor, Location);
+				}
+			});
+		}
+	}
+}
+
+void FViewportSyncSpatialGrid::Reset()
+{
+	Entries.Reset();
+	Cells.Reset();
+	MinCell = FIntPoint(MAX_int32, MAX_int32);
+	MaxCell = FIntPoint(MIN_int32, MIN_int32);
+	RefreshCursor = 0;
+}
+
+FIntPoint FViewportSyncSpatialGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X * InvCellSize), FMath::FloorToInt(Location.Y * InvCellSize));
+}
+
+uint64 FViewportSyncSpatialGrid::GetCellKey(FIntPoint Cell)
+{
+	return (static_cast<uint64>(static_cast<uint32>(Cell.X)) << 32) | static_cast<uint32>(Cell.Y);
+}
+
+void FViewportSyncSpatialGrid::AddToCell(int32 EntryIndex, FIntPoint Cell)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.CellKey = GetCellKey(Cell);
+
+	TArray<int32>& CellEntries = Cells.FindOrAdd(Entry.CellKey);
+	Entry.IndexInCell = CellEntries.Add(EntryIndex);
+
+	MinCell = FIntPoint(FMath::Min(MinCell.X, Cell.X), FMath::Min(MinCell.Y, Cell.Y));
+	MaxCell = FIntPoint(FMath::Max(MaxCell.X, Cell.X), FMath::Max(MaxCell.Y, Cell.Y));
+}
+
+void FViewportSyncSpatialGrid::RemoveFromCell(int32 EntryIndex)
+{
+	const FEntry& Entry = Entries[EntryIndex];
+
+	TArray<int32>& CellEntries = Cells.FindChecked(Entry.CellKey);
+	CellEntries.RemoveAtSwap(Entry.IndexInCell, 1, false);
+
+	// Whoever got swapped into our slot needs to know where it is now
+	if (CellEntries.IsValidIndex(Entry.IndexInCell))
+	{
+		Entries[CellEntries[Entry.IndexInCell]].IndexInCell = Entry.IndexInCell;
+	}
+}
+
+void FViewportSyncSpatialGrid::RemoveEntry(int32 EntryIndex)
+{
+	RemoveFromCell(EntryIndex);
+
+	const int32 LastIndex = Entries.Num() - 1;
+	if (EntryIndex != LastIndex)
+	{
+		// The last entry moves into this slot, point its cell at the new index
+		const FEntry& LastEntry = Entries[LastIndex];
+		Cells.FindChecked(LastEntry.CellKey)[LastEntry.IndexInCell] = EntryIndex;
+	}
+
+	Entries.RemoveAtSwap(EntryIndex, 1, false);
+}
+
+template<typename CallbackType>
+void FViewportSyncSpatialGrid::ForEachInCell(FIntPoint Cell, CallbackType&& Callback) const
+{
+	if (const TArray<int32>* CellEntries = Cells.Find(GetCellKey(Cell)))
+	{
+		for (const int32 EntryIndex : *CellEntries)
+		{
+			const FEntry& Entry = Entries[EntryIndex];
+			if (AActor* Actor = Entry.Actor.Get())
+			{
+				Callback(Actor, Entry.Location);
+			}
+		}
+	}
+}
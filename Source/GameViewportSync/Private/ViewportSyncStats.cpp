@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncStats.h"
+
+DEFINE_STAT(STAT_ViewportSync_PostEditorTick);
+DEFINE_STAT(STAT_ViewportSync_WorldPostActorTick);
+DEFINE_STAT(STAT_ViewportSync_ApplyViewportSettings);
+DEFINE_STAT(STAT_ViewportSync_RevertViewportSettings);
+DEFINE_STAT(STAT_ViewportSync_ViewportClientListChanged);
+DEFINE_STAT(STAT_ViewportSync_ResolveFollowActor);
+DEFINE_STAT(STAT_ViewportSync_FrameFollowGroup);
+DEFINE_STAT(STAT_ViewportSync_AutoFollow);
+DEFINE_STAT(STAT_ViewportSync_ScheduledRedraws);
+DEFINE_STAT(STAT_ViewportSync_PIEStart);
+DEFINE_STAT(STAT_ViewportSync_StagedPIEStart);
+
+DEFINE_STAT(STAT_ViewportSync_SyncedViewports);
+DEFINE_STAT(STAT_ViewportSync_SuspendedViewports);
+DEFINE_STAT(STAT_ViewportSync_ThrottledViewports);
+DEFINE_STAT(STAT_ViewportSync_IdleViewports);
+DEFINE_STAT(STAT_ViewportSync_StreamingViewsAdded);
+DEFINE_STAT(STAT_ViewportSync_StreamingViewsRemoved);
+DEFINE_STAT(STAT_ViewportSync_FollowTargetsResolved);
+DEFINE_STAT(STAT_ViewportSync_FollowTargetsPending);
+DEFINE_STAT(STAT_ViewportSync_FollowGroupMembers);
+DEFINE_STAT(STAT_ViewportSync_QueuedCommands);
+DEFINE_STAT(STAT_ViewportSync_MaxFollowLag);
+
+DEFINE_STAT(STAT_ViewportSync_LastPIEStartMs);
+DEFINE_STAT(STAT_ViewportSync_LastPIEStartPluginMs);
+DEFINE_STAT(STAT_ViewportSync_LastPIEStartStagedMs);
+DEFINE_STAT(STAT_ViewportSync_LastPIEStartStagedFrames);
+
+CSV_DEFINE_CATEGORY(ViewportSync, true);
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/*
+ * Stats for the Viewport Sync plugin, view with "stat ViewportSync"
+ * Everything here is mirrored in the ViewportSync CSV category for -csvprofile captures
+ */
+DECLARE_STATS_GROUP(TEXT("ViewportSync"), STATGROUP_ViewportSync, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Post Editor Tick"), STAT_ViewportSync_PostEditorTick, STATGROUP_ViewportSync, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Post Actor Tick"), STAT_ViewportSync_WorldPostActorTick, STATGROUP_ViewportSync, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Viewport Settings"), STAT_ViewportSync_ApplyViewportSettings, STATGROUP_ViewportSync, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Revert Viewport Settings"), STAT_ViewportSync_RevertViewportSettings, STATGROUP_ViewportSync, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Viewport Client List Changed"), STAT_ViewportSync_ViewportClientListChanged, STATGROUP_ViewportSync, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resolve Follow Actor"), STAT_ViewportSync_ResolveFollowActor, STATGROUP_ViewportSync, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Frame Follow Group"), STAT_ViewportSync_FrameFollowGroup, STATGROUP_ViewportSync, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Auto Follow"), STAT_ViewportSync_AutoFollow, STATGROUP_ViewportSync, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scheduled Redraws"), STAT_ViewportSync_ScheduledRedraws, STATGROUP_ViewportSync, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PIE Start"), STAT_ViewportSync_PIEStart, STATGROUP_ViewportSync, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Staged PIE Start"), STAT_ViewportSync_StagedPIEStart, STATGROUP_ViewportSync, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Synced Viewports"), STAT_ViewportSync_SyncedViewports, STATGROUP_ViewportSync, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Suspended Viewports"), STAT_ViewportSync_SuspendedViewports, STATGROUP_ViewportSync, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Throttled Viewports"), STAT_ViewportSync_ThrottledViewports, STATGROUP_ViewportSync, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Idle Viewports"), STAT_ViewportSync_IdleViewports, STATGROUP_ViewportSync, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Streaming Views Added"), STAT_ViewportSync_StreamingViewsAdded, STATGROUP_ViewportSync, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Streaming Views Removed"), STAT_ViewportSync_StreamingViewsRemoved, STATGROUP_ViewportSync, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Follow Targets Resolved"), STAT_ViewportSync_FollowTargetsResolved, STATGROUP_ViewportSync, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Follow Targets Pending"), STAT_ViewportSync_FollowTargetsPending, STATGROUP_ViewportSync, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Follow Group Members"), STAT_ViewportSync_FollowGroupMembers, STATGROUP_ViewportSync, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Queued Commands"), STAT_ViewportSync_QueuedCommands, STATGROUP_ViewportSync, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Max Follow Lag"), STAT_ViewportSync_MaxFollowLag, STATGROUP_ViewportSync, );
+
+// Results of the last PIE start, they stay up until the next one
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last PIE Start (ms)"), STAT_ViewportSync_LastPIEStartMs, STATGROUP_ViewportSync, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last PIE Start Plugin Share (ms)"), STAT_ViewportSync_LastPIEStartPluginMs, STATGROUP_ViewportSync, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last PIE Start Staged (ms)"), STAT_ViewportSync_LastPIEStartStagedMs, STATGROUP_ViewportSync, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Last PIE Start Staged Frames"), STAT_ViewportSync_LastPIEStartStagedFrames, STATGROUP_ViewportSync, );
+
+CSV_DECLARE_CATEGORY_EXTERN(ViewportSync);
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncStreaming.h"
+
+#include "ContentStreaming.h"
+#include "EditorViewportClient.h"
+#include "Engine/World.h"
+#include "UnrealClient.h"
+
+#define LOCTEXT_NAMESPACE "ViewportSyncStreaming"
+
+// Rendered view locations are copied straight from the view, this only absorbs float noise
+static const float RenderedViewLocationTolerance = 0.1f;
+
+void FViewportSyncStreaming::AddView(const FEditorViewportClient& ViewportClient, const FVector& ViewLocation, float BoostFactor)
+{
+	if (ViewportClient.Viewport == nullptr)
+	{
+		return;
+	}
+
+	// Same screen size terms the game viewport gives the streamer
+	const float ScreenSize = ViewportClient.Viewport->GetSizeXY().X;
+	const float FOVScreenSize = ScreenSize / FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(ViewportClient.ViewFOV, 1.0f, 179.0f) * 0.5f));
+
+	IStreamingManager::Get().AddViewInformation(ViewLocation, ScreenSize, FOVScreenSize, BoostFactor);
+}
+
+bool FViewportSyncStreaming::RemoveRenderedViewLocation(UWorld* World, const FVector& ViewLocation)
+{
+	if (World == nullptr)
+	{
+		return false;
+	}
+
+	const int32 Index = World->ViewLocationsRenderedLastFrame.IndexOfByPredicate([&ViewLocation](const FVector& RenderedViewLocation)
+	{
+		return RenderedViewLocation.Equals(ViewLocation, RenderedViewLocationTolerance);
+	});
+
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	World->ViewLocationsRenderedLastFrame.RemoveAtSwap(Index, 1, false);
+	return true;
+}
+
+FText FViewportSyncStreaming::GetDisplayText(EViewportSyncStreamingPolicy Policy)
+{
+	switch (Policy)
+	{
+	case EViewportSyncStreamingPolicy::Full:
+		return LOCTEXT("Full", "Full");
+	case EViewportSyncStreamingPolicy::Reduced:
+		return LOCTEXT("Reduced", "Reduced");
+	case EViewportSyncStreamingPolicy::None:
+		return LOCTEXT("None", "None");
+	default:
+		return FText::GetEmpty();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,537 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncTrajectoryRecorder.h"
+
+// UE Includes
+#include "Algo/UpperBound.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogViewportSyncTrajectory, Log, All);
+
+namespace ViewportSyncTrajectory
+{
+	static const uint32 FileMagic = 0x52545356; // "VSTR"
+	static const uint32 FileVersion = 1;
+
+	static const int32 BlockSize = 16 * 1024;
+
+	// Quantization steps
+	static const float LocationScale = 8.0f;
+	static const double TicksPerSecond = 10000.0;
+
+	// Worst case encoded sizes, used to decide whether a frame still fits in the current block
+	static const int32 MaxFrameHeaderBytes = 16;
+	static const int32 MaxSampleBytes = 44;
+
+	enum ESampleFlags : uint8
+	{
+		SampleFlag_HasTarget = 1 << 0
+	};
+
+	static FORCEINLINE uint32 ZigZag(int32 Value)
+	{
+		return (uint32(Value) << 1) ^ uint32(Value >> 31);
+	}
+
+	static FORCEINLINE int32 UnZigZag(uint32 Value)
+	{
+		return int32(Value >> 1) ^ -int32(Value & 1);
+	}
+
+	static FORCEINLINE void WriteVarint(uint8*& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			*Out++ = uint8(Value) | 0x80;
+			Value >>= 7;
+		}
+		*Out++ = uint8(Value);
+	}
+
+	static bool ReadVarint(const uint8*& In, const uint8* End, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (In >= End)
+			{
+				return false;
+			}
+			const uint8 Byte = *In++;
+			OutValue |= uint32(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static FORCEINLINE int32 QuantizeLocation(float Value)
+	{
+		return FMath::RoundToInt(FMath::Clamp(Value * LocationScale, -2147483520.0f, 2147483520.0f));
+	}
+
+	static FORCEINLINE float DequantizeLocation(int32 Value)
+	{
+		return Value / LocationScale;
+	}
+}
+
+double FViewportSyncTrajectory::GetDuration() const
+{
+	double Duration = 0.0;
+	for (const FViewportSyncTrajectoryTrack& Track : Tracks)
+	{
+		if (Track.Samples.Num() > 0)
+		{
+			Duration = FMath::Max(Duration, Track.Samples.Last().Time);
+		}
+	}
+	return Duration;
+}
+
+bool FViewportSyncTrajectory::Evaluate(const FViewportSyncTrajectoryTrack& Track, double Time, FViewportSyncTrajectorySample& OutSample) const
+{
+	const TArray<FViewportSyncTrajectorySample>& Samples = Track.Samples;
+	if (Samples.Num() == 0)
+	{
+		return false;
+	}
+
+	const int32 NextIndex = Algo::UpperBound(Samples, Time, [](double InTime, const FViewportSyncTrajectorySample& Sample) { return InTime < Sample.Time; });
+	if (NextIndex == 0 || NextIndex == Samples.Num())
+	{
+		OutSample = Samples[FMath::Clamp(NextIndex, 0, Samples.Num() - 1)];
+		return true;
+	}
+
+	const FViewportSyncTrajectorySample& Previous = Samples[NextIndex - 1];
+	const FViewportSyncTrajectorySample& Next = Samples[NextIndex];
+	const float Alpha = Next.Time > Previous.Time ? float((Time - Previous.Time) / (Next.Time - Previous.Time)) : 0.0f;
+
+	OutSample.Time = Time;
+	OutSample.CameraLocation = FMath::Lerp(Previous.CameraLocation, Next.CameraLocation, Alpha);
+	OutSample.CameraRotation = FMath::Lerp(Previous.CameraRotation, Next.CameraRotation, Alpha);
+	OutSample.bHasTarget = Previous.bHasTarget && Next.bHasTarget;
+	OutSample.TargetLocation = OutSample.bHasTarget ? FMath::Lerp(Previous.TargetLocation, Next.TargetLocation, Alpha) : Previous.TargetLocation;
+	return true;
+}
+
+const FViewportSyncTrajectoryTrack* FViewportSyncTrajectory::FindTrack(FName Name) const
+{
+	return Tracks.FindByPredicate([Name](const FViewportSyncTrajectoryTrack& Track) { return Track.Name == Name; });
+}
+
+FViewportSyncTrajectoryRecorder::FViewportSyncTrajectoryRecorder()
+	: NumBlocks(0)
+	, CurrentBlock(INDEX_NONE)
+	, NextSequence(1)
+	, SessionId(0)
+	, SessionStartTime(0.0)
+	, LastFrameTicks(0)
+	, TracksInBlock(0)
+	, NumFrameSamples(0)
+	, FrameTime(0.0)
+{
+	FMemory::Memzero(PreviousSamples);
+	FMemory::Memzero(FrameSamples);
+}
+
+void FViewportSyncTrajectoryRecorder::Initialize(int32 BufferSizeBytes)
+{
+	using namespace ViewportSyncTrajectory;
+
+	const int32 NewNumBlocks = FMath::Max(BufferSizeBytes, 0) / BlockSize;
+	if (NewNumBlocks == NumBlocks)
+	{
+		return;
+	}
+
+	NumBlocks = NewNumBlocks;
+	BlockData.Empty(NumBlocks * BlockSize);
+	BlockData.SetNumZeroed(NumBlocks * BlockSize);
+	Blocks.Empty(NumBlocks);
+	Blocks.SetNumZeroed(NumBlocks);
+
+	CurrentBlock = INDEX_NONE;
+	NumFrameSamples = 0;
+}
+
+void FViewportSyncTrajectoryRecorder::BeginSession()
+{
+	++SessionId;
+	SessionStartTime = FPlatformTime::Seconds();
+
+	// Sessions never share a block, EndFrame starts a new one when it sees the session changed
+	NumFrameSamples = 0;
+}
+
+void FViewportSyncTrajectoryRecorder::SetTrackName(uint16 TrackId, FName Name)
+{
+	if (TrackId < MaxTracks)
+	{
+		TrackNames[TrackId] = Name;
+	}
+}
+
+void FViewportSyncTrajectoryRecorder::BeginFrame()
+{
+	NumFrameSamples = 0;
+	FrameTime = FPlatformTime::Seconds() - SessionStartTime;
+}
+
+void FViewportSyncTrajectoryRecorder::AddSample(uint16 TrackId, const FVector& CameraLocation, const FRotator& CameraRotation, const FVector* TargetLocation)
+{
+	using namespace ViewportSyncTrajectory;
+
+	if (TrackId >= MaxTracks || NumFrameSamples >= MaxTracks || !IsEnabled())
+	{
+		return;
+	}
+
+	FQuantizedSample& Sample = FrameSamples[NumFrameSamples++];
+	Sample.TrackId = TrackId;
+
+	Sample.CameraLocation[0] = QuantizeLocation(CameraLocation.X);
+	Sample.CameraLocation[1] = QuantizeLocation(CameraLocation.Y);
+	Sample.CameraLocation[2] = QuantizeLocation(CameraLocation.Z);
+
+	Sample.CameraRotation[0] = FRotator::CompressAxisToShort(CameraRotation.Pitch);
+	Sample.CameraRotation[1] = FRotator::CompressAxisToShort(CameraRotation.Yaw);
+	Sample.CameraRotation[2] = FRotator::CompressAxisToShort(CameraRotation.Roll);
+
+	Sample.bHasTarget = TargetLocation != nullptr;
+	if (Sample.bHasTarget)
+	{
+		Sample.TargetLocation[0] = QuantizeLocation(TargetLocation->X);
+		Sample.TargetLocation[1] = QuantizeLocation(TargetLocation->Y);
+		Sample.TargetLocation[2] = QuantizeLocation(TargetLocation->Z);
+	}
+}
+
+void FViewportSyncTrajectoryRecorder::EndFrame()
+{
+	using namespace ViewportSyncTrajectory;
+
+	if (NumFrameSamples == 0 || SessionId == 0 || !IsEnabled())
+	{
+		return;
+	}
+
+	const int32 WorstCaseBytes = MaxFrameHeaderBytes + NumFrameSamples * MaxSampleBytes;
+	if (CurrentBlock == INDEX_NONE || Blocks[CurrentBlock].SessionId != SessionId || Blocks[CurrentBlock].UsedBytes + WorstCaseBytes > BlockSize)
+	{
+		StartBlock(FrameTime);
+	}
+
+	FBlockInfo& Block = Blocks[CurrentBlock];
+	uint8* const BlockStart = BlockData.GetData() + CurrentBlock * BlockSize + Block.UsedBytes;
+	uint8* Out = BlockStart;
+
+	const int64 FrameTicks = FMath::Max((int64)FMath::RoundToDouble((FrameTime - Block.BaseTime) * TicksPerSecond), LastFrameTicks);
+	WriteVarint(Out, uint32(FrameTicks - LastFrameTicks));
+	WriteVarint(Out, uint32(NumFrameSamples));
+	LastFrameTicks = FrameTicks;
+
+	for (int32 SampleIndex = 0; SampleIndex < NumFrameSamples; ++SampleIndex)
+	{
+		const FQuantizedSample& Sample = FrameSamples[SampleIndex];
+		const uint32 TrackBit = 1u << Sample.TrackId;
+
+		// First sample of a track in a block is against zero
+		FQuantizedSample& Previous = PreviousSamples[Sample.TrackId];
+		if ((TracksInBlock & TrackBit) == 0)
+		{
+			FMemory::Memzero(Previous);
+			TracksInBlock |= TrackBit;
+		}
+
+		WriteVarint(Out, Sample.TrackId);
+		*Out++ = Sample.bHasTarget ? SampleFlag_HasTarget : 0;
+
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			WriteVarint(Out, ZigZag(Sample.CameraLocation[Axis] - Previous.CameraLocation[Axis]));
+		}
+
+		// Rotations wrap, so the shortest way round always fits in 16 bits
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			WriteVarint(Out, ZigZag(int16(uint16(Sample.CameraRotation[Axis] - Previous.CameraRotation[Axis]))));
+		}
+
+		if (Sample.bHasTarget)
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				WriteVarint(Out, ZigZag(Sample.TargetLocation[Axis] - Previous.TargetLocation[Axis]));
+			}
+			FMemory::Memcpy(Previous.TargetLocation, Sample.TargetLocation, sizeof(Sample.TargetLocation));
+		}
+
+		FMemory::Memcpy(Previous.CameraLocation, Sample.CameraLocation, sizeof(Sample.CameraLocation));
+		FMemory::Memcpy(Previous.CameraRotation, Sample.CameraRotation, sizeof(Sample.CameraRotation));
+	}
+
+	Block.UsedBytes += int32(Out - BlockStart);
+	NumFrameSamples = 0;
+}
+
+void FViewportSyncTrajectoryRecorder::StartBlock(double Time)
+{
+	CurrentBlock = (CurrentBlock + 1) % NumBlocks;
+
+	FBlockInfo& Block = Blocks[CurrentBlock];
+	Block.Sequence = NextSequence++;
+	Block.SessionId = SessionId;
+	Block.BaseTime = Time;
+	Block.UsedBytes = 0;
+
+	LastFrameTicks = 0;
+	TracksInBlock = 0;
+}
+
+int32 FViewportSyncTrajectoryRecorder::GetUsedBytes() const
+{
+	int32 UsedBytes = 0;
+	for (const FBlockInfo& Block : Blocks)
+	{
+		UsedBytes += Block.UsedBytes;
+	}
+	return UsedBytes;
+}
+
+void FViewportSyncTrajectoryRecorder::Serialize(TArray<uint8>& OutBytes) const
+{
+	using namespace ViewportSyncTrajectory;
+
+	TArray<int32> BlockOrder;
+	for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+	{
+		if (Blocks[BlockIndex].Sequence != 0 && Blocks[BlockIndex].UsedBytes > 0)
+		{
+			BlockOrder.Add(BlockIndex);
+		}
+	}
+	BlockOrder.Sort([this](int32 A, int32 B) { return Blocks[A].Sequence < Blocks[B].Sequence; });
+
+	FMemoryWriter Writer(OutBytes);
+
+	uint32 Magic = FileMagic;
+	uint32 Version = FileVersion;
+	Writer << Magic << Version;
+
+	int32 NumNamedTracks = 0;
+	for (const FName& TrackName : TrackNames)
+	{
+		NumNamedTracks += TrackName.IsNone() ? 0 : 1;
+	}
+	Writer << NumNamedTracks;
+
+	for (uint16 TrackId = 0; TrackId < MaxTracks; ++TrackId)
+	{
+		if (!TrackNames[TrackId].IsNone())
+		{
+			FString TrackName = TrackNames[TrackId].ToString();
+			Writer << TrackId << TrackName;
+		}
+	}
+
+	int32 NumWrittenBlocks = BlockOrder.Num();
+	Writer << NumWrittenBlocks;
+
+	for (int32 BlockIndex : BlockOrder)
+	{
+		FBlockInfo Block = Blocks[BlockIndex];
+		Writer << Block.Sequence << Block.SessionId << Block.BaseTime << Block.UsedBytes;
+		Writer.Serialize(const_cast<uint8*>(BlockData.GetData() + BlockIndex * BlockSize), Block.UsedBytes);
+	}
+}
+
+bool FViewportSyncTrajectoryRecorder::DecodeBytes(const TArray<uint8>& Bytes, FViewportSyncTrajectory& OutTrajectory)
+{
+	using namespace ViewportSyncTrajectory;
+
+	OutTrajectory.Reset();
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		UE_LOG(LogViewportSyncTrajectory, Warning, TEXT("Not a viewport trajectory recording (or an unsupported version)"));
+		return false;
+	}
+
+	FName FileTrackNames[MaxTracks];
+
+	int32 NumNamedTracks = 0;
+	Reader << NumNamedTracks;
+	for (int32 Index = 0; Index < NumNamedTracks && !Reader.IsError(); ++Index)
+	{
+		uint16 TrackId = 0;
+		FString TrackName;
+		Reader << TrackId << TrackName;
+		if (TrackId < MaxTracks)
+		{
+			FileTrackNames[TrackId] = *TrackName;
+		}
+	}
+
+	struct FReadBlock
+	{
+		FBlockInfo Info;
+		int32 Offset;
+	};
+
+	TArray<FReadBlock> ReadBlocks;
+
+	int32 NumReadBlocks = 0;
+	Reader << NumReadBlocks;
+	for (int32 Index = 0; Index < NumReadBlocks && !Reader.IsError(); ++Index)
+	{
+		FReadBlock& ReadBlock = ReadBlocks.AddDefaulted_GetRef();
+		Reader << ReadBlock.Info.Sequence << ReadBlock.Info.SessionId << ReadBlock.Info.BaseTime << ReadBlock.Info.UsedBytes;
+		ReadBlock.Offset = int32(Reader.Tell());
+
+		if (ReadBlock.Info.UsedBytes < 0 || ReadBlock.Offset + ReadBlock.Info.UsedBytes > Bytes.Num())
+		{
+			Reader.SetError();
+			break;
+		}
+		Reader.Seek(ReadBlock.Offset + ReadBlock.Info.UsedBytes);
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogViewportSyncTrajectory, Warning, TEXT("Viewport trajectory recording is truncated"));
+		return false;
+	}
+
+	// Only the latest session, earlier ones are usually partly overwritten anyway
+	for (const FReadBlock& ReadBlock : ReadBlocks)
+	{
+		OutTrajectory.SessionId = FMath::Max(OutTrajectory.SessionId, ReadBlock.Info.SessionId);
+	}
+
+	for (const FReadBlock& ReadBlock : ReadBlocks)
+	{
+		if (ReadBlock.Info.SessionId != OutTrajectory.SessionId)
+		{
+			continue;
+		}
+
+		const uint8* In = Bytes.GetData() + ReadBlock.Offset;
+		const uint8* const End = In + ReadBlock.Info.UsedBytes;
+
+		FQuantizedSample Previous[MaxTracks];
+		uint32 TracksSeen = 0;
+		int64 FrameTicks = 0;
+
+		while (In < End)
+		{
+			uint32 TickDelta, NumSamples;
+			if (!ReadVarint(In, End, TickDelta) || !ReadVarint(In, End, NumSamples))
+			{
+				return false;
+			}
+			FrameTicks += TickDelta;
+
+			const double Time = ReadBlock.Info.BaseTime + FrameTicks / TicksPerSecond;
+
+			for (uint32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+			{
+				uint32 TrackId;
+				if (!ReadVarint(In, End, TrackId) || TrackId >= MaxTracks || In >= End)
+				{
+					return false;
+				}
+				const uint8 Flags = *In++;
+
+				FQuantizedSample& Sample = Previous[TrackId];
+				if ((TracksSeen & (1u << TrackId)) == 0)
+				{
+					FMemory::Memzero(Sample);
+					TracksSeen |= 1u << TrackId;
+				}
+
+				uint32 Deltas[9];
+				const int32 NumDeltas = (Flags & SampleFlag_HasTarget) ? 9 : 6;
+				for (int32 DeltaIndex = 0; DeltaIndex < NumDeltas; ++DeltaIndex)
+				{
+					if (!ReadVarint(In, End, Deltas[DeltaIndex]))
+					{
+						return false;
+					}
+				}
+
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					Sample.CameraLocation[Axis] += UnZigZag(Deltas[Axis]);
+					Sample.CameraRotation[Axis] = uint16(Sample.CameraRotation[Axis] + UnZigZag(Deltas[3 + Axis]));
+					if (NumDeltas == 9)
+					{
+						Sample.TargetLocation[Axis] += UnZigZag(Deltas[6 + Axis]);
+					}
+				}
+
+				FViewportSyncTrajectoryTrack* Track = OutTrajectory.Tracks.FindByPredicate([TrackId](const FViewportSyncTrajectoryTrack& InTrack) { return InTrack.TrackId == TrackId; });
+				if (Track == nullptr)
+				{
+					Track = &OutTrajectory.Tracks.AddDefaulted_GetRef();
+					Track->TrackId = uint16(TrackId);
+					Track->Name = FileTrackNames[TrackId];
+				}
+
+				FViewportSyncTrajectorySample& Decoded = Track->Samples.AddDefaulted_GetRef();
+				Decoded.Time = Time;
+				Decoded.CameraLocation = FVector(DequantizeLocation(Sample.CameraLocation[0]), DequantizeLocation(Sample.CameraLocation[1]), DequantizeLocation(Sample.CameraLocation[2]));
+				Decoded.CameraRotation = FRotator(FRotator::DecompressAxisFromShort(Sample.CameraRotation[0]), FRotator::DecompressAxisFromShort(Sample.CameraRotation[1]), FRotator::DecompressAxisFromShort(Sample.CameraRotation[2]));
+				Decoded.bHasTarget = NumDeltas == 9;
+				Decoded.TargetLocation = FVector(DequantizeLocation(Sample.TargetLocation[0]), DequantizeLocation(Sample.TargetLocation[1]), DequantizeLocation(Sample.TargetLocation[2]));
+			}
+		}
+	}
+
+	return true;
+}
+
+void FViewportSyncTrajectoryRecorder::Decode(FViewportSyncTrajectory& OutTrajectory) const
+{
+	TArray<uint8> Bytes;
+	Serialize(Bytes);
+	DecodeBytes(Bytes, OutTrajectory);
+}
+
+bool FViewportSyncTrajectoryRecorder::SaveToFile(const FString& FilePath) const
+{
+	TArray<uint8> Bytes;
+	Serialize(Bytes);
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		UE_LOG(LogViewportSyncTrajectory, Warning, TEXT("Failed to write viewport trajectories to %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogViewportSyncTrajectory, Log, TEXT("Wrote %d bytes of viewport trajectories to %s"), Bytes.Num(), *FilePath);
+	return true;
+}
+
+bool FViewportSyncTrajectoryRecorder::LoadFromFile(const FString& FilePath, FViewportSyncTrajectory& OutTrajectory)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		UE_LOG(LogViewportSyncTrajectory, Warning, TEXT("Failed to read viewport trajectories from %s"), *FilePath);
+		return false;
+	}
+
+	return DecodeBytes(Bytes, OutTrajectory);
+}
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncViewModel.h"
+#include "ViewportSyncSettings.h"
+
+// UE Includes
+#include "GameFramework/Actor.h"
+
+#define LOCTEXT_NAMESPACE "ViewportSyncViewModel"
+
+FViewportSyncViewModel::FViewportSyncViewModel()
+	: OverlayVisibility(EVisibility::Hidden)
+	, FollowVisibility(EVisibility::Hidden)
+	, ClearFollowVisibility(EVisibility::Hidden)
+	, ScreenPercentageVisibility(EVisibility::Collapsed)
+	, WorldVisibility(EVisibility::Collapsed)
+	, SuspendedVisibility(EVisibility::Collapsed)
+{}
+
+void FViewportSyncViewModel::Update(const TSoftObjectPtr<AActor>& FollowActor, const TSoftObjectPtr<AActor>& GlobalFollowActorOverride, bool bHasGlobalFollowLocationOverride, const FText& FollowGroupName, const FText& MirrorPlayerName, const FText& AutoFollowName, bool bSync, bool bSuspended, int32 ScreenPercentage, const FText& WorldName)
+{
+	// Mirroring doesn't follow anything so the override doesn't apply to it
+	const bool bMirroring = !MirrorPlayerName.IsEmpty();
+	const bool bFollowingLocation = !bMirroring && bHasGlobalFollowLocationOverride;
+	const bool bHasOverride = bFollowingLocation || (!bMirroring && !GlobalFollowActorOverride.IsNull());
+
+	const TSoftObjectPtr<AActor>& TargetActor = bHasOverride ? GlobalFollowActorOverride : FollowActor;
+	const bool bFollowingGroup = !bHasOverride && !FollowGroupName.IsEmpty();
+	const bool bAutoFollowing = !bHasOverride && !AutoFollowName.IsEmpty();
+
+	FString FollowActorName;
+
+	if (bMirroring)
+	{
+		FollowActorName = FString::Printf(TEXT("Mirroring: %s"), *MirrorPlayerName.ToString());
+	}
+	else if (bFollowingLocation)
+	{
+		// The point moves as often as game code likes, so it isn't worth reformatting for
+		FollowActorName = TEXT("Following: a location");
+	}
+	else if (bFollowingGroup)
+	{
+		FollowActorName = FString::Printf(TEXT("Following group: %s"), *FollowGroupName.ToString());
+	}
+	else if (TargetActor.IsValid())
+	{
+		FollowActorName = FString::Printf(TEXT("Following: '%s'"), *TargetActor->GetActorLabel());
+	}
+	else if (bAutoFollowing)
+	{
+		FollowActorName = FString::Printf(TEXT("Looking for: %s"), *AutoFollowName.ToString());
+	}
+	else if (TargetActor.IsPending())
+	{
+		FollowActorName = FString::Printf(TEXT("Waiting for: %s"), *TargetActor.ToSoftObjectPath().GetSubPathString());
+	}
+	else
+	{
+		FollowActorName = TEXT("No follow Actor set");
+	}
+
+	// Picked by the auto follow rule rather than the user, worth knowing why the camera jumps
+	FText FollowPrefix = FText::GetEmpty();
+	if (bHasOverride)
+	{
+		FollowPrefix = FText::FromString("[Override]");
+	}
+	else if (bAutoFollowing && TargetActor.IsValid())
+	{
+		FollowPrefix = FText::Format(LOCTEXT("AutoFollowPrefix", "[{0}]"), AutoFollowName);
+	}
+
+	const FText NewFollowText = FText::Format(LOCTEXT("FollowSelectedActor", "{0} {1}"), FollowPrefix, FText::FromString(FollowActorName));
+	const FText NewScreenPercentageText = ScreenPercentage > 0 ? FText::Format(LOCTEXT("ScreenPercentage", "Screen Percentage: {0}%"), FText::AsNumber(ScreenPercentage)) : FText::GetEmpty();
+	const FText NewWorldText = !WorldName.IsEmpty() ? FText::Format(LOCTEXT("Watching", "Watching: {0}"), WorldName) : FText::GetEmpty();
+
+	const EVisibility NewOverlayVisibility = GetDefault<UViewportSyncSettings>()->bShowOverlay ? EVisibility::HitTestInvisible : EVisibility::Hidden;
+	const EVisibility NewFollowVisibility = (bMirroring || bFollowingLocation || bFollowingGroup || bAutoFollowing || TargetActor.IsValid() || TargetActor.IsPending()) ? EVisibility::HitTestInvisible : EVisibility::Hidden;
+	const EVisibility NewClearFollowVisibility = (bSync && (bMirroring || !FollowActor.IsNull() || !FollowGroupName.IsEmpty() || !AutoFollowName.IsEmpty())) ? EVisibility::Visible : EVisibility::Hidden;
+	const EVisibility NewScreenPercentageVisibility = ScreenPercentage > 0 ? EVisibility::HitTestInvisible : EVisibility::Collapsed;
+	const EVisibility NewWorldVisibility = !WorldName.IsEmpty() ? EVisibility::HitTestInvisible : EVisibility::Collapsed;
+	const EVisibility NewSuspendedVisibility = bSuspended ? EVisibility::HitTestInvisible : EVisibility::Collapsed;
+
+	const bool bChanged = !NewFollowText.EqualTo(FollowText)
+		|| !NewScreenPercentageText.EqualTo(ScreenPercentageText)
+		|| !NewWorldText.EqualTo(WorldText)
+		|| NewOverlayVisibility != OverlayVisibility
+		|| NewFollowVisibility != FollowVisibility
+		|| NewClearFollowVisibility != ClearFollowVisibility
+		|| NewScreenPercentageVisibility != ScreenPercentageVisibility
+		|| NewWorldVisibility != WorldVisibility
+		|| NewSuspendedVisibility != SuspendedVisibility;
+
+	if (bChanged)
+	{
+		FollowText = NewFollowText;
+		ScreenPercentageText = NewScreenPercentageText;
+		WorldText = NewWorldText;
+		OverlayVisibility = NewOverlayVisibility;
+		FollowVisibility = NewFollowVisibility;
+		ClearFollowVisibility = NewClearFollowVisibility;
+		ScreenPercentageVisibility = NewScreenPercentageVisibility;
+		WorldVisibility = NewWorldVisibility;
+		SuspendedVisibility = NewSuspendedVisibility;
+
+		ChangedEvent.Broadcast();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
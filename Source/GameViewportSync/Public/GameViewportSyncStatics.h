@@ -4,16 +4,18 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "ViewportSyncCommandQueue.h"
 #include "GameViewportSyncStatics.generated.h"
 
 /**
- * 
+ * Drives the Viewport Sync subsystem from Blueprints and from game code in other modules
  */
 UCLASS()
-class UGameViewportSyncStatics : public UBlueprintFunctionLibrary
+class GAMEVIEWPORTSYNC_API UGameViewportSyncStatics : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
+public:
 	/* Set a global follow target override for all PIE sync'd viewports to follow */
 	UFUNCTION(BlueprintCallable, Category = "Editor Scripting | Viewport", meta=(DevelopmentOnly))
 	static void SetGlobalViewportFollowTargetOverride(AActor* FollowTarget);
@@ -21,4 +23,10 @@ class UGameViewportSyncStatics : public UBlueprintFunctionLibrary
 	/* Get the current follow target override from the Viewport Sync Subsystem */
 	UFUNCTION(BlueprintCallable, Category = "Editor Scripting | Viewport", meta=(DevelopmentOnly))
 	static TSoftObjectPtr<AActor> GetGlobalViewportFollowTargetOverride();
+
+	/*
+	 * For driving the viewports from any thread (follow an actor or a location, mark an event) without touching the subsystem.
+	 * Get it once on the game thread and keep it, each command is then only a queue push. Invalid if the subsystem isn't running
+	 */
+	static FViewportSyncCommandSender GetCommandSender();
 };
@@ -3,8 +3,28 @@
 #pragma once
 
 #include "EditorSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "ViewportSyncActorCorrespondence.h"
+#include "ViewportSyncAutoFollow.h"
+#include "ViewportSyncCommandQueue.h"
+#include "ViewportSyncFollowCore.h"
+#include "ViewportSyncFollowFilter.h"
+#include "ViewportSyncFollowGroup.h"
+#include "ViewportSyncPendingTargets.h"
+#include "ViewportSyncPlayerMirror.h"
+#include "ViewportSyncPoseStreamWriter.h"
+#include "ViewportSyncRenderProfile.h"
+#include "ViewportSyncScheduler.h"
+#include "ViewportSyncScreenPercentageGovernor.h"
+#include "ViewportSyncStateTable.h"
+#include "ViewportSyncStreaming.h"
+#include "ViewportSyncTrajectoryRecorder.h"
+#include "ViewportSyncViewModel.h"
 #include "SyncViewportSubsystem.generated.h"
 
+class APlayerCameraManager;
+class IConsoleObject;
+
 /**
  * Subsystem for syncing the PIE world with other Level Editor Viewports
  */
@@ -13,9 +33,23 @@ class GAMEVIEWPORTSYNC_API USyncViewportSubsystem : public UEditorSubsystem
 {
 	GENERATED_BODY()
 
+	// Drives the subsystem's callbacks directly so it can time them in isolation
+	friend class FViewportSyncBenchmark;
+
 	USyncViewportSubsystem()
 		: PIEWorldContext(nullptr)
 		, GlobalFollowActorOverride(nullptr)
+		, bSchedulingViewports(false)
+		, bFocusPriority(false)
+		, bFollowAfterWorldTick(false)
+		, bRenderingOnChange(false)
+		, bGoverningScreenPercentage(false)
+		, bGlobalFollowActorResolved(false)
+		, bGlobalFollowActorPending(false)
+		, NextStagedViewport(0)
+		, CachedActiveViewportClient(nullptr)
+		, CachedForCurrentViewportClient(nullptr)
+		, bActiveViewportClientCached(false)
 	{}
 
 protected:
@@ -25,47 +59,302 @@ protected:
 	// End Subsystems override
 
 	void OnPostEditorTick(float DeltaTime);
+
+	/* Moves the cameras of viewports watching World as soon as its actors have ticked */
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
 	
 	//////////////////////////////////////////////
 	// Live Viewport
 	//////////////////////////////////////////////
 protected:
-	// Only valid during PIE
+	// Only valid during PIE, the instance viewports sync with unless they pick another one
 	FWorldContext* PIEWorldContext;
 
+	// Every PIE instance (server and clients) of the current session
+	TArray<FWorldContext*> PIEWorldContexts;
+
+	// Maps follow actors into the world each viewport is watching
+	FViewportSyncActorCorrespondence ActorCorrespondence;
+
 	// Override to force all viewports to follow this actor
 	TSoftObjectPtr<AActor> GlobalFollowActorOverride;
 
-	struct FLiveViewportInfo
+	// A point for all viewports to follow instead, only ever set when GlobalFollowActorOverride isn't
+	TOptional<FVector> GlobalFollowLocationOverride;
+
+	// Commands game code sent from any thread, carried out at the start of each post editor tick
+	TSharedPtr<FViewportSyncCommandQueue, ESPMode::ThreadSafe> CommandQueue;
+
+	/*
+	 * Per viewport data the tick reads every frame (flags, follow state, cached targets, render on change), densely packed
+	 * so walking the viewports doesn't chase a pointer each. What is rarely touched stays in FLiveViewportInfo
+	 */
+	struct FSyncViewportState
 	{
+		// FLiveViewportInfo::FollowActor resolved, cached until it goes stale or the follow actor changes
+		TWeakObjectPtr<AActor> ResolvedFollowActor;
+
+		// Camera manager of the player FLiveViewportInfo::Mirror points at, cached until it goes stale
+		TWeakObjectPtr<APlayerCameraManager> MirroredCameraManager;
+
+		// The PIE instance this viewport is showing, only set while it is synced
+		FWorldContext* SyncedWorldContext;
+
+		// Smoothing, throttling and orbit state for the follow core
+		FViewportSyncFollowState Follow;
+
+		// Where the camera's target was as of the last follow update, only meaningful with bHasFollowTargetLocation
+		FVector FollowTargetLocation;
+
+		// How much attention the viewport is getting, only kept up to date when focus priority is on
+		EViewportSyncFocusClass FocusClass;
+
+		// What this viewport makes its world stream in
+		EViewportSyncStreamingPolicy StreamingPolicy;
+
+		// What the viewport last showed for render on change: its world's time and its camera, anything different needs a redraw
+		float RenderedWorldTime;
+		float RenderedFOV;
+		FVector RenderedViewLocation;
+		FRotator RenderedViewRotation;
+
+		// How long the above has stayed the same for, render on change idles the viewport once it passes the settle time
+		float UnchangedTime;
+
+		// This viewport's track in the trajectory recorder
+		uint16 TrajectoryTrackId;
+
 		// Is this the PIE viewport? If it is, we skip applying settings
-		bool bIsPIEViewport;
-		
+		uint8 bIsPIEViewport : 1;
+
 		// Should this viewport be syncing with the PIE session
-		bool bSync;
+		uint8 bSync : 1;
+
+		// Whether FLiveViewportInfo::FollowActor is set, so the tick doesn't have to look at the cold data to find out
+		uint8 bHasFollowActor : 1;
+
+		// Whether the follow actor resolved last tick, when this flips the overlay text needs refreshing
+		uint8 bFollowActorResolved : 1;
+
+		// The follow actor doesn't exist (yet), don't look for it again until PendingFollowTargets says something matching appeared
+		uint8 bFollowActorPending : 1;
+
+		// Whether FLiveViewportInfo::FollowGroup is set, a viewport follows either a group or a single actor
+		uint8 bHasFollowGroup : 1;
+
+		// Staged PIE start hasn't got to this viewport yet, it has none of our settings applied
+		uint8 bPIEStartStaged : 1;
 
+		// Synced but hidden, not rendering or following until it is visible again
+		uint8 bSuspended : 1;
+
+		// The follow math ran since the last post editor tick, so there's a new pose to record and publish
+		uint8 bFollowUpdated : 1;
+
+		// Whether the last follow update found something to follow
+		uint8 bHasFollowTargetLocation : 1;
+
+		// Whether FLiveViewportInfo::Mirror is enabled, the camera copies a player's instead of following anything
+		uint8 bMirrorPlayer : 1;
+
+		// Whether FLiveViewportInfo::AutoFollow is set, the follow actor is picked by its rule rather than the user
+		uint8 bHasAutoFollow : 1;
+
+		// Render on change has stopped redrawing it, nothing it shows has changed for a while
+		uint8 bRenderIdle : 1;
+
+		explicit FSyncViewportState(bool bShouldSync);
+	};
+
+	/*
+	 * Per viewport data that is only needed when settings change, for UI, or rarely from the tick (view model, render profile, mirror, names)
+	 */
+	struct FLiveViewportInfo
+	{
 		// The actor the user wants this viewport to follow
 		TSoftObjectPtr<AActor> FollowActor;
 
-		// Used for smoothing the follow
-		FVector PreviousFollowLocation;
+		// The group of actors the user wants this viewport to keep in frame
+		TSharedPtr<FViewportSyncFollowGroup> FollowGroup;
+
+		// Picks the follow actor for the user, from the candidates its rule describes
+		TSharedPtr<FViewportSyncAutoFollow> AutoFollow;
+
+		// Cached display text/visibility for the overlay and menu
+		TSharedRef<FViewportSyncViewModel> ViewModel;
+
+		// How often this viewport is redrawn when the scheduler is active
+		FViewportSyncRefreshRate RefreshRate;
+
+		// PIE instance to sync with, INDEX_NONE for the default one
+		int32 PIEInstance;
+
+		// Screen percentage the adaptive governor has applied, 0 when we aren't driving it
+		int32 ScreenPercentage;
+
+		// What the viewport had before we took over its screen percentage
+		bool bWasPreviewingScreenPercentage;
+		int32 PreviousScreenPercentage;
+
+		// Name of this viewport's follow lag stat in CSV captures, from its track id so captures don't gain a column per viewport ever opened
+		FName FollowLagStatName;
+
+		// Render profile picked for this viewport, None for the default one
+		FName RenderProfile;
+
+		// The player this viewport mirrors, replaces following an actor or group
+		FViewportSyncPlayerMirror Mirror;
+
+		// What the viewport's FOV was before mirroring changed it, 0 when we haven't
+		float PreviousFOV;
+
+		// What the render profile replaced while it is applied
+		FViewportSyncRenderProfileRestoreState RenderProfileRestoreState;
 
 	private:
 		// Overlay Widget
 		mutable TSharedPtr<SWidget> OverlayWidget;
 
 	public:
-		FLiveViewportInfo(bool bShouldSync, const TSoftObjectPtr<AActor>& ActorToFollow);
+		explicit FLiveViewportInfo(const TSoftObjectPtr<AActor>& ActorToFollow);
 		
 		TSharedRef<SWidget> GetOverlayWidget() const;
 	};
-	TMap<FLevelEditorViewportClient*, FLiveViewportInfo> ViewportInfos;
+
+	typedef TViewportSyncStateTable<FLevelEditorViewportClient*, FSyncViewportState, FLiveViewportInfo> FViewportStateTable;
+	FViewportStateTable ViewportStates;
+
+	/*
+	 * State of a recently closed viewport, kept so switching layouts or maximizing/restoring
+	 * gives the viewport straight back its settings, follow smoothing and overlay
+	 */
+	struct FPooledViewport
+	{
+		// Layout config key of the closed viewport, the replacement viewport gets the same one
+		FName ConfigKey;
+
+		FSyncViewportState State;
+		FLiveViewportInfo Info;
+
+		FPooledViewport(FName InConfigKey)
+			: ConfigKey(InConfigKey)
+			, State(false)
+			, Info(nullptr)
+		{}
+	};
+
+	// Most recently closed last
+	TArray<FPooledViewport> PooledViewports;
+
+	// Redraws synced viewports at their refresh rate when bScheduleSyncedViewports is enabled
+	FViewportSyncScheduler Scheduler;
+
+	// Whether the scheduler is driving redraws at each viewport's refresh rate for this PIE session
+	bool bSchedulingViewports;
+
+	// Whether focus priority is throttling synced viewports this PIE session, every synced viewport is scheduled when it is
+	bool bFocusPriority;
+
+	// Whether cameras follow straight after their world ticks this PIE session, rather than in the post editor tick
+	bool bFollowAfterWorldTick;
+
+	// Whether synced viewports stop redrawing while nothing they show changes this PIE session
+	bool bRenderingOnChange;
+
+	FDelegateHandle WorldPostActorTickHandle;
+
+	// Follow work done since the stats were last published, possibly over several world ticks
+	struct FFollowUpdateStats
+	{
+		int32 NumResolved;
+		int32 NumPending;
+		int32 NumGroupMembers;
+		float MaxLag;
+
+		FFollowUpdateStats() { Reset(); }
+		void Reset() { FMemory::Memzero(*this); }
+	};
+	FFollowUpdateStats FollowStats;
+
+	// Scales synced viewport resolution to keep the PIE frame rate when bAdaptiveScreenPercentage is enabled
+	FViewportSyncScreenPercentageGovernor ScreenPercentageGovernor;
+
+	// Whether the governor is driving screen percentage for this PIE session
+	bool bGoverningScreenPercentage;
+
+	// Trajectory track ids not held by a viewport (open or pooled), lowest last. Also names each viewport's CSV stats
+	TArray<uint16, TInlineAllocator<FViewportSyncTrajectoryRecorder::MaxTracks>> FreeTrackIds;
+
+	// Whether the global override resolved last tick
+	bool bGlobalFollowActorResolved;
+
+	// Same as FSyncViewportState::bFollowActorPending for the global override
+	bool bGlobalFollowActorPending;
+
+	// Follow actors we are waiting to spawn
+	FViewportSyncPendingTargets PendingFollowTargets;
+
+	// Actor spawned handlers we added to each PIE world
+	TArray<TPair<TWeakObjectPtr<UWorld>, FDelegateHandle>> ActorSpawnedHandles;
+
+	// Records every synced camera (and what it was following) so sessions can be looked back over after PIE
+	FViewportSyncTrajectoryRecorder TrajectoryRecorder;
+
+	// Recording being scrubbed through in the editor world
+	FViewportSyncTrajectory LoadedTrajectory;
+
+	// Shares every synced camera pose with external tools when bPublishPoseStream is enabled
+	FViewportSyncPoseStreamWriter PoseStream;
+
+	// Name PoseStream was opened with, so settings changes only reopen it when they need to
+	FString PoseStreamName;
+
+	// Applies render profile LOD scaling to the views of synced viewports
+	TSharedPtr<FViewportSyncRenderProfileViewExtension, ESPMode::ThreadSafe> RenderProfileViewExtension;
+
+	TArray<IConsoleObject*> ConsoleCommands;
+
+	// Viewports still waiting to be set up when bStagePIEStart is on, nearest the PIE viewport first
+	TArray<FViewportSyncHandle> StagedViewports;
+	int32 NextStagedViewport;
+
+	/*
+	 * How long the last PIE start took and how much of that was us
+	 */
+	struct FPIEStartTiming
+	{
+		// When PreBeginPIE fired
+		double BeginTime;
+
+		// From PreBeginPIE until we were done in PostPIEStarted, and our part of it
+		double StartFrameMs;
+		double PluginStartFrameMs;
+
+		// Spent setting up staged viewports in the frames after
+		double StagedMs;
+		int32 StagedFrames;
+
+		int32 NumImmediateViewports;
+		int32 NumStagedViewports;
+
+		FPIEStartTiming()
+		{
+			Reset();
+		}
+
+		void Reset()
+		{
+			FMemory::Memzero(*this);
+		}
+	};
+
+	FPIEStartTiming PIEStartTiming;
 	
 public:
 	const FLiveViewportInfo* GetDataForViewport(FLevelEditorViewportClient* ViewportClient) const;
 
-	void SaveInformationForViewport(FLevelEditorViewportClient* ViewportClient, const FLiveViewportInfo& InfoToSave);
-	FLiveViewportInfo LoadInformationForViewport(FLevelEditorViewportClient* ViewportClient);
+	void SaveInformationForViewport(FLevelEditorViewportClient* ViewportClient, const FSyncViewportState& StateToSave, const FLiveViewportInfo& InfoToSave);
+	void LoadInformationForViewport(FLevelEditorViewportClient* ViewportClient, FSyncViewportState& OutState, FLiveViewportInfo& OutInfo);
 	
 	virtual void SetViewportSyncState(FLevelEditorViewportClient* ViewportClient, bool bState);
 	virtual bool IsViewportSyncing(FLevelEditorViewportClient* ViewportClient) const;
@@ -73,25 +362,201 @@ public:
 	virtual void SetViewportFollowActor(FLevelEditorViewportClient* ViewportClient, const AActor* Actor);
 	virtual bool IsViewportFollowingActor(FLevelEditorViewportClient* ViewportClient, const AActor* Actor) const;
 
+	/* Follow a group of actors, keeping all of them in frame. Replaces the viewport's follow actor */
+	virtual void SetViewportFollowGroup(FLevelEditorViewportClient* ViewportClient, const FViewportSyncFollowGroupDesc& GroupDesc);
+	virtual bool IsViewportFollowingGroup(FLevelEditorViewportClient* ViewportClient) const;
+
+	/* Copy a player's camera every frame instead of following anything. Replaces the viewport's follow actor or group, a disabled mirror turns it off */
+	virtual void SetViewportMirror(FLevelEditorViewportClient* ViewportClient, const FViewportSyncPlayerMirror& Mirror);
+	virtual bool IsViewportMirroringPlayer(FLevelEditorViewportClient* ViewportClient, int32 PlayerIndex) const;
+
+	/* Let a rule pick the follow actor, e.g. whichever actor of a class is nearest to the player. Replaces the viewport's follow actor, group or mirror */
+	virtual void SetViewportAutoFollow(FLevelEditorViewportClient* ViewportClient, const FViewportSyncAutoFollowRule& Rule);
+	virtual bool IsViewportAutoFollowing(FLevelEditorViewportClient* ViewportClient) const;
+
+	virtual void SetViewportRefreshRate(FLevelEditorViewportClient* ViewportClient, FViewportSyncRefreshRate RefreshRate);
+	virtual bool IsViewportRefreshRate(FLevelEditorViewportClient* ViewportClient, FViewportSyncRefreshRate RefreshRate) const;
+
+	virtual void SetViewportPIEInstance(FLevelEditorViewportClient* ViewportClient, int32 PIEInstance);
+	virtual bool IsViewportPIEInstance(FLevelEditorViewportClient* ViewportClient, int32 PIEInstance) const;
+
+	virtual void SetViewportFollowFilter(FLevelEditorViewportClient* ViewportClient, EViewportSyncFollowFilter Filter);
+	virtual bool IsViewportFollowFilter(FLevelEditorViewportClient* ViewportClient, EViewportSyncFollowFilter Filter) const;
+
+	virtual void SetViewportStreamingPolicy(FLevelEditorViewportClient* ViewportClient, EViewportSyncStreamingPolicy Policy);
+	virtual bool IsViewportStreamingPolicy(FLevelEditorViewportClient* ViewportClient, EViewportSyncStreamingPolicy Policy) const;
+
+	virtual void SetViewportRenderProfile(FLevelEditorViewportClient* ViewportClient, FName ProfileName);
+	virtual bool IsViewportRenderProfile(FLevelEditorViewportClient* ViewportClient, FName ProfileName) const;
+
 	/* Set the override for all viewports to follow */
 	void SetGlobalViewportFollowTargetOverride(AActor* FollowTarget);
 	
 	/* Get the override for all viewports to follow */
 	const TSoftObjectPtr<AActor>& GetGlobalViewportFollowTargetOverride() const;
+
+	/* Set a point for all viewports to follow, replacing the follow target override. Unset clears it */
+	void SetGlobalViewportFollowLocationOverride(const TOptional<FVector>& Location);
+
+	/* Get the point all viewports follow, unset when there isn't one */
+	const TOptional<FVector>& GetGlobalViewportFollowLocationOverride() const;
+
+	/* Put a marker at Location in every PIE world and record it as an event in CSV captures */
+	void MarkEvent(const FVector& Location, FName Label);
+
+	/* For sending the above from any thread, keep hold of it rather than getting a new one for every command */
+	FViewportSyncCommandSender GetCommandSender() const;
+
+	/* Write the recorded camera trajectories to disk */
+	bool SaveTrajectories(const FString& FilePath) const;
+
+	/* Load trajectories to scrub through, an empty path takes them from the recorder instead */
+	bool LoadTrajectories(const FString& FilePath);
+
+	/* Outside of PIE, put each viewport's camera where it was Time seconds into the loaded recording and draw the recorded paths */
+	void ScrubTrajectories(double Time);
 	
 protected:
 	/* Called when there has been a change to the number of level viewports in the editor */
 	virtual void OnLevelViewportClientListChanged();
 
-	virtual void ApplyViewportSettings(FLevelEditorViewportClient* const Client, const FLiveViewportInfo& ViewportInfo);
-	virtual void RevertViewportSettings(FLevelEditorViewportClient* const Client, const FLiveViewportInfo& ViewportInfo);
+	/* Moves a closing viewport's state into the pool, returns false if it can't be pooled */
+	bool ReleaseViewportToPool(FViewportSyncHandle ViewportHandle);
+
+	/* Gives a newly opened viewport back the state of a pooled one, returns false if there was nothing pooled for it */
+	bool RestoreViewportFromPool(FLevelEditorViewportClient* ViewportClient);
+
+	/* Track id for a new viewport, past the recorder's last track once every id is taken */
+	uint16 AllocateTrackId();
+
+	/* Hand back a track id once the viewport holding it is gone for good */
+	void ReleaseTrackId(uint16 TrackId);
+
+	virtual void ApplyViewportSettings(FViewportSyncHandle ViewportHandle);
+	virtual void RevertViewportSettings(FViewportSyncHandle ViewportHandle);
+
+	/* Queue every viewport for staged PIE start, nearest the PIE viewport first, and set up the first few straight away */
+	void StageViewportSettings(int32 NumImmediateViewports);
+
+	/* Set up queued viewports until the frame budget runs out, at least one per call */
+	void ApplyStagedViewportSettings(float FrameBudgetMs);
+
+	/* Set up a viewport now if it is still waiting on staged PIE start, before anything changes its settings */
+	void FlushStagedViewport(FViewportSyncHandle ViewportHandle);
+
+	/* Log and publish the last PIE start's timing */
+	void ReportPIEStartTiming();
 	
+	/* Carry out everything queued through the command sender, only the last follow command each tick matters */
+	void ExecuteQueuedCommands();
+
+	/* The world context for a PIE instance, falls back to the default one if that instance isn't running */
+	FWorldContext* FindPIEWorldContext(int32 PIEInstance) const;
+
+	/* Actor's counterpart in the world the viewport is watching */
+	const AActor* GetActorInViewportWorld(const AActor* Actor, const FSyncViewportState& ViewportState);
+
 	void ApplyViewportSync(FLevelEditorViewportClient* const ViewportClient);
 	void RevertViewportSync(FLevelEditorViewportClient* const ViewportClient);
 
+	/* Whether the scheduler redraws this viewport rather than it being realtime */
+	bool IsViewportScheduled(const FLiveViewportInfo& ViewportInfo) const;
+
+	/* Hands the viewport's redraws to the scheduler, at its refresh rate and capped by its focus class */
+	void ScheduleViewport(FViewportSyncHandle ViewportHandle, const FSyncViewportState& ViewportState, const FLiveViewportInfo& ViewportInfo);
+
+	/* Realtime on or off for a synced viewport. The first call when syncing keeps the viewport's own setting for RevertViewportSync, later ones replace ours */
+	void SetSyncedRealtime(FLevelEditorViewportClient* const ViewportClient, bool bRealtime, bool bFirstSync = false);
+
+	/* Redraw a synced viewport at its usual rate again, realtime or handed to the scheduler */
+	void StartViewportRedraws(FViewportSyncHandle ViewportHandle, bool bFirstSync = false);
+
+	/* Stop redrawing a synced viewport, it keeps showing its last frame */
+	void StopViewportRedraws(FViewportSyncHandle ViewportHandle);
+
+	/* Stop a hidden synced viewport from rendering, it keeps its world so resuming is cheap */
+	void SuspendViewport(FViewportSyncHandle ViewportHandle);
+
+	/* Start a suspended viewport rendering again, its camera snaps to the follow target on the same tick */
+	void ResumeViewport(FViewportSyncHandle ViewportHandle);
+
+	/* Idle the viewport once its world and camera have stayed the same for the settle time, and wake it as soon as either changes */
+	void UpdateViewportRenderOnChange(int32 ViewportIndex, float DeltaTime, float SettleTime);
+
+	/* Stop redrawing a viewport whose world and camera aren't changing, it keeps showing its last frame */
+	void IdleViewport(FViewportSyncHandle ViewportHandle);
+
+	/* Go back to redrawing the viewport at its usual rate */
+	void WakeViewport(FViewportSyncHandle ViewportHandle);
+
+	/* Apply the viewport's render profile (or the default one), remembering what it replaces */
+	void ApplyViewportRenderProfile(FLevelEditorViewportClient* const ViewportClient, FLiveViewportInfo& ViewportInfo);
+	void RevertViewportRenderProfile(FLevelEditorViewportClient* const ViewportClient, FLiveViewportInfo& ViewportInfo);
+
+	void ApplyViewportScreenPercentage(FLevelEditorViewportClient* const ViewportClient, FLiveViewportInfo& ViewportInfo);
+	void RevertViewportScreenPercentage(FLevelEditorViewportClient* const ViewportClient, FLiveViewportInfo& ViewportInfo);
+
+	/* Re-format the overlay/menu display state, call whenever something it shows changes */
+	void RefreshViewportViewModel(FViewportSyncHandle ViewportHandle);
+	void RefreshAllViewportViewModels();
+
+	void OnSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent);
+
+	/* Sizes the trajectory ring from the settings, allocates so keep it out of the tick */
+	void InitializeTrajectoryRecorder();
+
+	/* Opens or closes the shared memory pose stream to match the settings */
+	void UpdatePoseStream();
+
+	void RegisterConsoleCommands();
+	void UnRegisterConsoleCommands();
+
 	void ApplyViewportFollowActor(FLevelEditorViewportClient* const ViewportClient, const AActor* Actor);
+	void ApplyViewportFollowLocation(FLevelEditorViewportClient* const ViewportClient, const FVector& Location);
 	void RevertViewportFollowActor(FLevelEditorViewportClient* const ViewportClient);
+
+	/* The global override in the PIE world, null while it doesn't exist (yet) */
+	const AActor* ResolveGlobalFollowActor();
+
+	/* Whether focus priority lets the viewport's camera move this frame */
+	bool ShouldUpdateFollow(FSyncViewportState& ViewportState, double CurrentTime, float DeltaTime);
+
+	/* Moves the viewport's camera to its follow actor (or group) using the game time pending since the last update */
+	void UpdateViewportFollow(int32 ViewportIndex, const AActor* GlobalFollowActor, float FollowActorMovementThresholdSquared);
+
+	/* Copies the mirrored player's camera for this frame onto the viewport */
+	void MirrorViewportPlayer(int32 ViewportIndex);
+
+	/* Stop a viewport mirroring a player and give it back its FOV */
+	void StopViewportMirror(FViewportSyncHandle ViewportHandle);
+
+	/* Give the viewport back the FOV it had before mirroring, the mirror itself stays set */
+	void RevertViewportMirror(FLevelEditorViewportClient* const ViewportClient, FLiveViewportInfo& ViewportInfo);
+
+	/* Sets the follow actor without touching the viewport's mirror or auto follow rule, SetViewportFollowActor and auto follow both go through here */
+	void FollowActorInViewport(FViewportSyncHandle ViewportHandle, const AActor* Actor);
+
+	/* Lets the viewport's auto follow rule pick this frame's target, switching the follow actor when it changes */
+	void UpdateViewportAutoFollow(int32 ViewportIndex);
+
+	/* Stop a viewport picking its own follow actor, the one it picked last stays */
+	void StopViewportAutoFollow(FViewportSyncHandle ViewportHandle);
+
+	/* Move the viewport's camera towards a single point it is following */
+	void FollowViewportLocation(int32 ViewportIndex, const FVector& Location, float FollowDeltaTime, float FollowActorMovementThresholdSquared);
+
+	/* Frames a viewport's follow group for this tick, false if none of its members exist in the viewport's world */
+	bool FollowViewportGroup(int32 ViewportIndex, float FollowDeltaTime, float FollowActorMovementThresholdSquared, FViewportSyncFollowGroupFrame& OutFrame);
 	
+	/* Stop waiting on a viewport's (or with an unset handle, the override's) follow actor to spawn */
+	void ClearPendingFollowTarget(FViewportSyncHandle ViewportHandle);
+
+	/* Let a pending follow target try resolving again next tick */
+	void RearmPendingFollowTarget(FViewportSyncHandle ViewportHandle);
+
+	void OnPIEActorSpawned(AActor* Actor);
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+
 	// Begin PIE Callbacks
 	void OnPrePIEBegin(const bool bIsSimulating);
 	void OnPIEPostStarted(const bool bIsSimulating);
@@ -115,6 +580,15 @@ public:
 	void UnRegisterCommands(TSharedRef<FUICommandList> CommandList);
 
 	static FLevelEditorViewportClient* GetActiveViewportClient();
+
+protected:
+	/* GetActiveViewportClient, only looked up again once the editor's current viewport or the viewport list changes. For anything Slate polls */
+	FLevelEditorViewportClient* GetCachedActiveViewportClient();
+
+	// What GetCachedActiveViewportClient last found, and GCurrentLevelEditingViewportClient at the time
+	FLevelEditorViewportClient* CachedActiveViewportClient;
+	FLevelEditorViewportClient* CachedForCurrentViewportClient;
+	bool bActiveViewportClientCached;
 	
 	//////////////////////////////////////////////
 	// Viewport Extending
@@ -125,6 +599,12 @@ protected:
 	void BuildMenuListForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient);
 	void CreateFollowActorMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient);
 	void BuildCurrentFollowActorWidgetForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient);
+	void CreateRefreshRateMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient);
+	void CreateFollowFilterMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient);
+	void CreateMirrorPlayerMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient);
+	void CreatePIEInstanceMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient);
+	void CreateStreamingPolicyMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient);
+	void CreateRenderProfileMenuForViewport(FMenuBuilder& MenuBuilder, FLevelEditorViewportClient* ViewportClient);
 
 	//////////////////////////////////////////////
 	// Context Menu Extending
@@ -139,28 +619,101 @@ protected:
 
 inline const USyncViewportSubsystem::FLiveViewportInfo* USyncViewportSubsystem::GetDataForViewport(FLevelEditorViewportClient* ViewportClient) const
 {
-	return ViewportInfos.Find(ViewportClient);
+	return ViewportStates.GetCold(ViewportStates.Find(ViewportClient));
 }
 
 inline bool USyncViewportSubsystem::IsViewportSyncing(FLevelEditorViewportClient* ViewportClient) const
 {
-	if(const FLiveViewportInfo* ViewportInfo = ViewportInfos.Find(ViewportClient))
+	if(const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportStates.Find(ViewportClient)))
 	{
-		return ViewportInfo->bSync;
+		return ViewportState->bSync;
 	}
 	return false;
 }
 
 inline bool USyncViewportSubsystem::IsViewportFollowingActor(FLevelEditorViewportClient* ViewportClient, const AActor* Actor) const
 {
-	if(const FLiveViewportInfo* ViewportInfo = ViewportInfos.Find(ViewportClient))
+	if(const FLiveViewportInfo* ViewportInfo = GetDataForViewport(ViewportClient))
 	{
 		return ViewportInfo->FollowActor == Actor;
 	}
 	return false;
 }
 
+inline bool USyncViewportSubsystem::IsViewportFollowingGroup(FLevelEditorViewportClient* ViewportClient) const
+{
+	if(const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportStates.Find(ViewportClient)))
+	{
+		return ViewportState->bHasFollowGroup;
+	}
+	return false;
+}
+
+inline bool USyncViewportSubsystem::IsViewportAutoFollowing(FLevelEditorViewportClient* ViewportClient) const
+{
+	if(const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportStates.Find(ViewportClient)))
+	{
+		return ViewportState->bHasAutoFollow;
+	}
+	return false;
+}
+
+inline bool USyncViewportSubsystem::IsViewportMirroringPlayer(FLevelEditorViewportClient* ViewportClient, int32 PlayerIndex) const
+{
+	if(const FLiveViewportInfo* ViewportInfo = GetDataForViewport(ViewportClient))
+	{
+		return ViewportInfo->Mirror.PlayerIndex == PlayerIndex;
+	}
+	return false;
+}
+
+inline bool USyncViewportSubsystem::IsViewportRefreshRate(FLevelEditorViewportClient* ViewportClient, FViewportSyncRefreshRate RefreshRate) const
+{
+	if(const FLiveViewportInfo* ViewportInfo = GetDataForViewport(ViewportClient))
+	{
+		return ViewportInfo->RefreshRate == RefreshRate;
+	}
+	return false;
+}
+
+inline bool USyncViewportSubsystem::IsViewportPIEInstance(FLevelEditorViewportClient* ViewportClient, int32 PIEInstance) const
+{
+	if(const FLiveViewportInfo* ViewportInfo = GetDataForViewport(ViewportClient))
+	{
+		return ViewportInfo->PIEInstance == PIEInstance;
+	}
+	return false;
+}
+
+inline bool USyncViewportSubsystem::IsViewportFollowFilter(FLevelEditorViewportClient* ViewportClient, EViewportSyncFollowFilter Filter) const
+{
+	if(const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportStates.Find(ViewportClient)))
+	{
+		return ViewportState->Follow.FilterSettings.Filter == Filter;
+	}
+	return false;
+}
+
+inline bool USyncViewportSubsystem::IsViewportStreamingPolicy(FLevelEditorViewportClient* ViewportClient, EViewportSyncStreamingPolicy Policy) const
+{
+	if(const FSyncViewportState* ViewportState = ViewportStates.GetHot(ViewportStates.Find(ViewportClient)))
+	{
+		return ViewportState->StreamingPolicy == Policy;
+	}
+	return false;
+}
+
 inline const TSoftObjectPtr<AActor>& USyncViewportSubsystem::GetGlobalViewportFollowTargetOverride() const
 {
 	return GlobalFollowActorOverride;
+}
+
+inline const TOptional<FVector>& USyncViewportSubsystem::GetGlobalViewportFollowLocationOverride() const
+{
+	return GlobalFollowLocationOverride;
+}
+
+inline FViewportSyncCommandSender USyncViewportSubsystem::GetCommandSender() const
+{
+	return FViewportSyncCommandSender(CommandQueue);
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+struct FWorldContext;
+
+/**
+ * Maps an actor in one PIE world to the same actor in another, e.g. a client's pawn to the server's copy of it.
+ *
+ * Replicated actors are matched through their network GUID, which the server hands out and every client shares.
+ * Anything else (placed in the level and not replicated) is matched by its path with the PIE prefix swapped over.
+ * Matches are cached so following the same actor across worlds is a single map lookup per frame.
+ */
+class GAMEVIEWPORTSYNC_API FViewportSyncActorCorrespondence
+{
+public:
+	/* Find SourceActor's counterpart in the target world, nullptr if it doesn't exist there (yet) */
+	AActor* Find(const AActor* SourceActor, const FWorldContext& TargetWorldContext);
+
+	/* Forget everything, the worlds are going away */
+	void Reset();
+
+private:
+	static AActor* FindByNetGUID(const AActor* SourceActor, UWorld* TargetWorld);
+	static AActor* FindByPath(const AActor* SourceActor, int32 TargetPIEInstance);
+
+	// (Source actor, target world) -> counterpart
+	TMap<TPair<FObjectKey, FObjectKey>, TWeakObjectPtr<AActor>> Cache;
+};
@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SubclassOf.h"
+
+#include "ViewportSyncSpatialGrid.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * How an auto follow rule picks its target
+ */
+enum class EViewportSyncAutoFollowMode : uint8
+{
+	// The candidate closest to the player
+	Nearest,
+
+	// The candidate with the highest relevance score
+	MostRelevant
+};
+
+/**
+ * Describes which actor a viewport should follow on its own, picked from every actor of a class
+ */
+struct GAMEVIEWPORTSYNC_API FViewportSyncAutoFollowRule
+{
+	EViewportSyncAutoFollowMode Mode;
+
+	// Candidates, including ones spawned later
+	TSubclassOf<AActor> ActorClass;
+
+	// Which player's camera distances are measured from, falls back to the viewport's camera when there isn't one
+	int32 PlayerIndex;
+
+	// Ignore candidates further away than this, 0 for no limit
+	float SearchRadius;
+
+	// How much better (as a fraction) a candidate has to be than the current target before we switch to it
+	float Hysteresis;
+
+	// Seconds to stay on a target before another one can take over, unless it goes away
+	float MinRetargetTime;
+
+	// MostRelevant scoring, higher is better. Without one candidates score by how close they are
+	TFunction<float(const AActor& Actor, const FVector& Location, const FVector& Origin)> Relevance;
+
+	/*
+	 * The highest score Relevance could give a candidate this far from the origin (in XY). Lets MostRelevant search outward
+	 * from the player and stop once nothing further out can win, without one every candidate in SearchRadius is scored
+	 */
+	TFunction<float(float Distance)> RelevanceBound;
+
+	FViewportSyncAutoFollowRule()
+		: Mode(EViewportSyncAutoFollowMode::Nearest)
+		, PlayerIndex(0)
+		, SearchRadius(0.0f)
+		, Hysteresis(0.2f)
+		, MinRetargetTime(1.0f)
+	{}
+
+	static FViewportSyncAutoFollowRule Nearest(TSubclassOf<AActor> InActorClass, int32 InPlayerIndex = 0);
+	static FViewportSyncAutoFollowRule MostRelevant(TSubclassOf<AActor> InActorClass, TFunction<float(const AActor&, const FVector&, const FVector&)> InRelevance, int32 InPlayerIndex = 0, TFunction<float(float)> InRelevanceBound = nullptr);
+
+	bool Matches(const AActor* Actor) const;
+
+	FText GetDisplayText() const;
+};
+
+/**
+ * The candidates for an auto follow rule in one world and the target currently picked from them.
+ *
+ * Candidates live in a spatial grid that's refreshed a slice at a time, so picking a target only looks at the
+ * candidates near the player rather than all of them.
+ */
+class GAMEVIEWPORTSYNC_API FViewportSyncAutoFollow
+{
+public:
+	FViewportSyncAutoFollow(const FViewportSyncAutoFollowRule& InRule, float CellSize);
+
+	const FViewportSyncAutoFollowRule& GetRule() const { return Rule; }
+
+	/* Collect the candidates from a world, drops the current target */
+	void Rebuild(UWorld* InWorld);
+
+	/* Rebuild before the next update, e.g. when PIE starts or the viewport switches worlds */
+	void MarkNeedsRebuild() { bNeedsRebuild = true; }
+	bool NeedsRebuild() const { return bNeedsRebuild; }
+
+	/* Picks up candidates spawned into our world */
+	void OnActorSpawned(AActor* Actor);
+
+	/*
+	 * Refresh some of the candidates and pick the target for this frame
+	 * @param Origin		Where distances are measured from
+	 * @param CurrentTime		For MinRetargetTime
+	 * @param RefreshBudget		Candidates to re-bucket this update, 0 for all of them
+	 * @return The target, nullptr if there's no candidate
+	 */
+	AActor* Update(const FVector& Origin, double CurrentTime, int32 RefreshBudget);
+
+	AActor* GetTarget() const { return Target.Get(); }
+
+	int32 Num() const { return Grid.Num(); }
+
+	const UWorld* GetWorld() const { return World.Get(); }
+
+	void Reset();
+
+private:
+	/* Highest scoring candidate, by the rule's relevance function. Searches outward from Origin when the score is bounded by distance */
+	AActor* FindMostRelevant(const FVector& Origin, float& OutScore) const;
+
+	float Score(const AActor& Actor, const FVector& Location, const FVector& Origin) const;
+
+	FViewportSyncAutoFollowRule Rule;
+
+	FViewportSyncSpatialGrid Grid;
+
+	TWeakObjectPtr<UWorld> World;
+
+	TWeakObjectPtr<AActor> Target;
+	double LastRetargetTime;
+
+	bool bNeedsRebuild;
+};
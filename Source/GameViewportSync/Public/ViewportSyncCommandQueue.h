@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+
+/**
+ * Fixed size lock-free queue any number of threads can push to and one thread pops from.
+ *
+ * Each slot carries a sequence number saying whose turn it is, so a push is one compare exchange to claim a slot plus
+ * a store to publish it, and nothing is allocated after construction. Pushing to a full queue fails rather than waiting.
+ */
+template<typename ElementType>
+class TViewportSyncMpscQueue
+{
+public:
+	/* Capacity is rounded up to a power of two */
+	explicit TViewportSyncMpscQueue(uint32 InCapacity)
+		: Capacity(FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2u)))
+		, Slots(MakeUnique<FSlot[]>(Capacity))
+		, DequeuePosition(0)
+	{
+		for (uint32 SlotIndex = 0; SlotIndex < Capacity; ++SlotIndex)
+		{
+			Slots[SlotIndex].Sequence = SlotIndex;
+		}
+		EnqueuePosition = 0;
+		NumDropped = 0;
+	}
+
+	/* Safe from any thread. False when the queue is full, the element is dropped and counted */
+	bool Enqueue(const ElementType& Element)
+	{
+		uint32 Position = EnqueuePosition.Load(EMemoryOrder::Relaxed);
+		FSlot* Slot;
+
+		for (;;)
+		{
+			Slot = &Slots[Position & (Capacity - 1)];
+			const int32 Difference = static_cast<int32>(Slot->Sequence.Load() - Position);
+
+			if (Difference == 0)
+			{
+				// Position is updated to the current value when another producer beat us to it
+				if (EnqueuePosition.CompareExchange(Position, Position + 1))
+				{
+					break;
+				}
+			}
+			else if (Difference < 0)
+			{
+				// The consumer hasn't got to this slot since it was last written
+				++NumDropped;
+				return false;
+			}
+			else
+			{
+				Position = EnqueuePosition.Load(EMemoryOrder::Relaxed);
+			}
+		}
+
+		Slot->Element = Element;
+		Slot->Sequence = Position + 1;
+		return true;
+	}
+
+	/* Only ever call from the one consuming thread. False when there is nothing (finished) to pop */
+	bool Dequeue(ElementType& OutElement)
+	{
+		FSlot& Slot = Slots[DequeuePosition & (Capacity - 1)];
+		if (static_cast<int32>(Slot.Sequence.Load() - (DequeuePosition + 1)) < 0)
+		{
+			return false;
+		}
+
+		OutElement = MoveTemp(Slot.Element);
+
+		// Hands the slot back to producers for the next lap around the ring
+		Slot.Sequence = DequeuePosition + Capacity;
+		++DequeuePosition;
+		return true;
+	}
+
+	/* Elements dropped because the queue was full since this was last called */
+	uint32 TakeNumDropped() { return NumDropped.Exchange(0); }
+
+	uint32 GetCapacity() const { return Capacity; }
+
+private:
+	struct FSlot
+	{
+		TAtomic<uint32> Sequence;
+		ElementType Element;
+	};
+
+	const uint32 Capacity;
+	TUniquePtr<FSlot[]> Slots;
+
+	// Producers and the consumer each get their own cache line so they don't keep stealing it from each other
+	uint8 ProducerPadding[PLATFORM_CACHE_LINE_SIZE];
+	TAtomic<uint32> EnqueuePosition;
+	uint8 ConsumerPadding[PLATFORM_CACHE_LINE_SIZE];
+	uint32 DequeuePosition;
+
+	TAtomic<uint32> NumDropped;
+};
+
+/**
+ * Something game code asked the subsystem to do, queued from any thread and carried out on the next post editor tick
+ */
+struct FViewportSyncCommand
+{
+	enum class EType : uint8
+	{
+		// Every synced viewport follows Actor
+		FollowActor,
+
+		// Every synced viewport follows Location
+		FollowLocation,
+
+		// Go back to each viewport's own follow target
+		ClearFollow,
+
+		// Put a marker at Location, named Label
+		MarkEvent,
+	};
+
+	// Weak so an actor destroyed before the command is carried out is skipped rather than dereferenced
+	FWeakObjectPtr Actor;
+	FVector Location;
+	FName Label;
+	EType Type;
+
+	FViewportSyncCommand()
+		: Location(FVector::ZeroVector)
+		, Type(EType::ClearFollow)
+	{}
+};
+
+typedef TViewportSyncMpscQueue<FViewportSyncCommand> FViewportSyncCommandQueue;
+
+/**
+ * Cheap handle for sending commands to the viewport sync subsystem from any thread.
+ *
+ * Get one once on the game thread (UGameViewportSyncStatics::GetCommandSender) and keep it, after that each command is
+ * only a queue push. The queue outlives the subsystem, commands sent after it has gone are just never carried out.
+ * Each send returns false when the queue was full and the command was dropped.
+ */
+class GAMEVIEWPORTSYNC_API FViewportSyncCommandSender
+{
+public:
+	FViewportSyncCommandSender() {}
+
+	explicit FViewportSyncCommandSender(const TSharedPtr<FViewportSyncCommandQueue, ESPMode::ThreadSafe>& InQueue)
+		: Queue(InQueue)
+	{}
+
+	bool IsValid() const { return Queue.IsValid(); }
+
+	/* Make every synced viewport follow Actor, like the global follow target override. Null clears the override */
+	bool FollowActor(const AActor* Actor) const;
+
+	/* Make every synced viewport follow a point in the world, until something else is followed or the follow is cleared */
+	bool FollowLocation(const FVector& Location) const;
+
+	/* Go back to each viewport's own follow target */
+	bool ClearFollow() const;
+
+	/* Mark something that happened at Location, shown in the synced viewports and as an event in CSV captures */
+	bool MarkEvent(const FVector& Location, FName Label = NAME_None) const;
+
+private:
+	bool Send(const FViewportSyncCommand& Command) const;
+
+	TSharedPtr<FViewportSyncCommandQueue, ESPMode::ThreadSafe> Queue;
+};
@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SubclassOf.h"
+
+class AActor;
+class UWorld;
+
+/**
+ * Where a follow group gets its members from
+ */
+enum class EViewportSyncFollowGroupSource : uint8
+{
+	// A fixed list of actors
+	Actors,
+
+	// Every actor of a class, including ones spawned later
+	Class,
+
+	// Every actor with a tag, including ones spawned later
+	Tag
+};
+
+/**
+ * What point of the group the camera orbits
+ */
+enum class EViewportSyncFollowGroupFraming : uint8
+{
+	// Center of the box around every member
+	Bounds,
+
+	// Weighted average of the member locations
+	Centroid
+};
+
+/**
+ * Describes a set of actors for a viewport to follow together
+ */
+struct GAMEVIEWPORTSYNC_API FViewportSyncFollowGroupDesc
+{
+	EViewportSyncFollowGroupSource Source;
+	EViewportSyncFollowGroupFraming Framing;
+
+	// Source == Actors, with optional per actor weights for the centroid (missing weights count as 1)
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	TArray<float> Weights;
+
+	// Source == Class
+	TSubclassOf<AActor> ActorClass;
+
+	// Source == Tag
+	FName Tag;
+
+	FViewportSyncFollowGroupDesc()
+		: Source(EViewportSyncFollowGroupSource::Actors)
+		, Framing(EViewportSyncFollowGroupFraming::Bounds)
+		, Tag(NAME_None)
+	{}
+
+	static FViewportSyncFollowGroupDesc FromActors(const TArray<AActor*>& InActors, EViewportSyncFollowGroupFraming InFraming = EViewportSyncFollowGroupFraming::Bounds);
+	static FViewportSyncFollowGroupDesc FromClass(TSubclassOf<AActor> InActorClass, EViewportSyncFollowGroupFraming InFraming = EViewportSyncFollowGroupFraming::Bounds);
+	static FViewportSyncFollowGroupDesc FromTag(FName InTag, EViewportSyncFollowGroupFraming InFraming = EViewportSyncFollowGroupFraming::Bounds);
+
+	/* Whether an actor belongs in a Class or Tag group */
+	bool Matches(const AActor* Actor) const;
+
+	FText GetDisplayText() const;
+};
+
+/**
+ * Where to point the camera and how much it needs to fit in
+ */
+struct FViewportSyncFollowGroupFrame
+{
+	FVector Center;
+
+	// Distance from Center to the furthest corner of the group's bounds
+	float Radius;
+
+	int32 NumMembers;
+};
+
+/**
+ * The live members of a follow group in one world, and the code to frame them.
+ *
+ * Member locations are gathered into packed x/y/z/weight arrays and reduced four at a time with vector math,
+ * in chunks spread across worker threads once the group is big enough to be worth it. The buffers are kept
+ * between frames so framing the group doesn't allocate.
+ */
+class GAMEVIEWPORTSYNC_API FViewportSyncFollowGroup
+{
+public:
+	explicit FViewportSyncFollowGroup(const FViewportSyncFollowGroupDesc& InDesc);
+
+	const FViewportSyncFollowGroupDesc& GetDesc() const { return Desc; }
+
+	/*
+	 * Collect the members from a world
+	 * @param MapActor	Finds an explicitly listed actor's counterpart in World
+	 */
+	void Rebuild(UWorld* InWorld, TFunctionRef<AActor*(AActor*)> MapActor);
+
+	/* Rebuild before the next frame, e.g. when PIE starts or the viewport switches worlds */
+	void MarkNeedsRebuild() { bNeedsRebuild = true; }
+	bool NeedsRebuild() const { return bNeedsRebuild; }
+
+	/* Picks up actors spawned into our world that belong to a Class or Tag group */
+	void OnActorSpawned(AActor* Actor);
+
+	/* Works out the frame for the group's current locations, false if none of the members are alive */
+	bool ComputeFrame(FViewportSyncFollowGroupFrame& OutFrame);
+
+	int32 Num() const { return Members.Num(); }
+
+	const UWorld* GetWorld() const { return World.Get(); }
+
+	void Reset();
+
+private:
+	void AddMember(AActor* Actor, float Weight);
+
+	/* Sizes the packed buffers for the current member count */
+	void ResizeBuffers();
+
+	struct FChunkResult
+	{
+		FVector Min;
+		FVector Max;
+		FVector WeightedSum;
+		float TotalWeight;
+		int32 NumValid;
+	};
+
+	FViewportSyncFollowGroupDesc Desc;
+
+	TWeakObjectPtr<UWorld> World;
+
+	TArray<TWeakObjectPtr<AActor>> Members;
+	TArray<float> MemberWeights;
+
+	// Packed member locations and weights, NumChunks * ChunkSize long so every chunk can be padded out to a multiple of 4
+	TArray<float> PositionsX;
+	TArray<float> PositionsY;
+	TArray<float> PositionsZ;
+	TArray<float> PackedWeights;
+
+	TArray<FChunkResult> ChunkResults;
+
+	bool bNeedsRebuild;
+};
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ViewportSyncStateTable.h"
+
+/**
+ * Follow targets that haven't spawned yet, and who is waiting on them.
+ *
+ * Nothing looks a pending target up until an actor with a matching name spawns (or a level streams in),
+ * at which point the waiters are handed back to try resolving it once.
+ * An unset handle is used for the global follow override.
+ */
+class FViewportSyncPendingTargets
+{
+public:
+	void Add(const FSoftObjectPath& TargetPath, FViewportSyncHandle Handle)
+	{
+		Remove(Handle);
+		Entries.Emplace(GetActorName(TargetPath), Handle);
+	}
+
+	void Remove(FViewportSyncHandle Handle)
+	{
+		Entries.RemoveAllSwap([Handle](const FEntry& Entry) { return Entry.Handle == Handle; }, false);
+	}
+
+	/* Removes everyone waiting on an actor called ActorName, or for whom ShouldTake says so, calling OnTaken for each */
+	template<typename PredicateType, typename CallbackType>
+	void TakeMatching(FName ActorName, PredicateType ShouldTake, CallbackType OnTaken)
+	{
+		for (int32 EntryIndex = Entries.Num() - 1; EntryIndex >= 0; --EntryIndex)
+		{
+			const FEntry Entry = Entries[EntryIndex];
+			if (Entry.ActorName == ActorName || ShouldTake(Entry.Handle))
+			{
+				Entries.RemoveAtSwap(EntryIndex, 1, false);
+				OnTaken(Entry.Handle);
+			}
+		}
+	}
+
+	template<typename CallbackType>
+	void TakeAll(CallbackType OnTaken)
+	{
+		const TArray<FEntry> TakenEntries = MoveTemp(Entries);
+		Entries.Reset();
+
+		for (const FEntry& Entry : TakenEntries)
+		{
+			OnTaken(Entry.Handle);
+		}
+	}
+
+	bool IsEmpty() const { return Entries.Num() == 0; }
+
+	int32 Num() const { return Entries.Num(); }
+
+	void Reset() { Entries.Reset(); }
+
+private:
+	/* Name of the actor at the end of "/Game/Map.Map:PersistentLevel.ActorName" */
+	static FName GetActorName(const FSoftObjectPath& TargetPath)
+	{
+		const FString& SubPath = TargetPath.GetSubPathString();
+
+		int32 LastDotIndex;
+		if (SubPath.FindLastChar(TEXT('.'), LastDotIndex))
+		{
+			return FName(*SubPath.Mid(LastDotIndex + 1));
+		}
+		return FName(*SubPath);
+	}
+
+	struct FEntry
+	{
+		FName ActorName;
+		FViewportSyncHandle Handle;
+
+		FEntry(FName InActorName, FViewportSyncHandle InHandle)
+			: ActorName(InActorName)
+			, Handle(InHandle)
+		{}
+	};
+
+	TArray<FEntry> Entries;
+};
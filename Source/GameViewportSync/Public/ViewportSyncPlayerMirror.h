@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class APlayerCameraManager;
+class FEditorViewportClient;
+class UWorld;
+
+/**
+ * Shows what one of a PIE world's players sees, copied straight from its camera manager's cached POV.
+ * Unlike following an actor there's no orbit camera or camera lock, the viewport's camera is simply set
+ */
+struct GAMEVIEWPORTSYNC_API FViewportSyncPlayerMirror
+{
+	// Which of the world's player controllers to mirror, in the order the world keeps them (its first local player first). INDEX_NONE when not mirroring
+	int32 PlayerIndex;
+
+	// Used instead of the player's FOV when above 0, e.g. to see more around them
+	float FOVOverride;
+
+	// Moves the camera away from the player's, in the player camera's space (X forward, Y right, Z up)
+	FVector LocationOffset;
+	FRotator RotationOffset;
+
+	FViewportSyncPlayerMirror();
+	explicit FViewportSyncPlayerMirror(int32 InPlayerIndex);
+
+	bool IsEnabled() const { return PlayerIndex != INDEX_NONE; }
+
+	/* Camera manager of the PlayerIndex'th player controller in World, nullptr if there isn't one (yet) */
+	static APlayerCameraManager* FindCameraManager(UWorld* World, int32 PlayerIndex);
+
+	/* Put the viewport's camera where the player's camera was this frame, plus our offsets. False for viewports that aren't perspective */
+	bool Apply(FEditorViewportClient& ViewportClient, const APlayerCameraManager& CameraManager) const;
+
+	static FText GetDisplayText(int32 PlayerIndex);
+};
@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+/**
+ * Layout of the shared memory the plugin publishes synced camera poses into.
+ *
+ * Deliberately free of engine types so external tools can include it as is, see Extras/PoseStreamReader for a reader.
+ * Everything is little endian and naturally aligned, the sizes are checked below and only change with the version.
+ *
+ *   [FViewportSyncPoseStreamHeader]                 64 bytes
+ *   [FViewportSyncPoseStreamRecord] x Capacity      RecordSize bytes each
+ *
+ * There is a single writer (the editor) that writes one record per editor frame into slot WriteCount % Capacity,
+ * then bumps WriteCount. Each record is guarded by a seqlock: Sequence is odd while the slot is being written and
+ * even once it is complete. A reader copies a slot out, and keeps the copy only if Sequence was the same even value
+ * before and after the copy. Readers never block the writer, a reader that falls more than Capacity records behind
+ * just skips ahead.
+ */
+
+#include <stdint.h>
+
+#define VIEWPORTSYNC_POSESTREAM_MAGIC			0x53505356u // "VSPS"
+#define VIEWPORTSYNC_POSESTREAM_VERSION			1u
+#define VIEWPORTSYNC_POSESTREAM_DEFAULT_NAME	"ViewportSyncPoses"
+
+// Records kept in the ring
+#define VIEWPORTSYNC_POSESTREAM_CAPACITY		64u
+
+// Viewports per record, any past this aren't published
+#define VIEWPORTSYNC_POSESTREAM_MAX_VIEWPORTS	16u
+
+enum EViewportSyncPoseFlags
+{
+	// TargetLocation holds the viewport's follow actor (or group center)
+	ViewportSyncPoseFlag_HasTarget		= 1u << 0,
+
+	// The viewport is showing a different PIE instance (server or client) than the default one
+	ViewportSyncPoseFlag_OtherInstance	= 1u << 1,
+};
+
+struct FViewportSyncPoseStreamViewport
+{
+	// Stable for as long as the viewport is open, matches the trajectory recorder's track id
+	uint32_t TrackId;
+
+	// EViewportSyncPoseFlags
+	uint32_t Flags;
+
+	// Unreal units, world space
+	float CameraLocation[3];
+
+	// Degrees: pitch, yaw, roll
+	float CameraRotation[3];
+
+	// Horizontal field of view in degrees
+	float FieldOfView;
+
+	float TargetLocation[3];
+};
+
+struct FViewportSyncPoseStreamRecord
+{
+	// Seqlock, odd while the writer is in this slot
+	volatile uint64_t Sequence;
+
+	// Editor frame counter
+	uint64_t FrameNumber;
+
+	// Seconds, from the editor's monotonic clock
+	double Time;
+
+	uint32_t NumViewports;
+	uint32_t Padding;
+
+	FViewportSyncPoseStreamViewport Viewports[VIEWPORTSYNC_POSESTREAM_MAX_VIEWPORTS];
+};
+
+struct FViewportSyncPoseStreamHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t HeaderSize;
+	uint32_t RecordSize;
+	uint32_t Capacity;
+	uint32_t MaxViewports;
+
+	// Records published since the stream was opened, the newest is in slot (WriteCount - 1) % Capacity
+	volatile uint64_t WriteCount;
+
+	// Process id of the editor, 0 once it has closed the stream
+	volatile uint32_t WriterProcessId;
+
+	uint32_t Reserved[7];
+};
+
+static_assert(sizeof(FViewportSyncPoseStreamViewport) == 48, "Pose stream viewport layout changed, bump VIEWPORTSYNC_POSESTREAM_VERSION");
+static_assert(sizeof(FViewportSyncPoseStreamRecord) == 32 + 48 * VIEWPORTSYNC_POSESTREAM_MAX_VIEWPORTS, "Pose stream record layout changed, bump VIEWPORTSYNC_POSESTREAM_VERSION");
+static_assert(sizeof(FViewportSyncPoseStreamHeader) == 64, "Pose stream header layout changed, bump VIEWPORTSYNC_POSESTREAM_VERSION");
+
+// Total size of the shared memory region
+#define VIEWPORTSYNC_POSESTREAM_SIZE (sizeof(FViewportSyncPoseStreamHeader) + sizeof(FViewportSyncPoseStreamRecord) * VIEWPORTSYNC_POSESTREAM_CAPACITY)
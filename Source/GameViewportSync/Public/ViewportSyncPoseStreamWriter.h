@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ViewportSyncPoseStreamFormat.h"
+
+/**
+ * Publishes synced camera poses into named shared memory for external tools, layout in ViewportSyncPoseStreamFormat.h.
+ *
+ * Poses are written straight into the shared ring slot, there is nothing to serialize or copy and readers never hold us up.
+ */
+class GAMEVIEWPORTSYNC_API FViewportSyncPoseStreamWriter
+{
+public:
+	FViewportSyncPoseStreamWriter()
+		: Region(nullptr)
+		, Header(nullptr)
+		, Records(nullptr)
+		, CurrentRecord(nullptr)
+	{}
+
+	~FViewportSyncPoseStreamWriter()
+	{
+		Close();
+	}
+
+	/* Create (or take over) the shared memory region called Name */
+	bool Open(const FString& Name);
+	void Close();
+
+	bool IsOpen() const { return Header != nullptr; }
+
+	/* Claims the next slot in the ring, readers skip it until EndRecord */
+	void BeginRecord(uint64 FrameNumber, double Time);
+
+	/* Slot for the next viewport in the current record, nullptr when it's full */
+	FViewportSyncPoseStreamViewport* AddViewport();
+
+	/* Publishes the current record */
+	void EndRecord();
+
+private:
+	FPlatformMemory::FSharedMemoryRegion* Region;
+
+	FViewportSyncPoseStreamHeader* Header;
+	FViewportSyncPoseStreamRecord* Records;
+
+	FViewportSyncPoseStreamRecord* CurrentRecord;
+};
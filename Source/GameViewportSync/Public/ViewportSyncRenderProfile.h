@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SceneViewExtension.h"
+#include "ViewportSyncRenderProfile.generated.h"
+
+class FEditorViewportClient;
+class FRenderTarget;
+class FViewport;
+struct FViewportSyncRenderProfileRestoreState;
+
+/**
+ * Named set of rendering overrides for synced viewports, so a side view can skip features it doesn't need.
+ * Show flags are only touched when their override is ticked
+ */
+USTRUCT()
+struct GAMEVIEWPORTSYNC_API FViewportSyncRenderProfile
+{
+	GENERATED_BODY()
+
+	/* Shown in the viewport's Render Profile menu */
+	UPROPERTY(EditAnywhere, Category = "Render Profile")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (InlineEditConditionToggle))
+	bool bOverrideDynamicShadows;
+
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (EditCondition = "bOverrideDynamicShadows"))
+	bool bDynamicShadows;
+
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (InlineEditConditionToggle))
+	bool bOverridePostProcessing;
+
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (EditCondition = "bOverridePostProcessing"))
+	bool bPostProcessing;
+
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (InlineEditConditionToggle))
+	bool bOverrideTranslucency;
+
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (EditCondition = "bOverrideTranslucency"))
+	bool bTranslucency;
+
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (InlineEditConditionToggle))
+	bool bOverrideParticles;
+
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (EditCondition = "bOverrideParticles"))
+	bool bParticles;
+
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (InlineEditConditionToggle))
+	bool bOverrideEditorPrimitives;
+
+	/* Selection outlines, sprites and mode widgets, the editor only things hit proxies are drawn for */
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (EditCondition = "bOverrideEditorPrimitives"))
+	bool bEditorPrimitives;
+
+	/* Scales the distance used to pick mesh LODs, like r.StaticMeshLODDistanceScale but for this viewport only. Higher switches to lower LODs sooner */
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (ClampMin = "0.01", UIMax = "4"))
+	float LODDistanceScale;
+
+	/* Nothing further away than this (in uu) is drawn, 0 is unlimited */
+	UPROPERTY(EditAnywhere, Category = "Render Profile", meta = (ClampMin = "0", UIMax = "100000"))
+	float MaxDrawDistance;
+
+	FViewportSyncRenderProfile();
+	explicit FViewportSyncRenderProfile(FName InName);
+
+	/* Whether applying this profile would change anything */
+	bool HasOverrides() const;
+
+	/* Apply the show flags and draw distance, remembering exactly what they replaced. LOD scaling goes through FViewportSyncRenderProfileViewExtension */
+	void Apply(FEditorViewportClient& ViewportClient, FViewportSyncRenderProfileRestoreState& OutRestoreState) const;
+
+	/* Full, Lite and Overview */
+	static TArray<FViewportSyncRenderProfile> GetDefaultProfiles();
+};
+
+/**
+ * What a render profile replaced on a viewport
+ */
+struct GAMEVIEWPORTSYNC_API FViewportSyncRenderProfileRestoreState
+{
+	// Show flag index and the value it had before
+	TArray<TPair<uint32, bool>, TInlineAllocator<8>> ShowFlags;
+
+	// Far clip override from before, only if the profile set one
+	float FarClipPlaneOverride;
+	bool bOverrodeFarClipPlane;
+
+	bool bApplied;
+
+	FViewportSyncRenderProfileRestoreState()
+		: FarClipPlaneOverride(0.0f)
+		, bOverrodeFarClipPlane(false)
+		, bApplied(false)
+	{}
+
+	/* Put back what the profile replaced, does nothing if it wasn't applied */
+	void Restore(FEditorViewportClient& ViewportClient);
+
+	/* Forget what was replaced without restoring it, for when the viewport is going away */
+	void Reset();
+};
+
+/**
+ * Editor viewport clients don't expose their views' LOD distance factor, so we set it on the views of the viewports that want it as they're set up
+ */
+class GAMEVIEWPORTSYNC_API FViewportSyncRenderProfileViewExtension : public FSceneViewExtensionBase
+{
+public:
+	FViewportSyncRenderProfileViewExtension(const FAutoRegister& AutoRegister)
+		: FSceneViewExtensionBase(AutoRegister)
+	{}
+
+	void SetLODDistanceScale(const FViewport* Viewport, float LODDistanceScale);
+	void RemoveViewport(const FViewport* Viewport);
+
+	// Begin ISceneViewExtension interface
+	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override;
+	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void PreRenderViewFamily_RenderThread(FRHICommandListImmediate& RHICmdList, FSceneViewFamily& InViewFamily) override {}
+	virtual void PreRenderView_RenderThread(FRHICommandListImmediate& RHICmdList, FSceneView& InView) override {}
+	virtual bool IsActiveThisFrame(FViewport* InViewport) const override;
+	// End ISceneViewExtension interface
+
+private:
+	// Only touched on the game thread, views are set up there
+	TMap<const FRenderTarget*, float> LODDistanceScales;
+};
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UViewportSyncSettings;
+
+/**
+ * Picks a screen percentage for the secondary synced viewports from the measured editor frame time.
+ *
+ * Scales down when the frame misses the target and back up once there is headroom again.
+ * The hysteresis band and the cooldown between steps stop it oscillating between two values.
+ */
+class GAMEVIEWPORTSYNC_API FViewportSyncScreenPercentageGovernor
+{
+public:
+	FViewportSyncScreenPercentageGovernor()
+		: SmoothedFrameTime(0.0f)
+		, ScreenPercentage(100)
+		, FramesSinceLastChange(0)
+	{}
+
+	void Reset(int32 InitialScreenPercentage);
+
+	/* Feed in the last frame time, returns true if the screen percentage changed */
+	bool Tick(float FrameTime, const UViewportSyncSettings& Settings);
+
+	int32 GetScreenPercentage() const { return ScreenPercentage; }
+
+private:
+	// Frame time with the spikes smoothed out
+	float SmoothedFrameTime;
+
+	int32 ScreenPercentage;
+
+	int32 FramesSinceLastChange;
+};
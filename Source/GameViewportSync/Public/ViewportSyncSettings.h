@@ -4,8 +4,47 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
+#include "ViewportSyncAutoFollow.h"
+#include "ViewportSyncFollowFilter.h"
+#include "ViewportSyncPlayerMirror.h"
+#include "ViewportSyncPoseStreamFormat.h"
+#include "ViewportSyncRenderProfile.h"
+#include "ViewportSyncStreaming.h"
 #include "ViewportSyncSettings.generated.h"
 
+/**
+ * EViewportSyncFollowFilter for the settings, the follow core has no UObjects so it can't be a UENUM itself.
+ * Same names and order, so one converts straight to the other
+ */
+UENUM()
+enum class EViewportSyncFollowFilterSetting : uint8
+{
+	/* Snap straight to the actor every frame */
+	None,
+
+	/* Move towards the actor at a fixed speed (FollowActorSmoothSpeed) */
+	ConstantSpeed,
+
+	/* Critically damped spring, eases in and out without overshooting */
+	CriticallyDamped,
+
+	/* One Euro filter, smooths out jitter on slow targets but stays responsive on fast ones */
+	OneEuro
+};
+
+/**
+ * When in the frame synced cameras move to their follow targets
+ */
+UENUM()
+enum class EViewportSyncFollowUpdatePoint : uint8
+{
+	/* As soon as the PIE world they watch has ticked its actors, so they're drawn from the frame that was just simulated */
+	AfterWorldTick,
+
+	/* After the editor has drawn everything, cameras show where their target was a frame ago */
+	PostEditorTick
+};
+
 /**
  * 
  */
@@ -16,7 +55,54 @@ class GAMEVIEWPORTSYNC_API UViewportSyncSettings : public UDeveloperSettings
 
 	UViewportSyncSettings()
 		: bSyncByDefault(true)
+		, FollowFilter(EViewportSyncFollowFilterSetting::CriticallyDamped)
 		, FollowActorSmoothSpeed(100.0f)
+		, FollowSmoothTime(0.2f)
+		, FollowOneEuroMinCutoff(1.0f)
+		, FollowOneEuroBeta(0.005f)
+		, FollowPredictionTime(0.0f)
+		, FollowActorMovementThreshold(0.1f)
+		, FollowGroupFramePadding(200.0f)
+		, FollowUpdatePoint(EViewportSyncFollowUpdatePoint::AfterWorldTick)
+		, MirrorFOVOverride(0.0f)
+		, MirrorLocationOffset(FVector::ZeroVector)
+		, MirrorRotationOffset(FRotator::ZeroRotator)
+		, AutoFollowCellSize(2000.0f)
+		, AutoFollowRefreshBudget(2048)
+		, AutoFollowHysteresis(0.2f)
+		, AutoFollowMinRetargetTime(1.0f)
+		, bStagePIEStart(false)
+		, PIEStartImmediateViewports(1)
+		, PIEStartFrameBudgetMs(1.0f)
+		, bSuspendHiddenViewports(true)
+		, bScheduleSyncedViewports(false)
+		, bFocusPriority(false)
+		, FocusedUpdateRate(0.0f)
+		, HoveredUpdateRate(0.0f)
+		, BackgroundUpdateRate(30.0f)
+		, NotForegroundUpdateRate(1.0f)
+		, DefaultStreamingPolicy(EViewportSyncStreamingPolicy::Full)
+		, ReducedStreamingBoost(0.5f)
+		, bPrefetchFollowTargets(false)
+		, PrefetchLookAheadTime(1.0f)
+		, DefaultSyncedViewportRefreshRate(30.0f)
+		, SyncedViewportFrameBudgetMs(8.0f)
+		, bRenderOnlyOnChange(false)
+		, RenderOnChangeSettleTime(0.5f)
+		, bAdaptiveScreenPercentage(false)
+		, AdaptiveTargetFrameRate(60.0f)
+		, AdaptiveMinScreenPercentage(25)
+		, AdaptiveMaxScreenPercentage(100)
+		, AdaptiveScreenPercentageStep(5)
+		, AdaptiveHysteresis(0.1f)
+		, AdaptiveCooldownFrames(15)
+		, bRecordTrajectories(true)
+		, TrajectoryBufferSizeMB(4)
+		, bPublishPoseStream(false)
+		, PoseStreamName(TEXT(VIEWPORTSYNC_POSESTREAM_DEFAULT_NAME))
+		, EventMarkerDuration(5.0f)
+		, RenderProfiles(FViewportSyncRenderProfile::GetDefaultProfiles())
+		, DefaultRenderProfile(TEXT("Full"))
 	{}
 
 	virtual FName GetCategoryName() const override;
@@ -30,12 +116,228 @@ public:
 	UPROPERTY(config, EditAnywhere)
 	bool bShowOverlay;
 
+	/* How newly opened viewports smooth out the actor they follow, can be changed per viewport from its options menu */
+	UPROPERTY(config, EditAnywhere, Category = "Follow")
+	EViewportSyncFollowFilterSetting FollowFilter;
+
 	/*
-	 * Speed at which our viewports should update to the desired actor target
+	 * Speed at which our viewports should update to the desired actor target when using the Constant Speed filter
 	 * This shouldn't be modified unless you *really* need to
 	 */
-	UPROPERTY(config, EditAnywhere, AdvancedDisplay)
+	UPROPERTY(config, EditAnywhere, AdvancedDisplay, Category = "Follow")
 	float FollowActorSmoothSpeed;
+
+	/* Roughly how long (in seconds) the Critically Damped filter takes to catch up with the actor */
+	UPROPERTY(config, EditAnywhere, Category = "Follow", meta = (ClampMin = "0.01", UIMax = "2"))
+	float FollowSmoothTime;
+
+	/* One Euro filter cutoff (in Hz) while the actor is still, lower is smoother */
+	UPROPERTY(config, EditAnywhere, AdvancedDisplay, Category = "Follow", meta = (ClampMin = "0.01", UIMax = "10"))
+	float FollowOneEuroMinCutoff;
+
+	/* How much the One Euro cutoff rises per uu/s of actor speed, higher lags less behind fast actors */
+	UPROPERTY(config, EditAnywhere, AdvancedDisplay, Category = "Follow", meta = (ClampMin = "0", UIMax = "0.1"))
+	float FollowOneEuroBeta;
+
+	/*
+	 * How far ahead (in seconds) to extrapolate the follow actor's velocity, 0 disables prediction.
+	 * With the Critically Damped filter setting this to the smooth time cancels out the lag behind an actor moving at a constant speed
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Follow", meta = (ClampMin = "0", UIMax = "1"))
+	float FollowPredictionTime;
+
+	/*
+	 * How far (in uu) the follow location has to move before we update the viewport camera.
+	 * Stops idle follow actors from dirtying the viewport every frame
+	 */
+	UPROPERTY(config, EditAnywhere, AdvancedDisplay, Category = "Follow", meta = (ClampMin = "0"))
+	float FollowActorMovementThreshold;
+
+	/* Extra room (in uu) left around a followed group so its outermost actors aren't right at the edge of the viewport */
+	UPROPERTY(config, EditAnywhere, Category = "Follow", meta = (ClampMin = "0", UIMax = "2000"))
+	float FollowGroupFramePadding;
+
+	/* When synced cameras move to their follow targets, takes effect the next time PIE starts */
+	UPROPERTY(config, EditAnywhere, AdvancedDisplay, Category = "Follow")
+	EViewportSyncFollowUpdatePoint FollowUpdatePoint;
+
+	/* FOV viewports mirroring a player use instead of the player's own, 0 keeps the player's */
+	UPROPERTY(config, EditAnywhere, Category = "Mirror", meta = (ClampMin = "0", ClampMax = "170"))
+	float MirrorFOVOverride;
+
+	/* Where viewports mirroring a player sit relative to the player's camera, X forward, Y right, Z up */
+	UPROPERTY(config, EditAnywhere, Category = "Mirror")
+	FVector MirrorLocationOffset;
+
+	/* Added to the player's camera rotation for viewports mirroring a player */
+	UPROPERTY(config, EditAnywhere, Category = "Mirror")
+	FRotator MirrorRotationOffset;
+
+	/* Size (in uu) of the grid cells auto follow sorts its candidates into, around the distance candidates are usually apart works best. Takes effect for new rules */
+	UPROPERTY(config, EditAnywhere, AdvancedDisplay, Category = "Auto Follow", meta = (ClampMin = "100", UIMax = "20000"))
+	float AutoFollowCellSize;
+
+	/* Candidates each auto following viewport re-checks the location of per frame, 0 re-checks all of them. Lower is cheaper but notices movement later */
+	UPROPERTY(config, EditAnywhere, AdvancedDisplay, Category = "Auto Follow", meta = (ClampMin = "0", UIMax = "10000"))
+	int32 AutoFollowRefreshBudget;
+
+	/* How much closer (as a fraction of the current target's distance) a candidate has to be before auto follow switches to it */
+	UPROPERTY(config, EditAnywhere, Category = "Auto Follow", meta = (ClampMin = "0", ClampMax = "0.9"))
+	float AutoFollowHysteresis;
+
+	/* Seconds auto follow stays on a target before it looks for a better one */
+	UPROPERTY(config, EditAnywhere, Category = "Auto Follow", meta = (ClampMin = "0", UIMax = "10"))
+	float AutoFollowMinRetargetTime;
+
+	/*
+	 * Instead of setting up every synced viewport in the frame PIE starts in, only set up the ones nearest the PIE viewport
+	 * and spread the rest over the following frames. Takes our share out of the PIE start hitch
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "PIE Start")
+	bool bStagePIEStart;
+
+	/* How many of the viewports nearest the PIE viewport are still set up in the PIE start frame */
+	UPROPERTY(config, EditAnywhere, Category = "PIE Start", meta = (EditCondition = "bStagePIEStart", ClampMin = "0", UIMax = "4"))
+	int32 PIEStartImmediateViewports;
+
+	/* Time (in ms) each following frame may spend setting up viewports, at least one is set up per frame */
+	UPROPERTY(config, EditAnywhere, Category = "PIE Start", meta = (EditCondition = "bStagePIEStart", ClampMin = "0", UIMax = "8"))
+	float PIEStartFrameBudgetMs;
+
+	/* Stop rendering and following in synced viewports nobody can see (behind another tab, collapsed or minimized) until they're shown again */
+	UPROPERTY(config, EditAnywhere, Category = "Scheduling")
+	bool bSuspendHiddenViewports;
+
+	/*
+	 * Instead of rendering every synced viewport every frame, redraw them at their own refresh rate
+	 * staggered across frames and within the frame budget below. The PIE viewport is never throttled
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Scheduling")
+	bool bScheduleSyncedViewports;
+
+	/* Refresh rate (in Hz) newly synced viewports start with when scheduling. 0 redraws every frame */
+	UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (EditCondition = "bScheduleSyncedViewports", ClampMin = "0", UIMax = "120"))
+	float DefaultSyncedViewportRefreshRate;
+
+	/* Max time (in ms) that all synced viewports together may spend redrawing in a single frame. 0 is unlimited */
+	UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (EditCondition = "bScheduleSyncedViewports", ClampMin = "0", UIMax = "33"))
+	float SyncedViewportFrameBudgetMs;
+
+	/*
+	 * Stop redrawing a synced viewport while its PIE world isn't advancing (paused, or stopped at a breakpoint) and its camera isn't moving,
+	 * it keeps showing its last frame until either changes
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Scheduling")
+	bool bRenderOnlyOnChange;
+
+	/* Time (in seconds) nothing has to change for before a viewport stops redrawing, long enough for temporal AA to settle the last frame */
+	UPROPERTY(config, EditAnywhere, Category = "Scheduling", meta = (EditCondition = "bRenderOnlyOnChange", ClampMin = "0", UIMax = "2"))
+	float RenderOnChangeSettleTime;
+
+	/*
+	 * Update synced viewports (rendering and following) at a rate that depends on how much attention they're getting.
+	 * When the editor is throttling itself because it isn't in the foreground, every synced viewport drops to the not foreground rate
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Focus Priority")
+	bool bFocusPriority;
+
+	/* Rate (in Hz) for the viewport with keyboard focus, or the last one clicked in. 0 updates every frame */
+	UPROPERTY(config, EditAnywhere, Category = "Focus Priority", meta = (EditCondition = "bFocusPriority", ClampMin = "0", UIMax = "120"))
+	float FocusedUpdateRate;
+
+	/* Rate (in Hz) for the viewport under the mouse. 0 updates every frame */
+	UPROPERTY(config, EditAnywhere, Category = "Focus Priority", meta = (EditCondition = "bFocusPriority", ClampMin = "0", UIMax = "120"))
+	float HoveredUpdateRate;
+
+	/* Rate (in Hz) for every other synced viewport, e.g. while you're playing in the PIE viewport. 0 updates every frame */
+	UPROPERTY(config, EditAnywhere, Category = "Focus Priority", meta = (EditCondition = "bFocusPriority", ClampMin = "0", UIMax = "120"))
+	float BackgroundUpdateRate;
+
+	/* Rate (in Hz) for all synced viewports while the editor is in the background. 0 updates every frame */
+	UPROPERTY(config, EditAnywhere, Category = "Focus Priority", meta = (EditCondition = "bFocusPriority", ClampMin = "0", UIMax = "60"))
+	float NotForegroundUpdateRate;
+
+	/* What extra streaming newly opened viewports ask the PIE world for around their camera, can be changed per viewport from its options menu */
+	UPROPERTY(config, EditAnywhere, Category = "Streaming")
+	EViewportSyncStreamingPolicy DefaultStreamingPolicy;
+
+	/* Texture streaming boost for the views the plugin adds for Reduced viewports, below 1 asks for lower resolution mips */
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta = (ClampMin = "0.1", ClampMax = "1"))
+	float ReducedStreamingBoost;
+
+	/* Also stream textures in around where each follow camera is heading, so they're loaded by the time it gets there */
+	UPROPERTY(config, EditAnywhere, Category = "Streaming")
+	bool bPrefetchFollowTargets;
+
+	/* How far ahead (in seconds) to prefetch along the follow target's velocity */
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta = (EditCondition = "bPrefetchFollowTargets", ClampMin = "0", UIMax = "5"))
+	float PrefetchLookAheadTime;
+
+	/* Lower the screen percentage of synced viewports (never the PIE viewport) when the editor misses the target frame rate */
+	UPROPERTY(config, EditAnywhere, Category = "Adaptive Resolution")
+	bool bAdaptiveScreenPercentage;
+
+	/* Frame rate we try to keep the PIE session at */
+	UPROPERTY(config, EditAnywhere, Category = "Adaptive Resolution", meta = (EditCondition = "bAdaptiveScreenPercentage", ClampMin = "1", UIMax = "144"))
+	float AdaptiveTargetFrameRate;
+
+	UPROPERTY(config, EditAnywhere, Category = "Adaptive Resolution", meta = (EditCondition = "bAdaptiveScreenPercentage", ClampMin = "10", ClampMax = "100"))
+	int32 AdaptiveMinScreenPercentage;
+
+	UPROPERTY(config, EditAnywhere, Category = "Adaptive Resolution", meta = (EditCondition = "bAdaptiveScreenPercentage", ClampMin = "10", ClampMax = "100"))
+	int32 AdaptiveMaxScreenPercentage;
+
+	/* How much the screen percentage changes per step */
+	UPROPERTY(config, EditAnywhere, Category = "Adaptive Resolution", meta = (EditCondition = "bAdaptiveScreenPercentage", ClampMin = "1", ClampMax = "50"))
+	int32 AdaptiveScreenPercentageStep;
+
+	/* Fraction of the target frame time we have to be over (or under) before scaling down (or up) */
+	UPROPERTY(config, EditAnywhere, Category = "Adaptive Resolution", AdvancedDisplay, meta = (EditCondition = "bAdaptiveScreenPercentage", ClampMin = "0", ClampMax = "0.5"))
+	float AdaptiveHysteresis;
+
+	/* Minimum number of frames between steps, gives the last change time to show up in the frame time */
+	UPROPERTY(config, EditAnywhere, Category = "Adaptive Resolution", AdvancedDisplay, meta = (EditCondition = "bAdaptiveScreenPercentage", ClampMin = "1"))
+	int32 AdaptiveCooldownFrames;
+
+	/* Keep a rolling recording of every synced viewport's camera and follow target, see the ViewportSync.Trajectory console commands */
+	UPROPERTY(config, EditAnywhere, Category = "Recording")
+	bool bRecordTrajectories;
+
+	/* Memory (in MB) for the recording, the oldest part is overwritten once it's full. 4 MB holds about 10 minutes of 4 viewports at 60 fps */
+	UPROPERTY(config, EditAnywhere, Category = "Recording", meta = (EditCondition = "bRecordTrajectories", ClampMin = "1", UIMax = "64"))
+	int32 TrajectoryBufferSizeMB;
+
+	/* Publish every synced camera pose into shared memory for external tools, see Extras/PoseStreamReader */
+	UPROPERTY(config, EditAnywhere, Category = "Recording")
+	bool bPublishPoseStream;
+
+	/* Name of the shared memory region external tools open */
+	UPROPERTY(config, EditAnywhere, Category = "Recording", meta = (EditCondition = "bPublishPoseStream"))
+	FString PoseStreamName;
+
+	/* How long (in seconds) markers for events game code sends through the command sender stay up in the synced viewports */
+	UPROPERTY(config, EditAnywhere, Category = "Recording", meta = (ClampMin = "0", UIMax = "30"))
+	float EventMarkerDuration;
+
+	/* Show flag, LOD and draw distance overrides synced viewports can pick between from their options menu */
+	UPROPERTY(config, EditAnywhere, Category = "Render Profiles", meta = (TitleProperty = "Name"))
+	TArray<FViewportSyncRenderProfile> RenderProfiles;
+
+	/* Profile a synced viewport uses until another one is picked for it */
+	UPROPERTY(config, EditAnywhere, Category = "Render Profiles")
+	FName DefaultRenderProfile;
+
+	/* nullptr if there's no profile called ProfileName */
+	const FViewportSyncRenderProfile* FindRenderProfile(FName ProfileName) const;
+
+	/* Follow filter and tuning above, what newly opened viewports start with */
+	FViewportSyncFollowFilterSettings MakeFollowFilterSettings() const;
+
+	/* Mirror of a player with the FOV and offsets above, what the viewport menu sets up */
+	FViewportSyncPlayerMirror MakePlayerMirror(int32 PlayerIndex) const;
+
+	/* Nearest actor of a class to the first player with the hysteresis above, what the viewport menu sets up */
+	FViewportSyncAutoFollowRule MakeNearestAutoFollowRule(TSubclassOf<AActor> ActorClass) const;
 };
 
 // INLINES
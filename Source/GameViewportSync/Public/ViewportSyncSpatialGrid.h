@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+/**
+ * Loose uniform grid of actors over the XY plane, for finding candidates near a point without looking at all of them.
+ *
+ * Each actor is bucketed by the location it had when it was last refreshed. Refresh walks a slice of the actors per call
+ * and moves the ones that changed cell, so keeping thousands of moving actors indexed costs a bounded amount per frame.
+ * Queries work on those cached locations, which can be a few frames old.
+ */
+class GAMEVIEWPORTSYNC_API FViewportSyncSpatialGrid
+{
+public:
+	explicit FViewportSyncSpatialGrid(float InCellSize);
+
+	void Add(AActor* Actor);
+
+	/* Re-bucket up to MaxActors actors (all of them when <= 0), carrying on from where the last call stopped. Drops destroyed actors */
+	void Refresh(int32 MaxActors);
+
+	/*
+	 * Closest actor to Origin, by cached location
+	 * @param MaxDistance		Ignore anything further away than this, 0 for no limit
+	 * @param OutDistanceSquared	Squared distance to the actor found
+	 */
+	AActor* FindNearest(const FVector& Origin, float MaxDistance, float& OutDistanceSquared) const;
+
+	/* Every actor within Radius of Origin (by cached location), or every actor when Radius <= 0 */
+	void ForEachInRadius(const FVector& Origin, float Radius, TFunctionRef<void(AActor* Actor, const FVector& Location)> Callback) const;
+
+	/*
+	 * Actors within MaxDistance of Origin (by cached location, 0 for no limit), a ring of cells at a time starting from Origin's cell
+	 * @param ShouldContinue	Called before each ring with the closest anything in it can be to Origin (in XY), return false to stop there
+	 */
+	void ForEachOutward(const FVector& Origin, float MaxDistance, TFunctionRef<bool(float RingDistance)> ShouldContinue, TFunctionRef<void(AActor* Actor, const FVector& Location)> Callback) const;
+
+	int32 Num() const { return Entries.Num(); }
+
+	void Reset();
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FVector Location;
+		uint64 CellKey;
+
+		// Where this entry is in its cell's list, so it can be taken out without a search
+		int32 IndexInCell;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+	static uint64 GetCellKey(FIntPoint Cell);
+
+	void AddToCell(int32 EntryIndex, FIntPoint Cell);
+	void RemoveFromCell(int32 EntryIndex);
+	void RemoveEntry(int32 EntryIndex);
+
+	/* Calls Callback for every live actor in a cell */
+	template<typename CallbackType>
+	void ForEachInCell(FIntPoint Cell, CallbackType&& Callback) const;
+
+	float CellSize;
+	float InvCellSize;
+
+	TArray<FEntry> Entries;
+
+	// Entry indices by cell, cells are kept once they've been used since actors tend to come back
+	TMap<uint64, TArray<int32>> Cells;
+
+	// Every cell that has ever had something in it is inside these, bounds how far an unlimited search goes
+	FIntPoint MinCell;
+	FIntPoint MaxCell;
+
+	// Next entry Refresh looks at
+	int32 RefreshCursor;
+};
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ViewportSyncStreaming.generated.h"
+
+class FEditorViewportClient;
+class UWorld;
+
+/**
+ * What streaming a synced viewport asks for on top of the engine's own.
+ *
+ * Only the plugin's extra views are controlled: the engine still adds a texture streaming view for a viewport whenever it
+ * draws it, so none of these stop the textures it shows from streaming in at full resolution.
+ */
+UENUM()
+enum class EViewportSyncStreamingPolicy : uint8
+{
+	/* Left as the engine has it, plus prefetching ahead of the follow target when that's turned on */
+	Full,
+
+	/*
+	 * The camera is taken back out of the world's rendered view locations so landscape grass and HLODs aren't streamed in around it,
+	 * and the plugin's texture streaming views for it (including prefetching) ask for lower resolution mips (ReducedStreamingBoost)
+	 */
+	Reduced,
+
+	/* The camera is taken back out of the world's rendered view locations and the plugin adds no streaming views for it, not even prefetching */
+	None
+};
+
+/**
+ * What synced viewports feed into streaming
+ */
+struct GAMEVIEWPORTSYNC_API FViewportSyncStreaming
+{
+	/* Tell texture streaming about a view from ViewLocation with the viewport's size and FOV. Boost below 1 streams lower resolution mips */
+	static void AddView(const FEditorViewportClient& ViewportClient, const FVector& ViewLocation, float BoostFactor);
+
+	/*
+	 * Drawing a perspective viewport records where it was drawn from in its world, which streams content (landscape grass, HLODs) in around it.
+	 * Takes one of those back out again, false if it wasn't there
+	 */
+	static bool RemoveRenderedViewLocation(UWorld* World, const FVector& ViewLocation);
+
+	static FText GetDisplayText(EViewportSyncStreamingPolicy Policy);
+};
@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * One recorded camera pose, with where the camera's follow target was at the time
+ */
+struct FViewportSyncTrajectorySample
+{
+	// Seconds since the session started
+	double Time;
+
+	FVector CameraLocation;
+	FRotator CameraRotation;
+
+	bool bHasTarget;
+	FVector TargetLocation;
+};
+
+/**
+ * Everything one viewport recorded during a session
+ */
+struct FViewportSyncTrajectoryTrack
+{
+	uint16 TrackId;
+
+	// Layout config key of the viewport, lets a saved recording find the same viewport again
+	FName Name;
+
+	TArray<FViewportSyncTrajectorySample> Samples;
+};
+
+/**
+ * A decoded recording, from the recorder's memory or a file
+ */
+struct GAMEVIEWPORTSYNC_API FViewportSyncTrajectory
+{
+	uint32 SessionId;
+
+	TArray<FViewportSyncTrajectoryTrack> Tracks;
+
+	FViewportSyncTrajectory()
+		: SessionId(0)
+	{}
+
+	/* Seconds covered by the longest track */
+	double GetDuration() const;
+
+	/* Camera pose of a track at Time, interpolated between the samples either side. False if the track has no samples */
+	bool Evaluate(const FViewportSyncTrajectoryTrack& Track, double Time, FViewportSyncTrajectorySample& OutSample) const;
+
+	const FViewportSyncTrajectoryTrack* FindTrack(FName Name) const;
+
+	void Reset()
+	{
+		SessionId = 0;
+		Tracks.Reset();
+	}
+};
+
+/**
+ * Always-on flight recorder for synced viewport cameras and their follow targets.
+ *
+ * Memory is a fixed ring of blocks allocated up front, recording overwrites the oldest block once it is full and never allocates.
+ * Samples are quantized (1/8 uu for locations, 16 bits per rotation axis, 0.1 ms for time) and stored as zigzag varint deltas
+ * against the same track's previous sample. The first sample of a track in each block is stored against zero, so every block
+ * can be decoded on its own after the ones before it have been overwritten.
+ *
+ * Call BeginFrame, AddSample for each viewport and EndFrame once per tick.
+ */
+class GAMEVIEWPORTSYNC_API FViewportSyncTrajectoryRecorder
+{
+public:
+	// Track ids past this aren't recorded
+	static const int32 MaxTracks = 32;
+
+	FViewportSyncTrajectoryRecorder();
+
+	/* (Re)allocate the ring, throws away anything recorded if the size changes. 0 disables recording */
+	void Initialize(int32 BufferSizeBytes);
+
+	bool IsEnabled() const { return BlockData.Num() > 0; }
+
+	/* Starts a new session, its samples are timed from now */
+	void BeginSession();
+
+	/* Name a track so a saved recording can be matched back to its viewport */
+	void SetTrackName(uint16 TrackId, FName Name);
+
+	void BeginFrame();
+	void AddSample(uint16 TrackId, const FVector& CameraLocation, const FRotator& CameraRotation, const FVector* TargetLocation);
+	void EndFrame();
+
+	/* Decode the most recent session */
+	void Decode(FViewportSyncTrajectory& OutTrajectory) const;
+
+	/* Write the whole ring, oldest block first, in the same format LoadFromFile reads */
+	bool SaveToFile(const FString& FilePath) const;
+
+	/* Read a file written by SaveToFile and decode its most recent session */
+	static bool LoadFromFile(const FString& FilePath, FViewportSyncTrajectory& OutTrajectory);
+
+	/* Bytes of the ring holding recorded data */
+	int32 GetUsedBytes() const;
+
+private:
+	struct FQuantizedSample
+	{
+		int32 CameraLocation[3];
+		int32 CameraRotation[3];
+		int32 TargetLocation[3];
+		uint16 TrackId;
+		bool bHasTarget;
+	};
+
+	struct FBlockInfo
+	{
+		// Increases with every block started, 0 for blocks never written
+		uint32 Sequence;
+		uint32 SessionId;
+
+		// Seconds since the session started, for the first frame in the block
+		double BaseTime;
+
+		int32 UsedBytes;
+	};
+
+	/* Moves on to the next block in the ring, overwriting whatever it held */
+	void StartBlock(double Time);
+
+	void Serialize(TArray<uint8>& OutBytes) const;
+	static bool DecodeBytes(const TArray<uint8>& Bytes, FViewportSyncTrajectory& OutTrajectory);
+
+	TArray<uint8> BlockData;
+	TArray<FBlockInfo> Blocks;
+	int32 NumBlocks;
+
+	int32 CurrentBlock;
+	uint32 NextSequence;
+	uint32 SessionId;
+	double SessionStartTime;
+
+	// Time of the last frame written to the current block, in 0.1 ms ticks since the block's base time
+	int64 LastFrameTicks;
+
+	// Delta compression state, the previous sample of each track in the current block
+	FQuantizedSample PreviousSamples[MaxTracks];
+	uint32 TracksInBlock;
+
+	// Samples for the frame being built
+	FQuantizedSample FrameSamples[MaxTracks];
+	int32 NumFrameSamples;
+	double FrameTime;
+
+	FName TrackNames[MaxTracks];
+};
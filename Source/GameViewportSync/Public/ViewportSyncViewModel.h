@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Layout/Visibility.h"
+
+class AActor;
+
+/**
+ * Display state for a synced viewport's overlay and menu row.
+ *
+ * Text is formatted once when something it depends on changes (follow actor, override, settings) rather than
+ * every paint, widgets either read the cached values or listen to OnChanged and push them into themselves.
+ */
+class GAMEVIEWPORTSYNC_API FViewportSyncViewModel : public TSharedFromThis<FViewportSyncViewModel>
+{
+public:
+	FViewportSyncViewModel();
+
+	/* Recompute everything, broadcasts OnChanged if anything visible changed */
+	void Update(const TSoftObjectPtr<AActor>& FollowActor, const TSoftObjectPtr<AActor>& GlobalFollowActorOverride, bool bHasGlobalFollowLocationOverride, const FText& FollowGroupName, const FText& MirrorPlayerName, const FText& AutoFollowName, bool bSync, bool bSuspended, int32 ScreenPercentage, const FText& WorldName);
+
+	FText GetFollowText() const { return FollowText; }
+	FText GetScreenPercentageText() const { return ScreenPercentageText; }
+	FText GetWorldText() const { return WorldText; }
+
+	EVisibility GetOverlayVisibility() const { return OverlayVisibility; }
+	EVisibility GetFollowVisibility() const { return FollowVisibility; }
+	EVisibility GetClearFollowVisibility() const { return ClearFollowVisibility; }
+	EVisibility GetScreenPercentageVisibility() const { return ScreenPercentageVisibility; }
+	EVisibility GetWorldVisibility() const { return WorldVisibility; }
+	EVisibility GetSuspendedVisibility() const { return SuspendedVisibility; }
+
+	FSimpleMulticastDelegate& OnChanged() { return ChangedEvent; }
+
+private:
+	FText FollowText;
+	FText ScreenPercentageText;
+	FText WorldText;
+
+	EVisibility OverlayVisibility;
+	EVisibility FollowVisibility;
+	EVisibility ClearFollowVisibility;
+	EVisibility ScreenPercentageVisibility;
+	EVisibility WorldVisibility;
+	EVisibility SuspendedVisibility;
+
+	FSimpleMulticastDelegate ChangedEvent;
+};
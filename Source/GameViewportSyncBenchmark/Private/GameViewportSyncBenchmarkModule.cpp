@@ -0,0 +1,62 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "HAL/IConsoleManager.h"
+#include "ViewportSyncBenchmark.h"
+
+#define LOCTEXT_NAMESPACE "FGameViewportSyncBenchmarkModule"
+
+class FGameViewportSyncBenchmarkModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override
+	{
+		BenchmarkCommand = IConsoleManager::Get().RegisterConsoleCommand(
+			TEXT("ViewportSync.Benchmark"),
+			TEXT("Benchmarks the Viewport Sync plugin over a PIE session and writes a JSON report.\n")
+			TEXT("Usage: ViewportSync.Benchmark [Viewports=4] [Targets=16] [Group|Auto] [Staged] [Streaming=Full|Reduced|None] [Prefetch]\n")
+			TEXT("                              [FollowUpdate=AfterWorldTick|PostEditorTick] [Latency] [Frames=300] [WarmupFrames=30] [Report=<path>]\n")
+			TEXT("                              [MaxTickMs=] [MaxPIEStartMs=] [MaxPIEEndMs=] [MaxAllocsPerTick=] [MaxFollowLatencyFrames=] [Exit]\n")
+			TEXT("Group makes every viewport follow all of the targets as one group, Auto makes them follow whichever target is nearest the player.\n")
+			TEXT("Staged turns on staged PIE start for the run, the staged part is reported separately from PIE start.\n")
+			TEXT("Streaming and Prefetch set the viewports' streaming policy, compare the memory and streaming numbers between runs.\n")
+			TEXT("Latency measures how many frames each camera lags behind its target, compare FollowUpdate points with it.\n")
+			TEXT("Thresholds left out are not checked. With Exit the editor quits with a non-zero code when a threshold fails."),
+			FConsoleCommandWithArgsDelegate::CreateRaw(this, &FGameViewportSyncBenchmarkModule::RunBenchmark),
+			ECVF_Default
+		);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		if (BenchmarkCommand != nullptr)
+		{
+			IConsoleManager::Get().UnregisterConsoleObject(BenchmarkCommand);
+			BenchmarkCommand = nullptr;
+		}
+
+		Benchmark.Reset();
+	}
+
+private:
+	void RunBenchmark(const TArray<FString>& Args)
+	{
+		if (Benchmark.IsValid() && !Benchmark->IsFinished())
+		{
+			UE_LOG(LogViewportSyncBenchmark, Warning, TEXT("A Viewport Sync benchmark is already running"));
+			return;
+		}
+
+		Benchmark = MakeUnique<FViewportSyncBenchmark>(FViewportSyncBenchmarkConfig::FromArgs(Args));
+		Benchmark->Start();
+	}
+
+	IConsoleObject* BenchmarkCommand = nullptr;
+
+	TUniquePtr<FViewportSyncBenchmark> Benchmark;
+};
+
+#undef LOCTEXT_NAMESPACE
+	
+IMPLEMENT_MODULE(FGameViewportSyncBenchmarkModule, GameViewportSyncBenchmark)
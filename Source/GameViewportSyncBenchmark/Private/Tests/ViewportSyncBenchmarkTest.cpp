@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncBenchmark.h"
+
+// UE Includes
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/* Waits for a benchmark run to finish, then fails the test with whatever thresholds it exceeded */
+class FWaitForViewportSyncBenchmark : public IAutomationLatentCommand
+{
+public:
+	FWaitForViewportSyncBenchmark(FAutomationTestBase* InTest, TSharedRef<FViewportSyncBenchmark> InBenchmark, bool bInCheckLatency)
+		: Test(InTest)
+		, Benchmark(InBenchmark)
+		, bCheckLatency(bInCheckLatency)
+	{}
+
+	virtual bool Update() override
+	{
+		if (!Benchmark->IsFinished())
+		{
+			return false;
+		}
+
+		for (const FString& Failure : Benchmark->GetFailures())
+		{
+			Test->AddError(Failure);
+		}
+
+		if (bCheckLatency)
+		{
+			Test->TestTrue(TEXT("Follow latency was measured"), Benchmark->GetFollowLatencyFrames().Num() > 0);
+			Test->TestEqual(TEXT("Every camera was looking at a recent target location"), Benchmark->GetNumUnmatchedLatencySamples(), 0);
+		}
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	TSharedRef<FViewportSyncBenchmark> Benchmark;
+	bool bCheckLatency;
+};
+
+/* The console command's build machine run: times the subsystem's tick and PIE start/end and fails on the same thresholds as the README example */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncBenchmarkTest, "ViewportSync.Benchmark.Tick", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncBenchmarkTest::RunTest(const FString& Parameters)
+{
+	FViewportSyncBenchmarkConfig Config;
+	Config.NumViewports = 4;
+	Config.NumFollowTargets = 16;
+	Config.MeasuredFrames = 300;
+	Config.MaxTickMs = 0.5f;
+	Config.MaxAllocsPerTick = 1.0f;
+	Config.ReportPath = FPaths::ProjectSavedDir() / TEXT("ViewportSync") / TEXT("BenchmarkTest.json");
+
+	const TSharedRef<FViewportSyncBenchmark> Benchmark = MakeShared<FViewportSyncBenchmark>(Config);
+	Benchmark->Start();
+
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForViewportSyncBenchmark(this, Benchmark, false));
+	return true;
+}
+
+/* Moving cameras after the world ticks has them looking at where their targets are in the frame being drawn */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowLatencyTest, "ViewportSync.Benchmark.FollowLatency", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowLatencyTest::RunTest(const FString& Parameters)
+{
+	FViewportSyncBenchmarkConfig Config;
+	Config.NumViewports = 2;
+	Config.NumFollowTargets = 2;
+	Config.WarmupFrames = 10;
+	Config.MeasuredFrames = 60;
+	Config.FollowUpdatePoint = EViewportSyncFollowUpdatePoint::AfterWorldTick;
+	Config.bMeasureLatency = true;
+	Config.MaxFollowLatencyFrames = 0.0f;
+	Config.ReportPath = FPaths::ProjectSavedDir() / TEXT("ViewportSync") / TEXT("FollowLatencyTest.json");
+
+	const TSharedRef<FViewportSyncBenchmark> Benchmark = MakeShared<FViewportSyncBenchmark>(Config);
+	Benchmark->Start();
+
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForViewportSyncBenchmark(this, Benchmark, true));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
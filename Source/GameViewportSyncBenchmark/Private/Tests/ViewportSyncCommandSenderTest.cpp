@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameViewportSyncStatics.h"
+#include "SyncViewportSubsystem.h"
+
+// UE Includes
+#include "Editor.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ViewportSyncCommandSenderTest
+{
+	static const int32 NumSenders = 8;
+	static const int32 NumEventsPerSender = 256;
+
+	// Give up if PIE hasn't started and carried out the commands after this many frames
+	static const int32 MaxFramesToWait = 600;
+}
+
+/* Waits for the subsystem to pick up the queued follow command once PIE is running */
+class FWaitForViewportSyncFollowLocation : public IAutomationLatentCommand
+{
+public:
+	FWaitForViewportSyncFollowLocation(FAutomationTestBase* InTest, const FVector& InExpectedLocation)
+		: Test(InTest)
+		, ExpectedLocation(InExpectedLocation)
+		, NumFrames(0)
+	{}
+
+	virtual bool Update() override
+	{
+		const USyncViewportSubsystem* Subsystem = GEditor->GetEditorSubsystem<USyncViewportSubsystem>();
+		if (Subsystem != nullptr && Subsystem->GetGlobalViewportFollowLocationOverride().IsSet())
+		{
+			Test->TestEqual(TEXT("Viewports follow the location that was sent"), Subsystem->GetGlobalViewportFollowLocationOverride().GetValue(), ExpectedLocation);
+			return true;
+		}
+
+		if (++NumFrames > ViewportSyncCommandSenderTest::MaxFramesToWait)
+		{
+			Test->AddError(FString::Printf(TEXT("The follow command wasn't carried out within %d frames"), ViewportSyncCommandSenderTest::MaxFramesToWait));
+			return true;
+		}
+		return false;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	FVector ExpectedLocation;
+	int32 NumFrames;
+};
+
+/* Game code in another module sends commands from worker threads through the public statics, the subsystem carries them out once PIE ticks */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncCommandSenderTest, "ViewportSync.CommandSender", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncCommandSenderTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncCommandSenderTest;
+
+	if (GEditor->PlayWorld != nullptr)
+	{
+		AddError(TEXT("Stop the current PIE session before running this test"));
+		return false;
+	}
+
+	// Once on the game thread, then shared with every sender
+	const FViewportSyncCommandSender Sender = UGameViewportSyncStatics::GetCommandSender();
+	if (!TestTrue(TEXT("Command sender is valid"), Sender.IsValid()))
+	{
+		return false;
+	}
+
+	TAtomic<int32> NumSent(0);
+	ParallelFor(NumSenders, [&Sender, &NumSent](int32 SenderIndex)
+	{
+		for (int32 EventIndex = 0; EventIndex < NumEventsPerSender; ++EventIndex)
+		{
+			if (Sender.MarkEvent(FVector(SenderIndex * 100.0f, EventIndex * 10.0f, 0.0f)))
+			{
+				++NumSent;
+			}
+		}
+	});
+
+	TestEqual(TEXT("Every event fit in the queue"), NumSent.Load(), NumSenders * NumEventsPerSender);
+
+	// Sent after the events so it's the last follow command, the one that ends up in effect
+	const FVector FollowLocation(1234.0f, -567.0f, 89.0f);
+	Async(EAsyncExecution::ThreadPool, [&Sender, &FollowLocation]()
+	{
+		Sender.FollowLocation(FollowLocation);
+	}).Wait();
+
+	ADD_LATENT_AUTOMATION_COMMAND(FStartPIECommand(false));
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForViewportSyncFollowLocation(this, FollowLocation));
+	ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
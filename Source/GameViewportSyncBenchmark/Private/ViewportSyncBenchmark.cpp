@@ -0,0 +1,715 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncBenchmark.h"
+#include "ViewportSyncAllocationCounter.h"
+#include "SyncViewportSubsystem.h"
+#include "ViewportSyncSettings.h"
+
+// UE Includes
+#include "Editor.h"
+#include "LevelEditorViewport.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "ContentStreaming.h"
+#include "Engine/LevelStreaming.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+
+DEFINE_LOG_CATEGORY(LogViewportSyncBenchmark);
+
+namespace ViewportSyncBenchmark
+{
+	// Give up if PIE hasn't started after this many frames
+	static const int32 MaxFramesToWaitForPIE = 600;
+
+	// Radius (in uu) of the circles the follow targets move around
+	static const float FollowTargetOrbitRadius = 500.0f;
+
+	// How many world ticks of follow target history to look through for where a camera is looking
+	static const int32 FollowLatencyHistoryFrames = 8;
+
+	// Cameras snap straight to their target for latency runs, this only absorbs float noise
+	static const float FollowLatencyTolerance = 1.0f;
+
+	static double Percentile(TArray<double> Values, float Fraction)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0;
+		}
+
+		Values.Sort();
+		const int32 Index = FMath::Clamp(FMath::FloorToInt(Fraction * (Values.Num() - 1)), 0, Values.Num() - 1);
+		return Values[Index];
+	}
+
+	static double Average(const TArray<double>& Values)
+	{
+		double Sum = 0.0;
+		for (double Value : Values)
+		{
+			Sum += Value;
+		}
+		return Values.Num() > 0 ? Sum / Values.Num() : 0.0;
+	}
+}
+
+FViewportSyncBenchmarkConfig::FViewportSyncBenchmarkConfig()
+	: NumViewports(4)
+	, NumFollowTargets(16)
+	, bFollowAsGroup(false)
+	, bAutoFollow(false)
+	, bStagePIEStart(false)
+	, StreamingPolicy(EViewportSyncStreamingPolicy::Full)
+	, bPrefetchFollowTargets(false)
+	, FollowUpdatePoint(EViewportSyncFollowUpdatePoint::AfterWorldTick)
+	, bMeasureLatency(false)
+	, WarmupFrames(30)
+	, MeasuredFrames(300)
+	, ReportPath(FPaths::ProjectSavedDir() / TEXT("ViewportSync") / TEXT("Benchmark.json"))
+	, MaxTickMs(-1.0f)
+	, MaxPIEStartMs(-1.0f)
+	, MaxPIEEndMs(-1.0f)
+	, MaxAllocsPerTick(-1.0f)
+	, MaxFollowLatencyFrames(-1.0f)
+	, bExitWhenDone(false)
+{}
+
+FViewportSyncBenchmarkConfig FViewportSyncBenchmarkConfig::FromArgs(const TArray<FString>& Args)
+{
+	FViewportSyncBenchmarkConfig Config;
+
+	const FString CommandLine = FString::Join(Args, TEXT(" "));
+
+	FParse::Value(*CommandLine, TEXT("Viewports="), Config.NumViewports);
+	FParse::Value(*CommandLine, TEXT("Targets="), Config.NumFollowTargets);
+	FParse::Value(*CommandLine, TEXT("WarmupFrames="), Config.WarmupFrames);
+	FParse::Value(*CommandLine, TEXT("Frames="), Config.MeasuredFrames);
+	FParse::Value(*CommandLine, TEXT("Report="), Config.ReportPath);
+	FParse::Value(*CommandLine, TEXT("MaxTickMs="), Config.MaxTickMs);
+	FParse::Value(*CommandLine, TEXT("MaxPIEStartMs="), Config.MaxPIEStartMs);
+	FParse::Value(*CommandLine, TEXT("MaxPIEEndMs="), Config.MaxPIEEndMs);
+	FParse::Value(*CommandLine, TEXT("MaxAllocsPerTick="), Config.MaxAllocsPerTick);
+	FParse::Value(*CommandLine, TEXT("MaxFollowLatencyFrames="), Config.MaxFollowLatencyFrames);
+	Config.bFollowAsGroup = Args.Contains(TEXT("Group"));
+	Config.bAutoFollow = !Config.bFollowAsGroup && Args.Contains(TEXT("Auto"));
+	Config.bStagePIEStart = Args.Contains(TEXT("Staged"));
+	Config.bPrefetchFollowTargets = Args.Contains(TEXT("Prefetch"));
+	Config.bMeasureLatency = Args.Contains(TEXT("Latency"));
+
+	FString StreamingPolicy;
+	if (FParse::Value(*CommandLine, TEXT("Streaming="), StreamingPolicy))
+	{
+		const int64 PolicyValue = StaticEnum<EViewportSyncStreamingPolicy>()->GetValueByNameString(StreamingPolicy);
+		if (PolicyValue != INDEX_NONE)
+		{
+			Config.StreamingPolicy = static_cast<EViewportSyncStreamingPolicy>(PolicyValue);
+		}
+		else
+		{
+			UE_LOG(LogViewportSyncBenchmark, Warning, TEXT("Unknown streaming policy %s, using Full"), *StreamingPolicy);
+		}
+	}
+
+	FString FollowUpdatePoint;
+	if (FParse::Value(*CommandLine, TEXT("FollowUpdate="), FollowUpdatePoint))
+	{
+		const int64 UpdatePointValue = StaticEnum<EViewportSyncFollowUpdatePoint>()->GetValueByNameString(FollowUpdatePoint);
+		if (UpdatePointValue != INDEX_NONE)
+		{
+			Config.FollowUpdatePoint = static_cast<EViewportSyncFollowUpdatePoint>(UpdatePointValue);
+		}
+		else
+		{
+			UE_LOG(LogViewportSyncBenchmark, Warning, TEXT("Unknown follow update point %s, using AfterWorldTick"), *FollowUpdatePoint);
+		}
+	}
+
+	if (Config.bMeasureLatency && Config.bFollowAsGroup)
+	{
+		UE_LOG(LogViewportSyncBenchmark, Warning, TEXT("Follow latency can't be measured for groups, a group camera looks at the group's center rather than one target"));
+		Config.bMeasureLatency = false;
+	}
+
+	if (Config.bMeasureLatency && Config.bAutoFollow)
+	{
+		UE_LOG(LogViewportSyncBenchmark, Warning, TEXT("Follow latency can't be measured with auto follow, the cameras switch between targets"));
+		Config.bMeasureLatency = false;
+	}
+
+	Config.bExitWhenDone = Args.Contains(TEXT("Exit"));
+
+	Config.NumViewports = FMath::Max(Config.NumViewports, 0);
+	Config.NumFollowTargets = FMath::Max(Config.NumFollowTargets, 0);
+	Config.WarmupFrames = FMath::Max(Config.WarmupFrames, 0);
+	Config.MeasuredFrames = FMath::Max(Config.MeasuredFrames, 1);
+
+	return Config;
+}
+
+FViewportSyncBenchmark::FViewportSyncBenchmark(const FViewportSyncBenchmarkConfig& InConfig)
+	: Config(InConfig)
+	, Stage(EStage::NotStarted)
+	, Subsystem(nullptr)
+	, FollowTargetTime(0.0f)
+	, FrameIndex(0)
+	, PendingWorldTickMs(0.0)
+	, PendingWorldTickAllocs(0)
+	, NumUnmatchedLatencySamples(0)
+	, PIEStartMs(0.0)
+	, PIEEndMs(0.0)
+	, PIEStartAllocs(0)
+	, PIEEndAllocs(0)
+	, PIEStagedStartMs(0.0)
+	, PIEStagedStartFrames(0)
+	, UsedPhysicalAtPIEStart(0)
+	, UsedPhysicalAtPIEEnd(0)
+	, TextureMaxEverRequired(0)
+	, MaxWantingResources(0)
+	, NumLoadedStreamingLevels(0)
+	, bWasStagingPIEStart(false)
+	, PreviousStreamingPolicy(EViewportSyncStreamingPolicy::Full)
+	, bWasPrefetchingFollowTargets(false)
+	, PreviousFollowUpdatePoint(EViewportSyncFollowUpdatePoint::AfterWorldTick)
+{}
+
+FViewportSyncBenchmark::~FViewportSyncBenchmark()
+{
+	if (Stage != EStage::Finished && Stage != EStage::NotStarted)
+	{
+		UE_LOG(LogViewportSyncBenchmark, Warning, TEXT("Viewport Sync benchmark destroyed before it finished"));
+
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		UnhookSubsystem();
+	}
+}
+
+void FViewportSyncBenchmark::Start()
+{
+	Subsystem = GEditor != nullptr ? GEditor->GetEditorSubsystem<USyncViewportSubsystem>() : nullptr;
+	if (Subsystem == nullptr)
+	{
+		UE_LOG(LogViewportSyncBenchmark, Error, TEXT("Viewport Sync subsystem is not available, can't run the benchmark"));
+		Failures.Add(TEXT("Viewport Sync subsystem is not available, can't run the benchmark"));
+		Stage = EStage::Finished;
+		return;
+	}
+
+	if (GEditor->PlayWorld != nullptr)
+	{
+		UE_LOG(LogViewportSyncBenchmark, Error, TEXT("Stop the current PIE session before running the benchmark"));
+		Failures.Add(TEXT("Stop the current PIE session before running the benchmark"));
+		Stage = EStage::Finished;
+		return;
+	}
+
+	UE_LOG(LogViewportSyncBenchmark, Log, TEXT("Starting Viewport Sync benchmark: %d viewports, %d follow targets, %d frames"), Config.NumViewports, Config.NumFollowTargets, Config.MeasuredFrames);
+
+	if (!FViewportSyncAllocationCounter::IsAvailable())
+	{
+		UE_LOG(LogViewportSyncBenchmark, Warning, TEXT("Allocations aren't counted by this build's allocator, try -ansimalloc. MaxAllocsPerTick is not checked"));
+	}
+
+	UViewportSyncSettings* Settings = GetMutableDefault<UViewportSyncSettings>();
+	bWasStagingPIEStart = Settings->bStagePIEStart;
+	PreviousStreamingPolicy = Settings->DefaultStreamingPolicy;
+	bWasPrefetchingFollowTargets = Settings->bPrefetchFollowTargets;
+	PreviousFollowUpdatePoint = Settings->FollowUpdatePoint;
+
+	// Latched by the subsystem when PIE starts
+	Settings->FollowUpdatePoint = Config.FollowUpdatePoint;
+
+	// Before opening the viewports, they pick their streaming policy up when they're added
+	Settings->bStagePIEStart = Config.bStagePIEStart;
+	Settings->DefaultStreamingPolicy = Config.StreamingPolicy;
+	Settings->bPrefetchFollowTargets = Config.bPrefetchFollowTargets;
+
+	// These register themselves with the editor which lets the subsystem know about them
+	for (int32 Index = 0; Index < Config.NumViewports; ++Index)
+	{
+		ViewportClients.Add(new FLevelEditorViewportClient(nullptr));
+	}
+
+	HookSubsystem();
+
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FViewportSyncBenchmark::Tick));
+
+	Stage = EStage::WaitingForPIE;
+
+#if ENGINE_MAJOR_VERSION <= 4 && ENGINE_MINOR_VERSION <= 24
+	GEditor->RequestPlaySession(false, nullptr, false);
+#else
+	FRequestPlaySessionParams PlaySessionParams;
+	GEditor->RequestPlaySession(PlaySessionParams);
+#endif
+}
+
+bool FViewportSyncBenchmark::Tick(float DeltaTime)
+{
+	switch (Stage)
+	{
+	case EStage::WaitingForPIE:
+		if (++FrameIndex > ViewportSyncBenchmark::MaxFramesToWaitForPIE)
+		{
+			UE_LOG(LogViewportSyncBenchmark, Error, TEXT("PIE did not start within %d frames"), ViewportSyncBenchmark::MaxFramesToWaitForPIE);
+			Finish();
+			return false;
+		}
+		break;
+
+	case EStage::Measuring:
+		if (FrameIndex >= Config.WarmupFrames + Config.MeasuredFrames)
+		{
+			Stage = EStage::WaitingForPIEEnd;
+			GEditor->RequestEndPlayMap();
+		}
+		break;
+
+	case EStage::Finished:
+		return false;
+
+	default:
+		break;
+	}
+
+	// PIE has been torn down, safe to clean up and report
+	if (Stage == EStage::WaitingForPIEEnd && GEditor->PlayWorld == nullptr && PIEEndMs > 0.0)
+	{
+		Finish();
+		return false;
+	}
+
+	return true;
+}
+
+void FViewportSyncBenchmark::OnPIEPostStarted(const bool bIsSimulating)
+{
+	const FViewportSyncAllocationScope AllocationScope;
+	const double StartTime = FPlatformTime::Seconds();
+
+	Subsystem->OnPIEPostStarted(bIsSimulating);
+
+	PIEStartMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	PIEStartAllocs = AllocationScope.GetCount();
+
+	// Take over the subsystem's tick so we can time it
+	GEditor->OnPostEditorTick().RemoveAll(Subsystem);
+	GEditor->OnPostEditorTick().AddRaw(this, &FViewportSyncBenchmark::OnPostEditorTick);
+
+	// Same for following after the world ticks. The subsystem removes this by handle when PIE ends, which now removes ours
+	if (Subsystem->WorldPostActorTickHandle.IsValid())
+	{
+		FWorldDelegates::OnWorldPostActorTick.Remove(Subsystem->WorldPostActorTickHandle);
+		Subsystem->WorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FViewportSyncBenchmark::OnWorldPostActorTick);
+	}
+
+	FWorldDelegates::OnWorldPreActorTick.AddRaw(this, &FViewportSyncBenchmark::OnWorldPreActorTick);
+
+	SpawnFollowTargets();
+
+	UsedPhysicalAtPIEStart = FPlatformMemory::GetStats().UsedPhysical;
+	IStreamingManager::Get().GetTextureStreamingManager().ResetMaxEverRequired();
+
+	FrameIndex = 0;
+	Stage = EStage::Measuring;
+}
+
+void FViewportSyncBenchmark::OnPIEEnded(const bool bIsSimulating)
+{
+	GEditor->OnPostEditorTick().RemoveAll(this);
+	FWorldDelegates::OnWorldPreActorTick.RemoveAll(this);
+	FWorldDelegates::OnWorldPostActorTick.RemoveAll(this);
+
+	// While the PIE world is still around
+	UsedPhysicalAtPIEEnd = FPlatformMemory::GetStats().UsedPhysical;
+	TextureMaxEverRequired = IStreamingManager::Get().GetTextureStreamingManager().GetMaxEverRequired();
+	if (UWorld* PlayWorld = GEditor->PlayWorld)
+	{
+		for (const ULevelStreaming* StreamingLevel : PlayWorld->GetStreamingLevels())
+		{
+			NumLoadedStreamingLevels += StreamingLevel != nullptr && StreamingLevel->IsLevelLoaded() ? 1 : 0;
+		}
+	}
+
+	PIEStagedStartMs = Subsystem->PIEStartTiming.StagedMs;
+	PIEStagedStartFrames = Subsystem->PIEStartTiming.StagedFrames;
+
+	const FViewportSyncAllocationScope AllocationScope;
+	const double StartTime = FPlatformTime::Seconds();
+
+	Subsystem->OnPIEEnded(bIsSimulating);
+
+	// Make sure the Tick sees this as done even for a suspiciously fast end
+	PIEEndMs = FMath::Max((FPlatformTime::Seconds() - StartTime) * 1000.0, SMALL_NUMBER);
+	PIEEndAllocs = AllocationScope.GetCount();
+
+	FollowTargets.Reset();
+	FollowTargetHistory.Reset();
+}
+
+void FViewportSyncBenchmark::OnPostEditorTick(float DeltaTime)
+{
+	const bool bMeasuringFrame = FrameIndex >= Config.WarmupFrames && Stage == EStage::Measuring;
+
+	// Where the cameras were when the viewports were drawn this frame, before the subsystem moves them for the next
+	if (bMeasuringFrame && Config.bMeasureLatency)
+	{
+		MeasureFollowLatency();
+	}
+
+	const FViewportSyncAllocationScope AllocationScope;
+	const double StartTime = FPlatformTime::Seconds();
+
+	Subsystem->OnPostEditorTick(DeltaTime);
+
+	const double TickMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 + PendingWorldTickMs;
+	const uint64 NumAllocs = AllocationScope.GetCount() + PendingWorldTickAllocs;
+
+	PendingWorldTickMs = 0.0;
+	PendingWorldTickAllocs = 0;
+
+	if (bMeasuringFrame)
+	{
+		TickTimesMs.Add(TickMs);
+		TickAllocs.Add(NumAllocs);
+
+		MaxWantingResources = FMath::Max(MaxWantingResources, IStreamingManager::Get().GetNumWantingResources());
+	}
+
+	++FrameIndex;
+}
+
+void FViewportSyncBenchmark::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	const FViewportSyncAllocationScope AllocationScope;
+	const double StartTime = FPlatformTime::Seconds();
+
+	Subsystem->OnWorldPostActorTick(World, TickType, DeltaTime);
+
+	PendingWorldTickMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	PendingWorldTickAllocs += AllocationScope.GetCount();
+}
+
+void FViewportSyncBenchmark::OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	if (World == GEditor->PlayWorld)
+	{
+		MoveFollowTargets(World->IsPaused() ? 0.0f : DeltaTime);
+	}
+}
+
+void FViewportSyncBenchmark::SpawnFollowTargets()
+{
+	UWorld* PlayWorld = GEditor->PlayWorld;
+	if (PlayWorld == nullptr)
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 Index = 0; Index < Config.NumFollowTargets; ++Index)
+	{
+		AStaticMeshActor* FollowTarget = PlayWorld->SpawnActor<AStaticMeshActor>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParameters);
+		if (FollowTarget != nullptr)
+		{
+			FollowTarget->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+			FollowTargets.Add(FollowTarget);
+		}
+	}
+
+	FollowTargetHistory.SetNum(FollowTargets.Num());
+
+	if (Config.bFollowAsGroup)
+	{
+		TArray<AActor*> GroupActors;
+		for (const TWeakObjectPtr<AActor>& FollowTarget : FollowTargets)
+		{
+			GroupActors.Add(FollowTarget.Get());
+		}
+
+		for (FLevelEditorViewportClient* ViewportClient : ViewportClients)
+		{
+			Subsystem->SetViewportFollowGroup(ViewportClient, FViewportSyncFollowGroupDesc::FromActors(GroupActors));
+		}
+	}
+	else if (Config.bAutoFollow)
+	{
+		for (FLevelEditorViewportClient* ViewportClient : ViewportClients)
+		{
+			Subsystem->SetViewportAutoFollow(ViewportClient, GetDefault<UViewportSyncSettings>()->MakeNearestAutoFollowRule(AStaticMeshActor::StaticClass()));
+		}
+	}
+	else if (FollowTargets.Num() > 0)
+	{
+		for (int32 Index = 0; Index < ViewportClients.Num(); ++Index)
+		{
+			Subsystem->SetViewportFollowActor(ViewportClients[Index], FollowTargets[Index % FollowTargets.Num()].Get());
+
+			// Any smoothing would hide where the camera was told to look
+			if (Config.bMeasureLatency)
+			{
+				Subsystem->SetViewportFollowFilter(ViewportClients[Index], EViewportSyncFollowFilter::None);
+			}
+		}
+	}
+}
+
+void FViewportSyncBenchmark::MoveFollowTargets(float DeltaTime)
+{
+	FollowTargetTime += DeltaTime;
+
+	for (int32 Index = 0; Index < FollowTargets.Num(); ++Index)
+	{
+		if (AActor* FollowTarget = FollowTargets[Index].Get())
+		{
+			// Each target gets its own phase so they don't all move in lockstep
+			const float Angle = FollowTargetTime + Index * (2.0f * PI / FollowTargets.Num());
+			FollowTarget->SetActorLocation(FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * ViewportSyncBenchmark::FollowTargetOrbitRadius + FVector(0.0f, 0.0f, Index * 100.0f));
+
+			TArray<FVector, TInlineAllocator<8>>& History = FollowTargetHistory[Index];
+			if (History.Num() >= ViewportSyncBenchmark::FollowLatencyHistoryFrames)
+			{
+				History.Pop(false);
+			}
+			History.Insert(FollowTarget->GetActorLocation(), 0);
+		}
+	}
+}
+
+void FViewportSyncBenchmark::MeasureFollowLatency()
+{
+	if (FollowTargets.Num() == 0)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < ViewportClients.Num(); ++Index)
+	{
+		const FVector LookAtLocation = ViewportClients[Index]->GetLookAtLocation();
+		const TArray<FVector, TInlineAllocator<8>>& History = FollowTargetHistory[Index % FollowTargets.Num()];
+
+		// Newest first, so a target standing still counts as no latency
+		const int32 LatencyFrames = History.IndexOfByPredicate([&LookAtLocation](const FVector& TargetLocation)
+		{
+			return TargetLocation.Equals(LookAtLocation, ViewportSyncBenchmark::FollowLatencyTolerance);
+		});
+
+		if (LatencyFrames != INDEX_NONE)
+		{
+			FollowLatencyFrames.Add(LatencyFrames);
+		}
+		else
+		{
+			++NumUnmatchedLatencySamples;
+		}
+	}
+}
+
+void FViewportSyncBenchmark::HookSubsystem()
+{
+	FEditorDelegates::PostPIEStarted.RemoveAll(Subsystem);
+	FEditorDelegates::EndPIE.RemoveAll(Subsystem);
+
+	FEditorDelegates::PostPIEStarted.AddRaw(this, &FViewportSyncBenchmark::OnPIEPostStarted);
+	FEditorDelegates::EndPIE.AddRaw(this, &FViewportSyncBenchmark::OnPIEEnded);
+}
+
+void FViewportSyncBenchmark::UnhookSubsystem()
+{
+	FEditorDelegates::PostPIEStarted.RemoveAll(this);
+	FEditorDelegates::EndPIE.RemoveAll(this);
+	GEditor->OnPostEditorTick().RemoveAll(this);
+	FWorldDelegates::OnWorldPreActorTick.RemoveAll(this);
+	FWorldDelegates::OnWorldPostActorTick.RemoveAll(this);
+
+	UViewportSyncSettings* Settings = GetMutableDefault<UViewportSyncSettings>();
+	Settings->bStagePIEStart = bWasStagingPIEStart;
+	Settings->DefaultStreamingPolicy = PreviousStreamingPolicy;
+	Settings->bPrefetchFollowTargets = bWasPrefetchingFollowTargets;
+	Settings->FollowUpdatePoint = PreviousFollowUpdatePoint;
+
+	if (Subsystem != nullptr)
+	{
+		FEditorDelegates::PostPIEStarted.AddUObject(Subsystem, &USyncViewportSubsystem::OnPIEPostStarted);
+		FEditorDelegates::EndPIE.AddUObject(Subsystem, &USyncViewportSubsystem::OnPIEEnded);
+	}
+}
+
+void FViewportSyncBenchmark::Finish()
+{
+	Stage = EStage::Finished;
+
+	UnhookSubsystem();
+
+	// Removes them from the editor which in turn removes them from the subsystem
+	for (FLevelEditorViewportClient* ViewportClient : ViewportClients)
+	{
+		delete ViewportClient;
+	}
+	ViewportClients.Reset();
+
+	const bool bPassed = WriteReport();
+
+	if (Config.bExitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+	}
+}
+
+bool FViewportSyncBenchmark::WriteReport()
+{
+	using namespace ViewportSyncBenchmark;
+
+	TArray<double> TickAllocsAsDouble;
+	for (uint64 NumAllocs : TickAllocs)
+	{
+		TickAllocsAsDouble.Add(static_cast<double>(NumAllocs));
+	}
+
+	const double TickAverageMs = Average(TickTimesMs);
+	const double TickP95Ms = Percentile(TickTimesMs, 0.95f);
+	const double AllocsPerTick = Average(TickAllocsAsDouble);
+	const double FollowLatencyAverage = Average(FollowLatencyFrames);
+	const double FollowLatencyMax = Percentile(FollowLatencyFrames, 1.0f);
+
+	Failures.Reset();
+
+	const auto CheckThreshold = [this](const TCHAR* Name, double Value, float Threshold)
+	{
+		if (Threshold >= 0.0f && Value > Threshold)
+		{
+			Failures.Add(FString::Printf(TEXT("%s %.4f exceeded threshold %.4f"), Name, Value, Threshold));
+		}
+	};
+
+	if (TickTimesMs.Num() == 0)
+	{
+		Failures.Add(TEXT("No frames were measured"));
+	}
+
+	CheckThreshold(TEXT("TickP95Ms"), TickP95Ms, Config.MaxTickMs);
+	CheckThreshold(TEXT("PIEStartMs"), PIEStartMs, Config.MaxPIEStartMs);
+	CheckThreshold(TEXT("PIEEndMs"), PIEEndMs, Config.MaxPIEEndMs);
+	const bool bAllocationsCounted = FViewportSyncAllocationCounter::IsAvailable();
+	if (bAllocationsCounted)
+	{
+		CheckThreshold(TEXT("AllocsPerTick"), AllocsPerTick, Config.MaxAllocsPerTick);
+	}
+
+	if (Config.bMeasureLatency)
+	{
+		if (FollowLatencyFrames.Num() == 0)
+		{
+			Failures.Add(TEXT("No follow latency was measured"));
+		}
+		CheckThreshold(TEXT("FollowLatencyFrames"), FollowLatencyMax, Config.MaxFollowLatencyFrames);
+	}
+
+	TSharedRef<FJsonObject> Parameters = MakeShared<FJsonObject>();
+	Parameters->SetNumberField(TEXT("Viewports"), Config.NumViewports);
+	Parameters->SetNumberField(TEXT("FollowTargets"), Config.NumFollowTargets);
+	Parameters->SetBoolField(TEXT("FollowAsGroup"), Config.bFollowAsGroup);
+	Parameters->SetBoolField(TEXT("AutoFollow"), Config.bAutoFollow);
+	Parameters->SetBoolField(TEXT("StagedPIEStart"), Config.bStagePIEStart);
+	Parameters->SetStringField(TEXT("StreamingPolicy"), FViewportSyncStreaming::GetDisplayText(Config.StreamingPolicy).ToString());
+	Parameters->SetBoolField(TEXT("PrefetchFollowTargets"), Config.bPrefetchFollowTargets);
+	Parameters->SetStringField(TEXT("FollowUpdatePoint"), StaticEnum<EViewportSyncFollowUpdatePoint>()->GetNameStringByValue(static_cast<int64>(Config.FollowUpdatePoint)));
+	Parameters->SetNumberField(TEXT("WarmupFrames"), Config.WarmupFrames);
+	Parameters->SetNumberField(TEXT("MeasuredFrames"), Config.MeasuredFrames);
+
+	TSharedRef<FJsonObject> Tick = MakeShared<FJsonObject>();
+	Tick->SetNumberField(TEXT("Frames"), TickTimesMs.Num());
+	Tick->SetNumberField(TEXT("AverageMs"), TickAverageMs);
+	Tick->SetNumberField(TEXT("P50Ms"), Percentile(TickTimesMs, 0.5f));
+	Tick->SetNumberField(TEXT("P95Ms"), TickP95Ms);
+	Tick->SetNumberField(TEXT("MaxMs"), Percentile(TickTimesMs, 1.0f));
+	Tick->SetBoolField(TEXT("AllocationsCounted"), bAllocationsCounted);
+	Tick->SetNumberField(TEXT("AverageAllocs"), AllocsPerTick);
+	Tick->SetNumberField(TEXT("MaxAllocs"), Percentile(TickAllocsAsDouble, 1.0f));
+
+	TSharedRef<FJsonObject> PIE = MakeShared<FJsonObject>();
+	PIE->SetNumberField(TEXT("StartMs"), PIEStartMs);
+	PIE->SetNumberField(TEXT("StartAllocs"), static_cast<double>(PIEStartAllocs));
+	PIE->SetNumberField(TEXT("StagedStartMs"), PIEStagedStartMs);
+	PIE->SetNumberField(TEXT("StagedStartFrames"), PIEStagedStartFrames);
+	PIE->SetNumberField(TEXT("EndMs"), PIEEndMs);
+	PIE->SetNumberField(TEXT("EndAllocs"), static_cast<double>(PIEEndAllocs));
+
+	const double UsedPhysicalDeltaMB = (static_cast<double>(UsedPhysicalAtPIEEnd) - static_cast<double>(UsedPhysicalAtPIEStart)) / (1024.0 * 1024.0);
+
+	TSharedRef<FJsonObject> Streaming = MakeShared<FJsonObject>();
+	Streaming->SetNumberField(TEXT("UsedPhysicalDeltaMB"), UsedPhysicalDeltaMB);
+	Streaming->SetNumberField(TEXT("TextureMaxEverRequiredMB"), TextureMaxEverRequired / (1024.0 * 1024.0));
+	Streaming->SetNumberField(TEXT("MaxWantingResources"), MaxWantingResources);
+	Streaming->SetNumberField(TEXT("LoadedStreamingLevels"), NumLoadedStreamingLevels);
+
+	TSharedRef<FJsonObject> Thresholds = MakeShared<FJsonObject>();
+	Thresholds->SetNumberField(TEXT("MaxTickMs"), Config.MaxTickMs);
+	Thresholds->SetNumberField(TEXT("MaxPIEStartMs"), Config.MaxPIEStartMs);
+	Thresholds->SetNumberField(TEXT("MaxPIEEndMs"), Config.MaxPIEEndMs);
+	Thresholds->SetNumberField(TEXT("MaxAllocsPerTick"), Config.MaxAllocsPerTick);
+	Thresholds->SetNumberField(TEXT("MaxFollowLatencyFrames"), Config.MaxFollowLatencyFrames);
+
+	TArray<TSharedPtr<FJsonValue>> FailureValues;
+	for (const FString& Failure : Failures)
+	{
+		FailureValues.Add(MakeShared<FJsonValueString>(Failure));
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetObjectField(TEXT("Parameters"), Parameters);
+	Report->SetObjectField(TEXT("PostEditorTick"), Tick);
+	Report->SetObjectField(TEXT("PIE"), PIE);
+	Report->SetObjectField(TEXT("Streaming"), Streaming);
+
+	if (Config.bMeasureLatency)
+	{
+		TSharedRef<FJsonObject> FollowLatency = MakeShared<FJsonObject>();
+		FollowLatency->SetNumberField(TEXT("Samples"), FollowLatencyFrames.Num());
+		FollowLatency->SetNumberField(TEXT("AverageFrames"), FollowLatencyAverage);
+		FollowLatency->SetNumberField(TEXT("MaxFrames"), FollowLatencyMax);
+		FollowLatency->SetNumberField(TEXT("UnmatchedSamples"), NumUnmatchedLatencySamples);
+		Report->SetObjectField(TEXT("FollowLatency"), FollowLatency);
+	}
+
+	Report->SetObjectField(TEXT("Thresholds"), Thresholds);
+	Report->SetBoolField(TEXT("Passed"), Failures.Num() == 0);
+	Report->SetArrayField(TEXT("Failures"), FailureValues);
+
+	FString ReportString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportString);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	if (FFileHelper::SaveStringToFile(ReportString, *Config.ReportPath))
+	{
+		UE_LOG(LogViewportSyncBenchmark, Log, TEXT("Wrote Viewport Sync benchmark report to %s"), *Config.ReportPath);
+	}
+	else
+	{
+		UE_LOG(LogViewportSyncBenchmark, Error, TEXT("Failed to write Viewport Sync benchmark report to %s"), *Config.ReportPath);
+	}
+
+	UE_LOG(LogViewportSyncBenchmark, Log, TEXT("PostEditorTick avg %.4fms p95 %.4fms, %.1f allocs/tick. PIE start %.3fms (+%.3fms staged over %d frames), end %.3fms"), TickAverageMs, TickP95Ms, AllocsPerTick, PIEStartMs, PIEStagedStartMs, PIEStagedStartFrames, PIEEndMs);
+
+	UE_LOG(LogViewportSyncBenchmark, Log, TEXT("Streaming (%s%s): memory %+.1fMB, texture max ever required %.1fMB, up to %d resources wanting to stream, %d streaming levels loaded"),
+		*FViewportSyncStreaming::GetDisplayText(Config.StreamingPolicy).ToString(), Config.bPrefetchFollowTargets ? TEXT(", prefetching") : TEXT(""),
+		UsedPhysicalDeltaMB, TextureMaxEverRequired / (1024.0 * 1024.0), MaxWantingResources, NumLoadedStreamingLevels);
+
+	if (Config.bMeasureLatency)
+	{
+		UE_LOG(LogViewportSyncBenchmark, Log, TEXT("Follow latency (%s): avg %.2f frames, max %.0f frames, %d samples didn't match a recent target location"),
+			*StaticEnum<EViewportSyncFollowUpdatePoint>()->GetNameStringByValue(static_cast<int64>(Config.FollowUpdatePoint)), FollowLatencyAverage, FollowLatencyMax, NumUnmatchedLatencySamples);
+	}
+
+	for (const FString& Failure : Failures)
+	{
+		UE_LOG(LogViewportSyncBenchmark, Error, TEXT("Regression: %s"), *Failure);
+	}
+
+	return Failures.Num() == 0;
+}
@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "ViewportSyncSettings.h"
+#include "ViewportSyncStreaming.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogViewportSyncBenchmark, Log, All);
+
+class AActor;
+class FLevelEditorViewportClient;
+class USyncViewportSubsystem;
+
+/**
+ * What to run and what counts as a regression
+ */
+struct FViewportSyncBenchmarkConfig
+{
+	// Number of extra level editor viewport clients to open
+	int32 NumViewports;
+
+	// Number of moving actors to spread between the viewports as follow targets
+	int32 NumFollowTargets;
+
+	// Every viewport follows all of the targets as one group instead of one target each
+	bool bFollowAsGroup;
+
+	// Every viewport auto follows whichever target is nearest the player instead, times picking from a lot of candidates
+	bool bAutoFollow;
+
+	// Run with staged PIE start on, MaxPIEStartMs then only covers the start frame
+	bool bStagePIEStart;
+
+	// Streaming policy the viewports are opened with, and whether they prefetch around their follow targets
+	EViewportSyncStreamingPolicy StreamingPolicy;
+	bool bPrefetchFollowTargets;
+
+	// When the subsystem moves cameras to their follow targets
+	EViewportSyncFollowUpdatePoint FollowUpdatePoint;
+
+	// Measure how many frames each camera lags behind its follow target, not available with bFollowAsGroup or bAutoFollow
+	bool bMeasureLatency;
+
+	int32 WarmupFrames;
+	int32 MeasuredFrames;
+
+	FString ReportPath;
+
+	// Regression thresholds, anything < 0 is not checked
+	float MaxTickMs;
+	float MaxPIEStartMs;
+	float MaxPIEEndMs;
+	float MaxAllocsPerTick;
+	float MaxFollowLatencyFrames;
+
+	// Quit the editor when done, with a non-zero exit code if any threshold failed
+	bool bExitWhenDone;
+
+	FViewportSyncBenchmarkConfig();
+
+	static FViewportSyncBenchmarkConfig FromArgs(const TArray<FString>& Args);
+};
+
+/**
+ * Opens viewports, starts PIE, follows moving actors and times the Viewport Sync subsystem in isolation.
+ *
+ * The subsystem's PIE and tick callbacks are unbound from the editor while this runs and called from here instead,
+ * so the timings and allocation counts are only taken around the plugin's own work. Allocation counts include other threads,
+ * run with -nullrhi to keep those quiet.
+ */
+class FViewportSyncBenchmark
+{
+public:
+	explicit FViewportSyncBenchmark(const FViewportSyncBenchmarkConfig& InConfig);
+	~FViewportSyncBenchmark();
+
+	void Start();
+
+	bool IsFinished() const { return Stage == EStage::Finished; }
+
+	/* Thresholds that were exceeded, filled in once finished */
+	const TArray<FString>& GetFailures() const { return Failures; }
+
+	/* Frames each viewport's camera was behind its target, only measured with bMeasureLatency */
+	const TArray<double>& GetFollowLatencyFrames() const { return FollowLatencyFrames; }
+	int32 GetNumUnmatchedLatencySamples() const { return NumUnmatchedLatencySamples; }
+
+private:
+	enum class EStage : uint8
+	{
+		NotStarted,
+		WaitingForPIE,
+		Measuring,
+		WaitingForPIEEnd,
+		Finished
+	};
+
+	bool Tick(float DeltaTime);
+
+	// Stand-ins for the subsystem's own callbacks
+	void OnPIEPostStarted(const bool bIsSimulating);
+	void OnPIEEnded(const bool bIsSimulating);
+	void OnPostEditorTick(float DeltaTime);
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+	// Targets move with the PIE world, before its actors tick, so they're where the game would have put them
+	void OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+	void SpawnFollowTargets();
+	void MoveFollowTargets(float DeltaTime);
+
+	/* How many world ticks behind its target each viewport is looking, from the target's recent locations */
+	void MeasureFollowLatency();
+
+	void Finish();
+	bool WriteReport();
+
+	void HookSubsystem();
+	void UnhookSubsystem();
+
+	FViewportSyncBenchmarkConfig Config;
+
+	EStage Stage;
+
+	USyncViewportSubsystem* Subsystem;
+
+	FDelegateHandle TickerHandle;
+
+	TArray<FLevelEditorViewportClient*> ViewportClients;
+
+	TArray<TWeakObjectPtr<AActor>> FollowTargets;
+	float FollowTargetTime;
+
+	int32 FrameIndex;
+
+	// Where each follow target was over the last few world ticks, newest first
+	TArray<TArray<FVector, TInlineAllocator<8>>> FollowTargetHistory;
+
+	// Time and allocations spent following after the world ticked, counted towards this frame's tick
+	double PendingWorldTickMs;
+	uint64 PendingWorldTickAllocs;
+
+	// Results
+	TArray<double> TickTimesMs;
+	TArray<uint64> TickAllocs;
+
+	// Frames each viewport's camera was behind its target, one sample per viewport per measured frame
+	TArray<double> FollowLatencyFrames;
+	int32 NumUnmatchedLatencySamples;
+
+	double PIEStartMs;
+	double PIEEndMs;
+	uint64 PIEStartAllocs;
+	uint64 PIEEndAllocs;
+
+	// What staged PIE start spent in the frames after the start, read from the subsystem once PIE is over
+	double PIEStagedStartMs;
+	int32 PIEStagedStartFrames;
+
+	// Memory and streaming between PIE starting and ending, for comparing streaming policies
+	uint64 UsedPhysicalAtPIEStart;
+	uint64 UsedPhysicalAtPIEEnd;
+	int64 TextureMaxEverRequired;
+	int32 MaxWantingResources;
+	int32 NumLoadedStreamingLevels;
+
+	TArray<FString> Failures;
+
+	// The user's settings, put back once we're done
+	bool bWasStagingPIEStart;
+	EViewportSyncStreamingPolicy PreviousStreamingPolicy;
+	bool bWasPrefetchingFollowTargets;
+	EViewportSyncFollowUpdatePoint PreviousFollowUpdatePoint;
+};
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncCoreBenchmark.h"
+
+// UE Includes
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/* A short run of the microbenchmark with loose thresholds, catches the per tick work starting to allocate or getting far slower */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncCoreBenchmarkTest, "ViewportSync.Core.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncCoreBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// Well above what any build does, this is here to catch something going badly wrong rather than to measure
+	static const double MaxNsPerViewport = 20000.0;
+
+	// Other threads' allocations are counted too, anything in the per viewport work allocating would be at least one per viewport per tick
+	static const double MaxAllocsPerTick = 1.0;
+
+	const FViewportSyncCoreBenchmarkResult Result = FViewportSyncCoreBenchmark::Run(64, 200);
+
+	AddInfo(FString::Printf(TEXT("%.1f ns per viewport per tick"), Result.NsPerViewport));
+	TestTrue(FString::Printf(TEXT("Under %.0f ns per viewport per tick"), MaxNsPerViewport), Result.NsPerViewport < MaxNsPerViewport);
+
+	if (Result.bAllocationsCounted)
+	{
+		AddInfo(FString::Printf(TEXT("%.2f allocs per tick (max %llu)"), Result.AllocsPerTick, Result.MaxAllocsPerTick));
+		TestTrue(FString::Printf(TEXT("Under %.0f allocs per tick"), MaxAllocsPerTick), Result.AllocsPerTick < MaxAllocsPerTick);
+	}
+	else
+	{
+		AddInfo(TEXT("Allocations aren't counted by this build's allocator, try -ansimalloc"));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
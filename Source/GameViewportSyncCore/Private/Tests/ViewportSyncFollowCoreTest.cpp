@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncFollowCore.h"
+#include "ViewportSyncMockFollowView.h"
+
+// UE Includes
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ViewportSyncFollowCoreTest
+{
+	static const float FrameDeltaTime = 1.0f / 60.0f;
+
+	// Same as the plugin's default movement threshold
+	static const float MovementThresholdSquared = FMath::Square(0.1f);
+
+	/* Follow a target for one frame, taking the camera over first if need be */
+	static float Step(FViewportSyncFollowState& State, FViewportSyncMockFollowView& View, const FVector& Target)
+	{
+		float Lag = 0.0f;
+		FViewportSyncFollowCore::FollowLocation(State, View, Target, FrameDeltaTime, MovementThresholdSquared, Lag);
+		return Lag;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowCoreTakesCameraOverTest, "ViewportSync.Core.FollowCore.TakesCameraOver", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowCoreTakesCameraOverTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncFollowCoreTest;
+
+	FViewportSyncFollowState State;
+	FViewportSyncMockFollowView View;
+
+	const FVector Target(100.0f, 0.0f, 0.0f);
+	float Lag = 0.0f;
+	const bool bHadCamera = FViewportSyncFollowCore::FollowLocation(State, View, Target, FrameDeltaTime, MovementThresholdSquared, Lag);
+
+	TestFalse(TEXT("First update only takes the camera over"), bHadCamera);
+	TestTrue(TEXT("View is following"), View.bFollowing);
+	TestEqual(TEXT("Begin follow calls"), View.NumBeginFollows, 1);
+	TestTrue(TEXT("Looks at the target"), View.LookAtLocation.Equals(Target));
+	TestTrue(TEXT("Next update is forced"), State.bForceUpdate);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowCoreConvergesTest, "ViewportSync.Core.FollowCore.ConvergesOnStillTarget", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowCoreConvergesTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncFollowCoreTest;
+
+	FViewportSyncFollowState State;
+	FViewportSyncMockFollowView View;
+
+	Step(State, View, FVector::ZeroVector);
+
+	const FVector Target(1000.0f, 500.0f, 0.0f);
+	float Lag = 0.0f;
+	for (int32 Frame = 0; Frame < 180; ++Frame)
+	{
+		Lag = Step(State, View, Target);
+	}
+
+	TestTrue(TEXT("Looks at the target after 3 seconds"), View.LookAtLocation.Equals(Target, 1.0f));
+	TestTrue(TEXT("Lag has settled under 1 uu"), Lag < 1.0f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowCoreKeepsOrbitDistanceTest, "ViewportSync.Core.FollowCore.KeepsOrbitDistance", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowCoreKeepsOrbitDistanceTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncFollowCoreTest;
+
+	FViewportSyncFollowState State;
+	State.FilterSettings.Filter = EViewportSyncFollowFilter::None;
+	FViewportSyncMockFollowView View;
+
+	Step(State, View, FVector::ZeroVector);
+	const float OrbitDistance = View.GetOrbitDistance();
+
+	Step(State, View, FVector(300.0f, -200.0f, 50.0f));
+
+	TestEqual(TEXT("View orbit distance"), View.GetOrbitDistance(), OrbitDistance, 0.01f);
+	TestEqual(TEXT("State orbit distance"), State.OrbitDistance, OrbitDistance, 0.01f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowCoreHoldsUnderThresholdTest, "ViewportSync.Core.FollowCore.HoldsUnderThreshold", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowCoreHoldsUnderThresholdTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncFollowCoreTest;
+
+	FViewportSyncFollowState State;
+	State.FilterSettings.Filter = EViewportSyncFollowFilter::None;
+	FViewportSyncMockFollowView View;
+
+	Step(State, View, FVector::ZeroVector);
+	Step(State, View, FVector::ZeroVector);
+	const int32 SettledOrbitUpdates = View.NumOrbitUpdates;
+
+	Step(State, View, FVector(0.05f, 0.0f, 0.0f));
+	TestEqual(TEXT("Orbit updates after moving under the threshold"), View.NumOrbitUpdates, SettledOrbitUpdates);
+
+	Step(State, View, FVector(1.0f, 0.0f, 0.0f));
+	TestEqual(TEXT("Orbit updates after moving past the threshold"), View.NumOrbitUpdates, SettledOrbitUpdates + 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowCoreForcedUpdateTest, "ViewportSync.Core.FollowCore.ForcedUpdateApplies", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowCoreForcedUpdateTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncFollowCoreTest;
+
+	FViewportSyncFollowState State;
+	FViewportSyncMockFollowView View;
+
+	Step(State, View, FVector::ZeroVector);
+	Step(State, View, FVector::ZeroVector);
+	const int32 SettledOrbitUpdates = View.NumOrbitUpdates;
+
+	State.bForceUpdate = true;
+	Step(State, View, FVector::ZeroVector);
+
+	TestEqual(TEXT("Orbit updates"), View.NumOrbitUpdates, SettledOrbitUpdates + 1);
+	TestFalse(TEXT("Force update is cleared"), State.bForceUpdate);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowCoreThrottlesTest, "ViewportSync.Core.FollowCore.ThrottlesToRate", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowCoreThrottlesTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncFollowCoreTest;
+
+	FViewportSyncFollowState State;
+	State.bForceUpdate = false;
+
+	// 6 seconds at 60 fps throttled to 10 Hz
+	int32 NumUpdates = 0;
+	for (int32 Frame = 1; Frame <= 360; ++Frame)
+	{
+		if (FViewportSyncFollowCore::ShouldUpdate(State, Frame * FrameDeltaTime, FrameDeltaTime, 10.0f))
+		{
+			++NumUpdates;
+		}
+	}
+
+	TestTrue(FString::Printf(TEXT("%d updates in 6 seconds at 10 Hz"), NumUpdates), FMath::Abs(NumUpdates - 60) <= 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowCoreFramesGroupTest, "ViewportSync.Core.FollowCore.FramesGroup", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowCoreFramesGroupTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncFollowCoreTest;
+
+	FViewportSyncFollowState State;
+	State.FilterSettings.Filter = EViewportSyncFollowFilter::None;
+	FViewportSyncMockFollowView View;
+
+	const float Radius = 500.0f;
+	const float Padding = 200.0f;
+	const FVector Center(2000.0f, 0.0f, 0.0f);
+
+	FViewportSyncFollowCore::FrameLocation(State, View, Center, Radius, Padding, FrameDeltaTime, MovementThresholdSquared);
+	FViewportSyncFollowCore::FrameLocation(State, View, Center, Radius, Padding, FrameDeltaTime, MovementThresholdSquared);
+
+	// The view is wider than it is tall, so the vertical FOV is what has to fit the group
+	const float HalfVerticalFOV = FMath::Atan(FMath::Tan(FMath::DegreesToRadians(View.FOV * 0.5f)) / View.AspectRatio);
+	const float ExpectedOrbitDistance = (Radius + Padding) / FMath::Sin(HalfVerticalFOV);
+
+	TestTrue(TEXT("Looks at the group's center"), View.LookAtLocation.Equals(Center));
+	TestEqual(TEXT("Orbit distance fits the group"), View.GetOrbitDistance(), ExpectedOrbitDistance, 1.0f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowCoreOrthographicTest, "ViewportSync.Core.FollowCore.LeavesOrthographicZoom", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowCoreOrthographicTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncFollowCoreTest;
+
+	FViewportSyncFollowState State;
+	FViewportSyncMockFollowView View;
+	View.bPerspective = false;
+
+	const float OrbitDistance = View.GetOrbitDistance();
+
+	FViewportSyncFollowCore::FrameLocation(State, View, FVector::ZeroVector, 5000.0f, 200.0f, FrameDeltaTime, MovementThresholdSquared);
+	FViewportSyncFollowCore::FrameLocation(State, View, FVector::ZeroVector, 5000.0f, 200.0f, FrameDeltaTime, MovementThresholdSquared);
+
+	TestEqual(TEXT("Orbit distance"), View.GetOrbitDistance(), OrbitDistance, 0.01f);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
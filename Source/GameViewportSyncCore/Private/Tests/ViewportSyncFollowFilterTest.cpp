@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncFollowFilter.h"
+
+// UE Includes
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ViewportSyncFollowFilterTest
+{
+	// Length of the scripted path in seconds
+	static const float PathDuration = 4.0f;
+
+	// The reference run is stepped at least this often
+	static const float ReferenceRate = 1000.0f;
+
+	// Max distance (in uu) any frame rate may drift from the reference
+	static const float Tolerance = 5.0f;
+
+	/*
+	 * Circles for 2 seconds, stands still for 1, then heads off in a straight line.
+	 * Covers steady motion, a sudden stop and a sudden start
+	 */
+	static FVector GetTargetLocation(float Time)
+	{
+		static const float Radius = 500.0f;
+		static const float AngularSpeed = 1.2f;
+		static const float LineSpeed = 800.0f;
+
+		const float CircleTime = FMath::Min(Time, 2.0f);
+		const FVector CircleLocation = FVector(FMath::Cos(CircleTime * AngularSpeed), FMath::Sin(CircleTime * AngularSpeed), 0.0f) * Radius;
+
+		const float LineTime = FMath::Max(Time - 3.0f, 0.0f);
+		return CircleLocation + FVector(0.0f, 0.0f, LineTime * LineSpeed);
+	}
+
+	/* Steps the filter at Rate with SubSteps filter updates per frame, calls OnFrame with the output at the end of each frame */
+	static void Simulate(float Rate, int32 SubSteps, const FViewportSyncFollowFilterSettings& Settings, TFunctionRef<void(int32, const FVector&)> OnFrame)
+	{
+		FViewportSyncFollowFilter Filter;
+		Filter.Reset(GetTargetLocation(0.0f));
+
+		const int32 NumFrames = FMath::RoundToInt(PathDuration * Rate);
+		const float SubStepDeltaTime = 1.0f / (Rate * SubSteps);
+
+		for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			FVector Output = FVector::ZeroVector;
+			for (int32 SubStep = 1; SubStep <= SubSteps; ++SubStep)
+			{
+				// Work the time out from the step count rather than accumulating it so every rate hits the same sample times
+				const float Time = ((Frame - 1) * SubSteps + SubStep) * SubStepDeltaTime;
+				Output = Filter.Update(GetTargetLocation(Time), SubStepDeltaTime, Settings);
+			}
+			OnFrame(Frame, Output);
+		}
+	}
+}
+
+/* Every follow filter has to move the camera the same at 30, 60 and 144 Hz, with prediction on */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncFollowFilterFrameRateTest, "ViewportSync.Core.FollowFilter.FrameRateIndependent", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncFollowFilterFrameRateTest::RunTest(const FString& Parameters)
+{
+	using namespace ViewportSyncFollowFilterTest;
+
+	const EViewportSyncFollowFilter Filters[] =
+	{
+		EViewportSyncFollowFilter::None,
+		EViewportSyncFollowFilter::ConstantSpeed,
+		EViewportSyncFollowFilter::CriticallyDamped,
+		EViewportSyncFollowFilter::OneEuro,
+	};
+
+	const float Rates[] = { 30.0f, 60.0f, 144.0f };
+
+	FViewportSyncFollowFilterSettings Settings;
+	Settings.PredictionTime = 0.2f;
+
+	for (const EViewportSyncFollowFilter Filter : Filters)
+	{
+		Settings.Filter = Filter;
+
+		for (const float Rate : Rates)
+		{
+			// Reference run stepped many times per frame, sampled at the end of every frame of the run being checked
+			TArray<FVector> ReferenceOutputs;
+			Simulate(Rate, FMath::CeilToInt(ReferenceRate / Rate), Settings, [&ReferenceOutputs](int32 Frame, const FVector& Output)
+			{
+				ReferenceOutputs.Add(Output);
+			});
+
+			float MaxError = 0.0f;
+			Simulate(Rate, 1, Settings, [&ReferenceOutputs, &MaxError](int32 Frame, const FVector& Output)
+			{
+				MaxError = FMath::Max(MaxError, FVector::Dist(Output, ReferenceOutputs[Frame - 1]));
+			});
+
+			const FString What = FString::Printf(TEXT("%s at %.0f Hz is within %.1f uu of the reference (max error %.3f uu)"),
+				*FViewportSyncFollowFilterSettings::GetDisplayText(Filter).ToString(), Rate, Tolerance, MaxError);
+			TestTrue(What, MaxError <= Tolerance);
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
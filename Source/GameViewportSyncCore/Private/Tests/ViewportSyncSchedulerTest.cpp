@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncScheduler.h"
+
+// UE Includes
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncSchedulerRefreshRateTest, "ViewportSync.Core.Scheduler.RefreshRate", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncSchedulerRefreshRateTest::RunTest(const FString& Parameters)
+{
+	const FViewportSyncHandle EveryFrame(0, 0);
+	const FViewportSyncHandle ThirtyHz(1, 0);
+	const FViewportSyncHandle EveryFourth(2, 0);
+
+	FViewportSyncScheduler Scheduler;
+	Scheduler.AddViewport(EveryFrame, FViewportSyncRefreshRate());
+	Scheduler.AddViewport(ThirtyHz, FViewportSyncRefreshRate::Hz(30.0f));
+	Scheduler.AddViewport(EveryFourth, FViewportSyncRefreshRate::EveryNthFrame(4));
+
+	// 2 seconds of a 60 fps editor, no budget
+	TMap<FViewportSyncHandle, int32> NumRedraws;
+	for (int32 Frame = 1; Frame <= 120; ++Frame)
+	{
+		Scheduler.Tick(Frame, Frame / 60.0, 0.0f, [&NumRedraws](FViewportSyncHandle ViewportHandle)
+		{
+			++NumRedraws.FindOrAdd(ViewportHandle);
+		});
+	}
+
+	TestEqual(TEXT("Every frame redraws"), NumRedraws.FindRef(EveryFrame), 120);
+	TestTrue(FString::Printf(TEXT("30 Hz redraws %d times in 2 seconds"), NumRedraws.FindRef(ThirtyHz)), FMath::Abs(NumRedraws.FindRef(ThirtyHz) - 60) <= 1);
+	TestEqual(TEXT("Every 4th frame redraws"), NumRedraws.FindRef(EveryFourth), 30);
+
+	// Capping goes on top of the refresh rate
+	Scheduler.SetMaxRate(EveryFrame, 10.0f);
+	Scheduler.RemoveViewport(ThirtyHz);
+	NumRedraws.Reset();
+	for (int32 Frame = 121; Frame <= 240; ++Frame)
+	{
+		Scheduler.Tick(Frame, Frame / 60.0, 0.0f, [&NumRedraws](FViewportSyncHandle ViewportHandle)
+		{
+			++NumRedraws.FindOrAdd(ViewportHandle);
+		});
+	}
+
+	TestTrue(FString::Printf(TEXT("Capped to 10 Hz redraws %d times in 2 seconds"), NumRedraws.FindRef(EveryFrame)), FMath::Abs(NumRedraws.FindRef(EveryFrame) - 20) <= 1);
+	TestEqual(TEXT("Removed viewport redraws"), NumRedraws.FindRef(ThirtyHz), 0);
+	TestEqual(TEXT("Num"), Scheduler.Num(), 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncSchedulerStaggerTest, "ViewportSync.Core.Scheduler.Stagger", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncSchedulerStaggerTest::RunTest(const FString& Parameters)
+{
+	const FViewportSyncHandle First(0, 0);
+	const FViewportSyncHandle Second(1, 0);
+
+	FViewportSyncScheduler Scheduler;
+	Scheduler.AddViewport(First, FViewportSyncRefreshRate::Hz(30.0f));
+	Scheduler.AddViewport(Second, FViewportSyncRefreshRate::Hz(30.0f));
+
+	// 2 seconds of a 60 fps editor, no budget, so only the phase keeps them apart
+	TMap<FViewportSyncHandle, int32> NumRedraws;
+	for (int32 Frame = 1; Frame <= 120; ++Frame)
+	{
+		int32 NumRedrawnThisFrame = 0;
+		Scheduler.Tick(Frame, Frame / 60.0, 0.0f, [&NumRedraws, &NumRedrawnThisFrame](FViewportSyncHandle ViewportHandle)
+		{
+			++NumRedraws.FindOrAdd(ViewportHandle);
+			++NumRedrawnThisFrame;
+		});
+
+		TestTrue(FString::Printf(TEXT("Redraws on frame %d"), Frame), NumRedrawnThisFrame <= 1);
+	}
+
+	TestTrue(FString::Printf(TEXT("First 30 Hz redraws %d times in 2 seconds"), NumRedraws.FindRef(First)), FMath::Abs(NumRedraws.FindRef(First) - 60) <= 1);
+	TestTrue(FString::Printf(TEXT("Second 30 Hz redraws %d times in 2 seconds"), NumRedraws.FindRef(Second)), FMath::Abs(NumRedraws.FindRef(Second) - 60) <= 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncSchedulerBudgetTest, "ViewportSync.Core.Scheduler.Budget", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncSchedulerBudgetTest::RunTest(const FString& Parameters)
+{
+	const int32 NumViewports = 4;
+
+	FViewportSyncScheduler Scheduler;
+	for (int32 Index = 0; Index < NumViewports; ++Index)
+	{
+		Scheduler.AddViewport(FViewportSyncHandle(Index, 0), FViewportSyncRefreshRate());
+	}
+
+	// Every redraw costs about 2ms against a 1ms budget, so only the first one each frame fits
+	TMap<FViewportSyncHandle, int32> NumRedraws;
+	for (int32 Frame = 1; Frame <= NumViewports * 5; ++Frame)
+	{
+		int32 NumRedrawnThisFrame = 0;
+		Scheduler.Tick(Frame, Frame / 60.0, 1.0f, [&NumRedraws, &NumRedrawnThisFrame](FViewportSyncHandle ViewportHandle)
+		{
+			const double EndTime = FPlatformTime::Seconds() + 0.002;
+			while (FPlatformTime::Seconds() < EndTime)
+			{
+			}
+
+			++NumRedraws.FindOrAdd(ViewportHandle);
+			++NumRedrawnThisFrame;
+		});
+
+		TestEqual(FString::Printf(TEXT("Redraws on frame %d"), Frame), NumRedrawnThisFrame, 1);
+	}
+
+	// Deferred viewports go first the next frame, so they take turns rather than one hogging the budget
+	for (int32 Index = 0; Index < NumViewports; ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("Redraws of viewport %d"), Index), NumRedraws.FindRef(FViewportSyncHandle(Index, 0)), 5);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
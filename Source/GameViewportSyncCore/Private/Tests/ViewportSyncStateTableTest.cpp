@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncStateTable.h"
+
+// UE Includes
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FViewportSyncStateTableTest, "ViewportSync.Core.StateTable", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FViewportSyncStateTableTest::RunTest(const FString& Parameters)
+{
+	TViewportSyncStateTable<int32, int32, FString> Table;
+
+	const FViewportSyncHandle First = Table.Add(10, 1, TEXT("First"));
+	const FViewportSyncHandle Second = Table.Add(20, 2, TEXT("Second"));
+	const FViewportSyncHandle Third = Table.Add(30, 3, TEXT("Third"));
+
+	TestEqual(TEXT("Num"), Table.Num(), 3);
+	TestTrue(TEXT("Find returns the handle Add did"), Table.Find(20) == Second);
+	TestEqual(TEXT("Key of a handle"), Table.GetKey(Third), 30);
+
+	// Cold data is heap allocated, it stays put while other entries move around
+	const FString* SecondCold = Table.GetCold(Second);
+
+	int32 RemovedHot = 0;
+	FString RemovedCold;
+	TestTrue(TEXT("Remove"), Table.Remove(First, &RemovedHot, &RemovedCold));
+	TestEqual(TEXT("Removed hot data moved out"), RemovedHot, 1);
+	TestEqual(TEXT("Removed cold data moved out"), RemovedCold, FString(TEXT("First")));
+
+	// The last entry was swapped into the hole, its handle still finds it
+	TestEqual(TEXT("Num after remove"), Table.Num(), 2);
+	TestFalse(TEXT("Removed handle is stale"), Table.IsValid(First));
+	TestNull(TEXT("Removed handle finds nothing"), Table.GetHot(First));
+	TestEqual(TEXT("Swapped entry's hot data"), *Table.GetHot(Third), 3);
+	TestEqual(TEXT("Swapped entry's key"), Table.KeyAt(0), 30);
+	TestTrue(TEXT("Dense index hands back the swapped entry's handle"), Table.HandleAt(0) == Third);
+	TestTrue(TEXT("Cold data didn't move"), Table.GetCold(Second) == SecondCold);
+
+	// The freed slot is reused with a new generation, the old handle doesn't start pointing at the new entry
+	const FViewportSyncHandle Fourth = Table.Add(40, 4, TEXT("Fourth"));
+	TestEqual(TEXT("Slot is reused"), Fourth.SlotIndex, First.SlotIndex);
+	TestFalse(TEXT("Old handle is still stale"), Table.IsValid(First));
+	TestEqual(TEXT("New entry"), *Table.GetHot(Fourth), 4);
+
+	TestFalse(TEXT("Removing twice"), Table.Remove(First));
+	TestFalse(TEXT("Contains a removed key"), Table.Contains(10));
+	TestFalse(TEXT("Find a removed key"), Table.Find(10).IsSet());
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncAllocationCounter.h"
+
+// UE Includes
+#include "HAL/MemoryBase.h"
+
+#if !UE_BUILD_SHIPPING
+namespace ViewportSyncAllocationCounter
+{
+	/* Never created, only here to get at FMalloc's protected counts */
+	class FMallocCallCounts : public FMalloc
+	{
+	public:
+		static uint64 GetTotal()
+		{
+			return TotalMallocCalls.Load(EMemoryOrder::Relaxed) + TotalReallocCalls.Load(EMemoryOrder::Relaxed);
+		}
+	};
+}
+#endif
+
+bool FViewportSyncAllocationCounter::IsAvailable()
+{
+#if !UE_BUILD_SHIPPING
+	using namespace ViewportSyncAllocationCounter;
+
+	// Allocators that don't keep the counts leave them at 0, see if one of ours moves them
+	static const bool bAvailable = []()
+	{
+		const uint64 StartTotal = FMallocCallCounts::GetTotal();
+		void* Probe = FMemory::Malloc(16);
+		const bool bCounted = FMallocCallCounts::GetTotal() != StartTotal;
+		FMemory::Free(Probe);
+		return bCounted;
+	}();
+
+	return bAvailable;
+#else
+	return false;
+#endif
+}
+
+uint64 FViewportSyncAllocationCounter::GetTotal()
+{
+#if !UE_BUILD_SHIPPING
+	return ViewportSyncAllocationCounter::FMallocCallCounts::GetTotal();
+#else
+	return 0;
+#endif
+}
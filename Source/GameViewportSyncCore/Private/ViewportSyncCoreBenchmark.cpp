@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncCoreBenchmark.h"
+#include "ViewportSyncAllocationCounter.h"
+#include "ViewportSyncFollowCore.h"
+#include "ViewportSyncMockFollowView.h"
+#include "ViewportSyncStateTable.h"
+
+namespace ViewportSyncCoreBenchmark
+{
+	static const float FrameDeltaTime = 1.0f / 60.0f;
+
+	// Same as the plugin's default movement threshold
+	static const float MovementThresholdSquared = FMath::Square(0.1f);
+
+	// Frames run before timing starts, so the filters have settled
+	static const int32 WarmupFrames = 30;
+
+	/* Each viewport's target circles at its own phase */
+	static FVector GetTargetLocation(int32 ViewportId, float Time)
+	{
+		const float Angle = Time + ViewportId * 0.37f;
+		return FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * 1000.0f;
+	}
+}
+
+FViewportSyncCoreBenchmarkResult FViewportSyncCoreBenchmark::Run(int32 NumViewports, int32 NumFrames)
+{
+	using namespace ViewportSyncCoreBenchmark;
+
+	NumViewports = FMath::Max(NumViewports, 1);
+	NumFrames = FMath::Max(NumFrames, 1);
+
+	TViewportSyncStateTable<int32, FViewportSyncFollowState, FViewportSyncMockFollowView> Viewports;
+	for (int32 ViewportId = 0; ViewportId < NumViewports; ++ViewportId)
+	{
+		Viewports.Add(ViewportId, FViewportSyncFollowState(), FViewportSyncMockFollowView());
+	}
+
+	uint64 MeasuredCycles = 0;
+	uint64 MaxAllocations = 0;
+	uint64 TotalAllocations = 0;
+
+	for (int32 Frame = 0; Frame < WarmupFrames + NumFrames; ++Frame)
+	{
+		const float Time = Frame * FrameDeltaTime;
+		const bool bMeasured = Frame >= WarmupFrames;
+
+		const FViewportSyncAllocationScope AllocationScope;
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		for (int32 ViewportIndex = 0; ViewportIndex < Viewports.Num(); ++ViewportIndex)
+		{
+			const int32 ViewportId = Viewports.KeyAt(ViewportIndex);
+			FViewportSyncFollowState& State = Viewports.HotAt(ViewportIndex);
+
+			State.PendingDeltaTime += FrameDeltaTime;
+			if (!FViewportSyncFollowCore::ShouldUpdate(State, Time, FrameDeltaTime, (ViewportId & 1) ? 30.0f : 0.0f))
+			{
+				continue;
+			}
+
+			const float DeltaTime = FViewportSyncFollowCore::ConsumeDeltaTime(State);
+			const FVector Target = GetTargetLocation(ViewportId, Time);
+
+			if ((ViewportId & 3) == 3)
+			{
+				FViewportSyncFollowCore::FrameLocation(State, Viewports.ColdAt(ViewportIndex), Target, 500.0f, 200.0f, DeltaTime, MovementThresholdSquared);
+			}
+			else
+			{
+				float Lag = 0.0f;
+				FViewportSyncFollowCore::FollowLocation(State, Viewports.ColdAt(ViewportIndex), Target, DeltaTime, MovementThresholdSquared, Lag);
+			}
+		}
+
+		const uint64 FrameCycles = FPlatformTime::Cycles64() - StartCycles;
+		const uint64 FrameAllocations = AllocationScope.GetCount();
+
+		if (bMeasured)
+		{
+			MeasuredCycles += FrameCycles;
+			TotalAllocations += FrameAllocations;
+			MaxAllocations = FMath::Max(MaxAllocations, FrameAllocations);
+		}
+	}
+
+	FViewportSyncCoreBenchmarkResult Result;
+	Result.NsPerViewport = FPlatformTime::ToSeconds64(MeasuredCycles) * 1.0e9 / (static_cast<double>(NumFrames) * NumViewports);
+	Result.AllocsPerTick = static_cast<double>(TotalAllocations) / NumFrames;
+	Result.MaxAllocsPerTick = MaxAllocations;
+	Result.bAllocationsCounted = FViewportSyncAllocationCounter::IsAvailable();
+	return Result;
+}
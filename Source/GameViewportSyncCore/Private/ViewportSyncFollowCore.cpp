@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncFollowCore.h"
+
+FViewportSyncFollowState::FViewportSyncFollowState()
+	: LastAppliedLocation(FVector::ZeroVector)
+	, OrbitDistance(0.0f)
+	, PendingDeltaTime(0.0f)
+	, LastUpdateTime(0.0)
+	, bForceUpdate(true)
+{}
+
+bool FViewportSyncFollowCore::ShouldUpdate(FViewportSyncFollowState& State, double CurrentTime, float DeltaTime, float UpdateRate)
+{
+	if (UpdateRate > 0.0f && !State.bForceUpdate && (CurrentTime - State.LastUpdateTime) + DeltaTime * 0.5 < 1.0 / UpdateRate)
+	{
+		return false;
+	}
+
+	State.LastUpdateTime = CurrentTime;
+	return true;
+}
+
+float FViewportSyncFollowCore::ConsumeDeltaTime(FViewportSyncFollowState& State)
+{
+	const float DeltaTime = State.PendingDeltaTime;
+	State.PendingDeltaTime = 0.0f;
+	return DeltaTime;
+}
+
+bool FViewportSyncFollowCore::FollowLocation(FViewportSyncFollowState& State, IViewportSyncFollowView& View, const FVector& TargetLocation, float DeltaTime, float MovementThresholdSquared, float& OutLag)
+{
+	/*
+	 * This could happen if the target wasn't first available when we hit play
+	 * Such as a player pawn or some other object
+	 */
+	if (!View.IsFollowing())
+	{
+		View.BeginFollow(TargetLocation);
+		State.Filter.Reset(TargetLocation);
+		State.bForceUpdate = true;
+		return false;
+	}
+
+	/*
+	 * To get the combination required to allow for orbiting and *not* allowing the user to control was getting really convoluted.
+	 * Ultimately it meant setting the actor lock but I didn't like the "Controlling Actor" UI or behaviour
+	 *
+	 * The result of this means each frame we update the look at location so the camera correctly updates to the target's new location
+	 */
+	const FVector FollowLocation = State.Filter.Update(TargetLocation, DeltaTime, State.FilterSettings);
+
+	// Leave the camera (and the viewport) alone until the target has moved far enough to matter
+	if (State.bForceUpdate || FVector::DistSquared(FollowLocation, State.LastAppliedLocation) > MovementThresholdSquared)
+	{
+		State.OrbitDistance = (View.GetLookAtLocation() - View.GetViewLocation()).Size();
+		View.SetOrbit(FollowLocation, State.OrbitDistance);
+
+		State.LastAppliedLocation = FollowLocation;
+		State.bForceUpdate = false;
+	}
+
+	// How far behind the target the camera is looking this frame
+	OutLag = FVector::Dist(State.LastAppliedLocation, TargetLocation);
+	return true;
+}
+
+void FViewportSyncFollowCore::FrameLocation(FViewportSyncFollowState& State, IViewportSyncFollowView& View, const FVector& Center, float Radius, float Padding, float DeltaTime, float MovementThresholdSquared)
+{
+	// Same as following a single target, the first frame puts the view into our orbit camera
+	if (!View.IsFollowing())
+	{
+		View.BeginFollow(Center);
+		State.Filter.Reset(Center);
+		State.bForceUpdate = true;
+		return;
+	}
+
+	const float CurrentOrbitDistance = (View.GetLookAtLocation() - View.GetViewLocation()).Size();
+	float OrbitDistance = CurrentOrbitDistance;
+
+	// Orthographic views zoom rather than dolly, leave those to the user
+	if (View.IsPerspective())
+	{
+		// The FOV is horizontal, back off far enough that a sphere around the group fits the narrower of the two
+		float HalfFOV = FMath::DegreesToRadians(FMath::Clamp(View.GetFOV(), 5.0f, 170.0f) * 0.5f);
+		const float AspectRatio = View.GetAspectRatio();
+		if (AspectRatio > 1.0f)
+		{
+			HalfFOV = FMath::Atan(FMath::Tan(HalfFOV) / AspectRatio);
+		}
+
+		const float DesiredOrbitDistance = (Radius + Padding) / FMath::Sin(HalfFOV);
+
+		// Ease in and out with the group using the follow smoothing time, so the zoom is as frame rate independent as the location
+		const bool bSmoothZoom = !State.bForceUpdate && State.FilterSettings.Filter != EViewportSyncFollowFilter::None;
+		const float ZoomAlpha = bSmoothZoom ? 1.0f - FMath::Exp(-DeltaTime / FMath::Max(State.FilterSettings.SmoothTime, KINDA_SMALL_NUMBER)) : 1.0f;
+		OrbitDistance = FMath::Lerp(CurrentOrbitDistance, DesiredOrbitDistance, ZoomAlpha);
+	}
+
+	const FVector FollowLocation = State.Filter.Update(Center, DeltaTime, State.FilterSettings);
+
+	if (State.bForceUpdate
+		|| FVector::DistSquared(FollowLocation, State.LastAppliedLocation) > MovementThresholdSquared
+		|| FMath::Square(OrbitDistance - CurrentOrbitDistance) > MovementThresholdSquared)
+	{
+		State.OrbitDistance = OrbitDistance;
+		View.SetOrbit(FollowLocation, OrbitDistance);
+
+		State.LastAppliedLocation = FollowLocation;
+		State.bForceUpdate = false;
+	}
+}
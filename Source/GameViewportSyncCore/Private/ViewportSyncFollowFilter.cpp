@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncFollowFilter.h"
+
+#define LOCTEXT_NAMESPACE "ViewportSyncFollowFilter"
+
+// One Euro cutoff used to smooth the velocity estimate, the reference implementation's default
+static const float OneEuroDerivativeCutoff = 1.0f;
+
+FViewportSyncFollowFilterSettings::FViewportSyncFollowFilterSettings()
+	: Filter(EViewportSyncFollowFilter::CriticallyDamped)
+	, ConstantSpeed(100.0f)
+	, SmoothTime(0.2f)
+	, OneEuroMinCutoff(1.0f)
+	, OneEuroBeta(0.005f)
+	, PredictionTime(0.0f)
+{}
+
+FText FViewportSyncFollowFilterSettings::GetDisplayText(EViewportSyncFollowFilter Filter)
+{
+	switch (Filter)
+	{
+	case EViewportSyncFollowFilter::None:
+		return LOCTEXT("None", "None");
+	case EViewportSyncFollowFilter::ConstantSpeed:
+		return LOCTEXT("ConstantSpeed", "Constant Speed");
+	case EViewportSyncFollowFilter::CriticallyDamped:
+		return LOCTEXT("CriticallyDamped", "Critically Damped Spring");
+	case EViewportSyncFollowFilter::OneEuro:
+		return LOCTEXT("OneEuro", "One Euro");
+	}
+	return FText::GetEmpty();
+}
+
+void FViewportSyncFollowFilter::Reset(const FVector& Target)
+{
+	Position = Target;
+	Velocity = FVector::ZeroVector;
+	PreviousTarget = Target;
+	bInitialized = true;
+}
+
+FVector FViewportSyncFollowFilter::Update(const FVector& Target, float DeltaTime, const FViewportSyncFollowFilterSettings& Settings)
+{
+	if (!bInitialized)
+	{
+		Reset(Target);
+		return GetOutput(Settings);
+	}
+
+	// Paused, nothing moved
+	if (DeltaTime <= 0.0f)
+	{
+		return GetOutput(Settings);
+	}
+
+	const FVector TargetVelocity = (Target - PreviousTarget) / DeltaTime;
+
+	switch (Settings.Filter)
+	{
+	case EViewportSyncFollowFilter::None:
+		{
+			Position = Target;
+			Velocity = TargetVelocity;
+			break;
+		}
+	case EViewportSyncFollowFilter::ConstantSpeed:
+		{
+			const FVector NewPosition = FMath::VInterpConstantTo(Position, Target, DeltaTime, Settings.ConstantSpeed);
+			Velocity = (NewPosition - Position) / DeltaTime;
+			Position = NewPosition;
+			break;
+		}
+	case EViewportSyncFollowFilter::CriticallyDamped:
+		{
+			/*
+			 * x'' + 2w x' + w^2 x = w^2 T(t), with T moving at TargetVelocity (v) for the length of the step.
+			 * Steady state is x = T - 2v/w, everything else is the homogeneous part which decays as (A + B t) e^(-wt).
+			 * Solving that exactly (rather than stepping it) is what keeps the result independent of the frame rate
+			 */
+			const float Omega = 2.0f / FMath::Max(Settings.SmoothTime, KINDA_SMALL_NUMBER);
+			const FVector SteadyStateLag = TargetVelocity * (2.0f / Omega);
+
+			const FVector Offset = Position - (PreviousTarget - SteadyStateLag);
+			const FVector OffsetVelocity = Velocity - TargetVelocity;
+
+			const FVector B = OffsetVelocity + Offset * Omega;
+			const float Decay = FMath::Exp(-Omega * DeltaTime);
+
+			const FVector NewOffset = (Offset + B * DeltaTime) * Decay;
+			const FVector NewOffsetVelocity = (B - (Offset + B * DeltaTime) * Omega) * Decay;
+
+			Position = Target - SteadyStateLag + NewOffset;
+			Velocity = TargetVelocity + NewOffsetVelocity;
+			break;
+		}
+	case EViewportSyncFollowFilter::OneEuro:
+		{
+			// Smoothing factors come from the time that actually passed, instead of the usual per sample ones
+			const float DerivativeAlpha = 1.0f - FMath::Exp(-2.0f * PI * OneEuroDerivativeCutoff * DeltaTime);
+			Velocity = FMath::Lerp(Velocity, TargetVelocity, DerivativeAlpha);
+
+			/*
+			 * Low pass x' = k (T - x) with T moving at TargetVelocity for the step, solved exactly.
+			 * Treating the target as still for the whole step would leave us a different distance behind at every frame rate
+			 */
+			const float CutoffRate = 2.0f * PI * FMath::Max(Settings.OneEuroMinCutoff + Settings.OneEuroBeta * Velocity.Size(), KINDA_SMALL_NUMBER);
+			const FVector SteadyStateLag = TargetVelocity / CutoffRate;
+			Position = Target - SteadyStateLag + (Position - PreviousTarget + SteadyStateLag) * FMath::Exp(-CutoffRate * DeltaTime);
+			break;
+		}
+	}
+
+	PreviousTarget = Target;
+
+	return GetOutput(Settings);
+}
+
+FVector FViewportSyncFollowFilter::GetOutput(const FViewportSyncFollowFilterSettings& Settings) const
+{
+	// Lead the target by how fast it's moving so the camera doesn't trail behind fast actors
+	return Position + Velocity * Settings.PredictionTime;
+}
+
+#undef LOCTEXT_NAMESPACE
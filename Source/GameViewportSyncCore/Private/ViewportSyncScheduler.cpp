@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ViewportSyncScheduler.h"
+
+#define LOCTEXT_NAMESPACE "ViewportSyncScheduler"
+
+FText FViewportSyncRefreshRate::GetDisplayText() const
+{
+	if (FrameInterval > 1)
+	{
+		return FText::Format(LOCTEXT("EveryNthFrame", "Every {0} Frames"), FText::AsNumber(FrameInterval));
+	}
+	if (TargetHz > 0.0f)
+	{
+		return FText::Format(LOCTEXT("TargetHz", "{0} Hz"), FText::AsNumber(TargetHz));
+	}
+	return LOCTEXT("EveryFrame", "Every Frame");
+}
+
+int64 FViewportSyncScheduler::FScheduledViewport::GetRedrawSlot(uint64 FrameNumber, double CurrentTime, float DeltaTime) const
+{
+	if (RefreshRate.FrameInterval > 1)
+	{
+		return static_cast<int64>(FMath::FloorToDouble(static_cast<double>(static_cast<int64>(FrameNumber) - PhaseFrames) / RefreshRate.FrameInterval));
+	}
+
+	if (RefreshRate.TargetHz > 0.0f)
+	{
+		/*
+		 * Allow half a frame of slack, otherwise a 60Hz viewport in a 60fps editor would alias down to 30Hz
+		 * whenever the frame came in a fraction of a millisecond early
+		 */
+		return static_cast<int64>(FMath::FloorToDouble((CurrentTime + DeltaTime * 0.5 - PhaseTime) * RefreshRate.TargetHz));
+	}
+
+	return static_cast<int64>(FrameNumber);
+}
+
+bool FViewportSyncScheduler::FScheduledViewport::IsDue(int64 RedrawSlot, double CurrentTime, float DeltaTime) const
+{
+	if (MaxHz > 0.0f && (CurrentTime - LastRedrawTime) + DeltaTime * 0.5 < 1.0 / MaxHz)
+	{
+		return false;
+	}
+
+	return RefreshRate.IsEveryFrame() || RedrawSlot > LastRedrawSlot;
+}
+
+void FViewportSyncScheduler::UpdatePhases()
+{
+	for (int32 Index = 0; Index < ScheduledViewports.Num(); ++Index)
+	{
+		FScheduledViewport& ScheduledViewport = ScheduledViewports[Index];
+
+		// This viewport's place among the ones with the same refresh rate, and how many of those there are
+		int32 Slot = 0;
+		int32 NumSharingRate = 0;
+		for (int32 OtherIndex = 0; OtherIndex < ScheduledViewports.Num(); ++OtherIndex)
+		{
+			if (ScheduledViewports[OtherIndex].RefreshRate == ScheduledViewport.RefreshRate)
+			{
+				Slot += OtherIndex < Index ? 1 : 0;
+				++NumSharingRate;
+			}
+		}
+
+		const double PhaseTime = ScheduledViewport.RefreshRate.TargetHz > 0.0f ? Slot / (ScheduledViewport.RefreshRate.TargetHz * NumSharingRate) : 0.0;
+		const int64 PhaseFrames = ScheduledViewport.RefreshRate.FrameInterval > 1 ? (static_cast<int64>(Slot) * ScheduledViewport.RefreshRate.FrameInterval) / NumSharingRate : 0;
+
+		if (PhaseTime != ScheduledViewport.PhaseTime || PhaseFrames != ScheduledViewport.PhaseFrames)
+		{
+			ScheduledViewport.PhaseTime = PhaseTime;
+			ScheduledViewport.PhaseFrames = PhaseFrames;
+
+			// Slots counted from the old phase don't line up with the new one
+			ScheduledViewport.bHasRedrawSlot = false;
+		}
+	}
+}
+
+void FViewportSyncScheduler::AddViewport(FViewportSyncHandle ViewportHandle, const FViewportSyncRefreshRate& RefreshRate)
+{
+	for (FScheduledViewport& ScheduledViewport : ScheduledViewports)
+	{
+		if (ScheduledViewport.ViewportHandle == ViewportHandle)
+		{
+			ScheduledViewport.RefreshRate = RefreshRate;
+			UpdatePhases();
+			return;
+		}
+	}
+
+	ScheduledViewports.Emplace(ViewportHandle, RefreshRate);
+	UpdatePhases();
+}
+
+void FViewportSyncScheduler::RemoveViewport(FViewportSyncHandle ViewportHandle)
+{
+	const int32 Index = ScheduledViewports.IndexOfByPredicate([ViewportHandle](const FScheduledViewport& ScheduledViewport)
+	{
+		return ScheduledViewport.ViewportHandle == ViewportHandle;
+	});
+
+	if (Index != INDEX_NONE)
+	{
+		ScheduledViewports.RemoveAt(Index);
+
+		if (RoundRobinIndex > Index)
+		{
+			--RoundRobinIndex;
+		}
+
+		UpdatePhases();
+	}
+}
+
+void FViewportSyncScheduler::Reset()
+{
+	ScheduledViewports.Reset();
+	RoundRobinIndex = 0;
+	LastTickTime = 0.0;
+}
+
+void FViewportSyncScheduler::SetRefreshRate(FViewportSyncHandle ViewportHandle, const FViewportSyncRefreshRate& RefreshRate)
+{
+	for (FScheduledViewport& ScheduledViewport : ScheduledViewports)
+	{
+		if (ScheduledViewport.ViewportHandle == ViewportHandle)
+		{
+			if (!(ScheduledViewport.RefreshRate == RefreshRate))
+			{
+				ScheduledViewport.RefreshRate = RefreshRate;
+				UpdatePhases();
+			}
+			return;
+		}
+	}
+}
+
+void FViewportSyncScheduler::SetMaxRate(FViewportSyncHandle ViewportHandle, float MaxHz)
+{
+	for (FScheduledViewport& ScheduledViewport : ScheduledViewports)
+	{
+		if (ScheduledViewport.ViewportHandle == ViewportHandle)
+		{
+			ScheduledViewport.MaxHz = FMath::Max(MaxHz, 0.0f);
+			return;
+		}
+	}
+}
+
+void FViewportSyncScheduler::Tick(uint64 FrameNumber, double CurrentTime, float FrameBudgetMs, TFunctionRef<void(FViewportSyncHandle)> RedrawViewport)
+{
+	const float DeltaTime = LastTickTime > 0.0 ? static_cast<float>(CurrentTime - LastTickTime) : 0.0f;
+	LastTickTime = CurrentTime;
+
+	const int32 NumViewports = ScheduledViewports.Num();
+	if (NumViewports == 0)
+	{
+		return;
+	}
+
+	RoundRobinIndex = RoundRobinIndex % NumViewports;
+
+	const bool bHasBudget = FrameBudgetMs > 0.0f;
+	float SpentMs = 0.0f;
+	int32 NumRedrawn = 0;
+	int32 FirstDeferredIndex = INDEX_NONE;
+
+	for (int32 Offset = 0; Offset < NumViewports; ++Offset)
+	{
+		const int32 Index = (RoundRobinIndex + Offset) % NumViewports;
+		FScheduledViewport& ScheduledViewport = ScheduledViewports[Index];
+
+		const int64 RedrawSlot = ScheduledViewport.GetRedrawSlot(FrameNumber, CurrentTime, DeltaTime);
+		if (!ScheduledViewport.bHasRedrawSlot)
+		{
+			// Start counting from the interval we're in, the first redraw is at the start of this viewport's next one
+			ScheduledViewport.LastRedrawSlot = RedrawSlot;
+			ScheduledViewport.bHasRedrawSlot = true;
+		}
+
+		if (!ScheduledViewport.IsDue(RedrawSlot, CurrentTime, DeltaTime))
+		{
+			continue;
+		}
+
+		/*
+		 * The first redraw of a frame is always allowed, otherwise a single viewport that costs more than the whole budget would never draw.
+		 * Because deferred viewports go first next frame this still only ever draws one expensive viewport per frame.
+		 */
+		if (bHasBudget && NumRedrawn > 0 && SpentMs + ScheduledViewport.AverageRedrawCostMs > FrameBudgetMs)
+		{
+			if (FirstDeferredIndex == INDEX_NONE)
+			{
+				FirstDeferredIndex = Index;
+			}
+			continue;
+		}
+
+		const double RedrawStartTime = FPlatformTime::Seconds();
+		RedrawViewport(ScheduledViewport.ViewportHandle);
+		const float RedrawCostMs = static_cast<float>((FPlatformTime::Seconds() - RedrawStartTime) * 1000.0);
+
+		ScheduledViewport.AverageRedrawCostMs = ScheduledViewport.AverageRedrawCostMs > 0.0f ? FMath::Lerp(ScheduledViewport.AverageRedrawCostMs, RedrawCostMs, 0.2f) : RedrawCostMs;
+		ScheduledViewport.LastRedrawTime = CurrentTime;
+		ScheduledViewport.LastRedrawSlot = RedrawSlot;
+
+		SpentMs += RedrawCostMs;
+		++NumRedrawn;
+	}
+
+	// Anything we had to skip gets first go next frame, otherwise just rotate so the same viewport isn't always first
+	RoundRobinIndex = FirstDeferredIndex != INDEX_NONE ? FirstDeferredIndex : RoundRobinIndex + 1;
+}
+
+#undef LOCTEXT_NAMESPACE
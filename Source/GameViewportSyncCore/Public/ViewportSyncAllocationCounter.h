@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Reads the allocation call counts FMalloc keeps itself (mallocs and reallocs, every thread), so nothing has to wrap GMalloc.
+ *
+ * The counts are compiled out of shipping builds and not every allocator keeps them, IsAvailable says whether they can be used.
+ * The ansi allocator (-ansimalloc) counts every call, which makes the numbers easier to compare between runs.
+ */
+class GAMEVIEWPORTSYNCCORE_API FViewportSyncAllocationCounter
+{
+public:
+	static bool IsAvailable();
+
+	/* Allocations made by every thread so far, 0 when not available */
+	static uint64 GetTotal();
+};
+
+/**
+ * Counts the allocations made between being created and GetCount being called.
+ * Other threads' allocations are counted too, the quieter the rest of the process the closer it is to just the scope's own
+ */
+class FViewportSyncAllocationScope
+{
+public:
+	FViewportSyncAllocationScope()
+		: StartTotal(FViewportSyncAllocationCounter::GetTotal())
+	{}
+
+	uint64 GetCount() const { return FViewportSyncAllocationCounter::GetTotal() - StartTotal; }
+
+private:
+	uint64 StartTotal;
+};
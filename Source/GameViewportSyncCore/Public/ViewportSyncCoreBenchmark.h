@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * What a run of the follow core microbenchmark measured
+ */
+struct FViewportSyncCoreBenchmarkResult
+{
+	double NsPerViewport;
+
+	// Only counted when FViewportSyncAllocationCounter is available, see bAllocationsCounted
+	double AllocsPerTick;
+	uint64 MaxAllocsPerTick;
+	bool bAllocationsCounted;
+
+	FViewportSyncCoreBenchmarkResult()
+		: NsPerViewport(0.0)
+		, AllocsPerTick(0.0)
+		, MaxAllocsPerTick(0)
+		, bAllocationsCounted(false)
+	{}
+};
+
+/**
+ * Times the follow core's per tick work over a table of mock viewports, the same work the subsystem does each tick:
+ * add up the game time, see if the viewport is due and if it is, follow its target (every 4th viewport frames a group instead).
+ * Half the viewports are throttled to 30 Hz.
+ *
+ * Doesn't need PIE or any viewports so it runs from the test program as well as the editor.
+ */
+class GAMEVIEWPORTSYNCCORE_API FViewportSyncCoreBenchmark
+{
+public:
+	static FViewportSyncCoreBenchmarkResult Run(int32 NumViewports, int32 NumFrames);
+};
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ViewportSyncFollowFilter.h"
+
+/**
+ * The camera a follow update steers.
+ *
+ * The subsystem implements this over level editor viewports, anything that wants to run the follow math without an editor
+ * (checks, microbenchmarks) can implement it over plain data.
+ */
+class IViewportSyncFollowView
+{
+public:
+	virtual ~IViewportSyncFollowView() {}
+
+	/* Whether the camera is orbiting for us, false until BeginFollow or after the user took the camera back */
+	virtual bool IsFollowing() const = 0;
+
+	/* Take the camera over and point it at Location */
+	virtual void BeginFollow(const FVector& Location) = 0;
+
+	virtual FVector GetLookAtLocation() const = 0;
+	virtual FVector GetViewLocation() const = 0;
+
+	/* Orbit Location from Distance away, keeping the camera's current angle */
+	virtual void SetOrbit(const FVector& Location, float Distance) = 0;
+
+	virtual bool IsPerspective() const = 0;
+
+	/* Horizontal FOV in degrees */
+	virtual float GetFOV() const = 0;
+
+	/* Width over height, 0 when the view has no size (yet) */
+	virtual float GetAspectRatio() const = 0;
+};
+
+/**
+ * Per viewport follow state carried between updates
+ */
+struct GAMEVIEWPORTSYNCCORE_API FViewportSyncFollowState
+{
+	// Smooths (and optionally predicts) the target's location
+	FViewportSyncFollowFilter Filter;
+
+	// How this viewport smooths its target
+	FViewportSyncFollowFilterSettings FilterSettings;
+
+	// Location the camera was last told to orbit, used to skip camera updates while the target is idle
+	FVector LastAppliedLocation;
+
+	// Distance between the camera and the location it orbits, as of the last update
+	float OrbitDistance;
+
+	// Game time since the follow math last ran, more than a frame's worth when the viewport is throttled
+	float PendingDeltaTime;
+
+	// When the follow math last ran, for throttling
+	double LastUpdateTime;
+
+	// Apply the next update even if the target hasn't moved, e.g. after the target changed
+	bool bForceUpdate;
+
+	FViewportSyncFollowState();
+};
+
+/**
+ * The follow math, with no ties to the editor: smooths where the target is and steers a view to orbit it.
+ * Actors, worlds and settings are the caller's business, everything in here works on locations
+ */
+struct GAMEVIEWPORTSYNCCORE_API FViewportSyncFollowCore
+{
+	/* Whether a viewport updating at UpdateRate Hz (0 for every frame) is due this frame. Has the same half frame of slack as the scheduler */
+	static bool ShouldUpdate(FViewportSyncFollowState& State, double CurrentTime, float DeltaTime, float UpdateRate);
+
+	/* Takes the game time that has built up since the last update */
+	static float ConsumeDeltaTime(FViewportSyncFollowState& State);
+
+	/*
+	 * Orbit a single target
+	 * @param MovementThresholdSquared	Leave the camera alone until the smoothed target has moved further than this
+	 * @param OutLag					How far behind the target the camera is looking after this update
+	 * @return False if this update only took the camera over, there's no lag to speak of yet
+	 */
+	static bool FollowLocation(FViewportSyncFollowState& State, IViewportSyncFollowView& View, const FVector& TargetLocation, float DeltaTime, float MovementThresholdSquared, float& OutLag);
+
+	/* Orbit the center of a group, zooming a perspective view out far enough to fit a sphere of Radius plus Padding */
+	static void FrameLocation(FViewportSyncFollowState& State, IViewportSyncFollowView& View, const FVector& Center, float Radius, float Padding, float DeltaTime, float MovementThresholdSquared);
+};
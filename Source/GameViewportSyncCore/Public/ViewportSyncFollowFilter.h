@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * How a synced viewport smooths out the movement of the actor it follows.
+ * UViewportSyncSettings has a UENUM copy of this for the project default, keep the two in step
+ */
+enum class EViewportSyncFollowFilter : uint8
+{
+	/* Snap straight to the actor every frame */
+	None,
+
+	/* Move towards the actor at a fixed speed (FollowActorSmoothSpeed) */
+	ConstantSpeed,
+
+	/* Critically damped spring, eases in and out without overshooting */
+	CriticallyDamped,
+
+	/* One Euro filter, smooths out jitter on slow targets but stays responsive on fast ones */
+	OneEuro
+};
+
+/**
+ * Per viewport follow smoothing settings, starts off as the project defaults
+ */
+struct GAMEVIEWPORTSYNCCORE_API FViewportSyncFollowFilterSettings
+{
+	EViewportSyncFollowFilter Filter;
+
+	// Units per second for ConstantSpeed
+	float ConstantSpeed;
+
+	// Roughly how long (in seconds) the spring takes to catch up with the actor
+	float SmoothTime;
+
+	// One Euro cutoff (in Hz) when the actor is still, and how much that cutoff rises per uu/s of actor speed
+	float OneEuroMinCutoff;
+	float OneEuroBeta;
+
+	// How far ahead (in seconds) to extrapolate the smoothed velocity, 0 disables prediction
+	float PredictionTime;
+
+	FViewportSyncFollowFilterSettings();
+
+	static FText GetDisplayText(EViewportSyncFollowFilter Filter);
+};
+
+/**
+ * Smooths a follow target's location over time.
+ *
+ * Every mode is stepped with the PIE world's delta time and integrated exactly for the time that passed rather than per frame,
+ * so the camera moves the same whether the editor runs at 30, 60 or 144 Hz. The target is treated as moving in a straight line between updates.
+ */
+class GAMEVIEWPORTSYNCCORE_API FViewportSyncFollowFilter
+{
+public:
+	FViewportSyncFollowFilter()
+		: Position(FVector::ZeroVector)
+		, Velocity(FVector::ZeroVector)
+		, PreviousTarget(FVector::ZeroVector)
+		, bInitialized(false)
+	{}
+
+	/* Snap to the target, forgetting any velocity we had */
+	void Reset(const FVector& Target);
+
+	/* The next update snaps to wherever the target is */
+	void Invalidate() { bInitialized = false; }
+
+	/*
+	 * Step the filter towards the target's latest location
+	 * @return	Where the camera should look, including any prediction
+	 */
+	FVector Update(const FVector& Target, float DeltaTime, const FViewportSyncFollowFilterSettings& Settings);
+
+	/* Where the camera should look without stepping the filter */
+	FVector GetOutput(const FViewportSyncFollowFilterSettings& Settings) const;
+
+	const FVector& GetPosition() const { return Position; }
+	const FVector& GetVelocity() const { return Velocity; }
+
+	bool IsInitialized() const { return bInitialized; }
+
+private:
+	FVector Position;
+	FVector Velocity;
+
+	// Target location as of the last update, used to work out how fast it is moving
+	FVector PreviousTarget;
+
+	bool bInitialized;
+};
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ViewportSyncFollowCore.h"
+
+/**
+ * A follow view that's only a camera location and look at, and counts what was done to it.
+ * Stands in for a level editor viewport when running the follow core without an editor
+ */
+class FViewportSyncMockFollowView : public IViewportSyncFollowView
+{
+public:
+	FVector LookAtLocation;
+	FVector ViewLocation;
+
+	float FOV;
+	float AspectRatio;
+
+	bool bFollowing;
+	bool bPerspective;
+
+	int32 NumBeginFollows;
+	int32 NumOrbitUpdates;
+
+	FViewportSyncMockFollowView()
+		: LookAtLocation(FVector::ZeroVector)
+		, ViewLocation(-1000.0f, 0.0f, 500.0f)
+		, FOV(90.0f)
+		, AspectRatio(16.0f / 9.0f)
+		, bFollowing(false)
+		, bPerspective(true)
+		, NumBeginFollows(0)
+		, NumOrbitUpdates(0)
+	{}
+
+	float GetOrbitDistance() const { return FVector::Dist(LookAtLocation, ViewLocation); }
+
+	// Begin IViewportSyncFollowView
+	virtual bool IsFollowing() const override { return bFollowing; }
+
+	virtual void BeginFollow(const FVector& Location) override
+	{
+		// Keeps the camera where it is relative to what it looks at, like the editor's camera lock does
+		ViewLocation += Location - LookAtLocation;
+		LookAtLocation = Location;
+		bFollowing = true;
+		++NumBeginFollows;
+	}
+
+	virtual FVector GetLookAtLocation() const override { return LookAtLocation; }
+	virtual FVector GetViewLocation() const override { return ViewLocation; }
+
+	virtual void SetOrbit(const FVector& Location, float Distance) override
+	{
+		const FVector Direction = (ViewLocation - LookAtLocation).GetSafeNormal();
+		LookAtLocation = Location;
+		ViewLocation = Location + Direction * Distance;
+		++NumOrbitUpdates;
+	}
+
+	virtual bool IsPerspective() const override { return bPerspective; }
+	virtual float GetFOV() const override { return FOV; }
+	virtual float GetAspectRatio() const override { return AspectRatio; }
+	// End IViewportSyncFollowView
+};
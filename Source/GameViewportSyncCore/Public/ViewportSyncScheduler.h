@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ViewportSyncStateTable.h"
+
+/**
+ * How often a synced viewport should be redrawn
+ */
+struct GAMEVIEWPORTSYNCCORE_API FViewportSyncRefreshRate
+{
+	// Target refresh rate in Hz. 0 means every frame
+	float TargetHz;
+
+	// Redraw every Nth editor frame. Takes precedence over TargetHz when greater than 1
+	int32 FrameInterval;
+
+	FViewportSyncRefreshRate()
+		: TargetHz(0.0f)
+		, FrameInterval(0)
+	{}
+
+	static FViewportSyncRefreshRate Hz(float InTargetHz)
+	{
+		FViewportSyncRefreshRate Rate;
+		Rate.TargetHz = FMath::Max(InTargetHz, 0.0f);
+		return Rate;
+	}
+
+	static FViewportSyncRefreshRate EveryNthFrame(int32 InFrameInterval)
+	{
+		FViewportSyncRefreshRate Rate;
+		Rate.FrameInterval = FMath::Max(InFrameInterval, 0);
+		return Rate;
+	}
+
+	bool IsEveryFrame() const { return FrameInterval <= 1 && TargetHz <= 0.0f; }
+
+	bool operator==(const FViewportSyncRefreshRate& Other) const
+	{
+		return TargetHz == Other.TargetHz && FrameInterval == Other.FrameInterval;
+	}
+
+	FText GetDisplayText() const;
+};
+
+/**
+ * How much attention a synced viewport is getting, decides how often it updates when focus priority is on
+ */
+enum class EViewportSyncFocusClass : uint8
+{
+	// Has keyboard focus, or was the last level viewport clicked in
+	Focused,
+
+	// Under the mouse
+	Hovered,
+
+	Background,
+
+	// The editor isn't the foreground app and is throttling itself, every viewport drops to this
+	EditorNotForeground,
+
+	Count
+};
+
+/**
+ * Decides which synced viewports get redrawn each editor frame.
+ *
+ * Each viewport is redrawn when its refresh rate says it is due, in round-robin order so their costs are staggered across frames.
+ * Viewports sharing a refresh rate are spread over its interval (the Nth of M is offset by N/M of an interval) so they don't all come due
+ * on the same frame. A newly added viewport waits for its first slot, at most one interval.
+ * Redraws stop for the frame once the (estimated) cost of drawing would exceed the frame budget, deferred viewports go first next frame.
+ * The PIE viewport is never registered here so it is always drawn by the engine as normal.
+ */
+class GAMEVIEWPORTSYNCCORE_API FViewportSyncScheduler
+{
+public:
+	FViewportSyncScheduler()
+		: RoundRobinIndex(0)
+		, LastTickTime(0.0)
+	{}
+
+	void AddViewport(FViewportSyncHandle ViewportHandle, const FViewportSyncRefreshRate& RefreshRate);
+	void RemoveViewport(FViewportSyncHandle ViewportHandle);
+	void Reset();
+
+	void SetRefreshRate(FViewportSyncHandle ViewportHandle, const FViewportSyncRefreshRate& RefreshRate);
+
+	/* Never redraw a viewport more often than MaxHz on top of its refresh rate, 0 removes the cap */
+	void SetMaxRate(FViewportSyncHandle ViewportHandle, float MaxHz);
+
+	/*
+	 * Redraws any viewports that are due this frame without going over the budget
+	 * @param FrameBudgetMs		Max game thread time (in ms) to spend redrawing synced viewports, <= 0 means unlimited
+	 * @param RedrawViewport	Performs the actual redraw, the time spent in here is what counts against the budget
+	 */
+	void Tick(uint64 FrameNumber, double CurrentTime, float FrameBudgetMs, TFunctionRef<void(FViewportSyncHandle)> RedrawViewport);
+
+	int32 Num() const { return ScheduledViewports.Num(); }
+
+private:
+	struct FScheduledViewport
+	{
+		FViewportSyncHandle ViewportHandle;
+
+		FViewportSyncRefreshRate RefreshRate;
+
+		// Cap from SetMaxRate, 0 when uncapped
+		float MaxHz;
+
+		double LastRedrawTime;
+
+		// Offset into the interval this viewport redraws at, spreads viewports with the same refresh rate apart
+		double PhaseTime;
+		int64 PhaseFrames;
+
+		// Which interval (counted from the phase) it last redrew in, it is due again once a later one starts
+		int64 LastRedrawSlot;
+		bool bHasRedrawSlot;
+
+		// Smoothed cost of a redraw, used to predict if we have room in the budget
+		float AverageRedrawCostMs;
+
+		FScheduledViewport(FViewportSyncHandle InViewportHandle, const FViewportSyncRefreshRate& InRefreshRate)
+			: ViewportHandle(InViewportHandle)
+			, RefreshRate(InRefreshRate)
+			, MaxHz(0.0f)
+			, LastRedrawTime(0.0)
+			, PhaseTime(0.0)
+			, PhaseFrames(0)
+			, LastRedrawSlot(0)
+			, bHasRedrawSlot(false)
+			, AverageRedrawCostMs(0.0f)
+		{}
+
+		/* Which interval of its refresh rate the viewport is in, unused for every frame viewports */
+		int64 GetRedrawSlot(uint64 FrameNumber, double CurrentTime, float DeltaTime) const;
+
+		bool IsDue(int64 RedrawSlot, double CurrentTime, float DeltaTime) const;
+	};
+
+	/* Spreads the phases of viewports that share a refresh rate evenly over its interval */
+	void UpdatePhases();
+
+	TArray<FScheduledViewport> ScheduledViewports;
+
+	// Where we start looking for due viewports next frame
+	int32 RoundRobinIndex;
+
+	double LastTickTime;
+};
@@ -0,0 +1,195 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Stable reference to an entry in a TViewportSyncStateTable.
+ * Stays valid while the entry exists, goes stale (rather than pointing at someone else) once it is removed.
+ */
+struct FViewportSyncHandle
+{
+	int32 SlotIndex;
+	uint32 Generation;
+
+	FViewportSyncHandle()
+		: SlotIndex(INDEX_NONE)
+		, Generation(0)
+	{}
+
+	FViewportSyncHandle(int32 InSlotIndex, uint32 InGeneration)
+		: SlotIndex(InSlotIndex)
+		, Generation(InGeneration)
+	{}
+
+	bool IsSet() const { return SlotIndex != INDEX_NONE; }
+
+	bool operator==(const FViewportSyncHandle& Other) const { return SlotIndex == Other.SlotIndex && Generation == Other.Generation; }
+	bool operator!=(const FViewportSyncHandle& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FViewportSyncHandle& Handle) { return HashCombine(::GetTypeHash(Handle.SlotIndex), ::GetTypeHash(Handle.Generation)); }
+};
+
+/**
+ * Per viewport state split into hot data (walked every tick, kept densely packed) and cold data (UI, settings, soft paths).
+ *
+ * Removal swaps the last entry into the hole so the hot array never has gaps, handles go through a slot
+ * indirection so they survive that. Cold entries are heap allocated so references to them stay put for as long as the entry exists.
+ */
+template<typename KeyType, typename HotType, typename ColdType>
+class TViewportSyncStateTable
+{
+public:
+	FViewportSyncHandle Add(KeyType Key, HotType&& HotData, ColdType&& ColdData)
+	{
+		check(!KeyToSlot.Contains(Key));
+
+		int32 SlotIndex;
+		if (FreeSlots.Num() > 0)
+		{
+			SlotIndex = FreeSlots.Pop(false);
+		}
+		else
+		{
+			SlotIndex = Slots.AddDefaulted();
+		}
+
+		const int32 DenseIndex = Keys.Add(Key);
+		Hot.Add(MoveTemp(HotData));
+		Cold.Add(MakeUnique<ColdType>(MoveTemp(ColdData)));
+		DenseToSlot.Add(SlotIndex);
+
+		FSlot& Slot = Slots[SlotIndex];
+		Slot.DenseIndex = DenseIndex;
+
+		KeyToSlot.Add(Key, SlotIndex);
+
+		return FViewportSyncHandle(SlotIndex, Slot.Generation);
+	}
+
+	/* Removes the entry, optionally moving its data out first */
+	bool Remove(FViewportSyncHandle Handle, HotType* OutHotData = nullptr, ColdType* OutColdData = nullptr)
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		if (DenseIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		if (OutHotData != nullptr)
+		{
+			*OutHotData = MoveTemp(Hot[DenseIndex]);
+		}
+		if (OutColdData != nullptr)
+		{
+			*OutColdData = MoveTemp(*Cold[DenseIndex]);
+		}
+
+		KeyToSlot.Remove(Keys[DenseIndex]);
+
+		// Move the last entry into the hole and point its slot at the new location
+		const int32 LastDenseIndex = Keys.Num() - 1;
+		if (DenseIndex != LastDenseIndex)
+		{
+			Slots[DenseToSlot[LastDenseIndex]].DenseIndex = DenseIndex;
+		}
+
+		Keys.RemoveAtSwap(DenseIndex, 1, false);
+		Hot.RemoveAtSwap(DenseIndex, 1, false);
+		Cold.RemoveAtSwap(DenseIndex, 1, false);
+		DenseToSlot.RemoveAtSwap(DenseIndex, 1, false);
+
+		FSlot& Slot = Slots[Handle.SlotIndex];
+		Slot.DenseIndex = INDEX_NONE;
+		++Slot.Generation;
+		FreeSlots.Add(Handle.SlotIndex);
+
+		return true;
+	}
+
+	FViewportSyncHandle Find(KeyType Key) const
+	{
+		if (const int32* SlotIndex = KeyToSlot.Find(Key))
+		{
+			return FViewportSyncHandle(*SlotIndex, Slots[*SlotIndex].Generation);
+		}
+		return FViewportSyncHandle();
+	}
+
+	bool Contains(KeyType Key) const { return KeyToSlot.Contains(Key); }
+
+	bool IsValid(FViewportSyncHandle Handle) const { return GetDenseIndex(Handle) != INDEX_NONE; }
+
+	HotType* GetHot(FViewportSyncHandle Handle)
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		return DenseIndex != INDEX_NONE ? &Hot[DenseIndex] : nullptr;
+	}
+
+	const HotType* GetHot(FViewportSyncHandle Handle) const
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		return DenseIndex != INDEX_NONE ? &Hot[DenseIndex] : nullptr;
+	}
+
+	ColdType* GetCold(FViewportSyncHandle Handle)
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		return DenseIndex != INDEX_NONE ? Cold[DenseIndex].Get() : nullptr;
+	}
+
+	const ColdType* GetCold(FViewportSyncHandle Handle) const
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		return DenseIndex != INDEX_NONE ? Cold[DenseIndex].Get() : nullptr;
+	}
+
+	KeyType GetKey(FViewportSyncHandle Handle) const
+	{
+		const int32 DenseIndex = GetDenseIndex(Handle);
+		return DenseIndex != INDEX_NONE ? Keys[DenseIndex] : KeyType();
+	}
+
+	/* Dense access, indices are only stable until the next Remove */
+	int32 Num() const { return Keys.Num(); }
+
+	KeyType KeyAt(int32 DenseIndex) const { return Keys[DenseIndex]; }
+	HotType& HotAt(int32 DenseIndex) { return Hot[DenseIndex]; }
+	const HotType& HotAt(int32 DenseIndex) const { return Hot[DenseIndex]; }
+	ColdType& ColdAt(int32 DenseIndex) { return *Cold[DenseIndex]; }
+	const ColdType& ColdAt(int32 DenseIndex) const { return *Cold[DenseIndex]; }
+
+	FViewportSyncHandle HandleAt(int32 DenseIndex) const
+	{
+		const int32 SlotIndex = DenseToSlot[DenseIndex];
+		return FViewportSyncHandle(SlotIndex, Slots[SlotIndex].Generation);
+	}
+
+private:
+	int32 GetDenseIndex(FViewportSyncHandle Handle) const
+	{
+		if (Slots.IsValidIndex(Handle.SlotIndex) && Slots[Handle.SlotIndex].Generation == Handle.Generation)
+		{
+			return Slots[Handle.SlotIndex].DenseIndex;
+		}
+		return INDEX_NONE;
+	}
+
+	struct FSlot
+	{
+		int32 DenseIndex = INDEX_NONE;
+		uint32 Generation = 0;
+	};
+
+	// Dense, all indexed the same
+	TArray<KeyType> Keys;
+	TArray<HotType> Hot;
+	TArray<TUniquePtr<ColdType>> Cold;
+	TArray<int32> DenseToSlot;
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	TMap<KeyType, int32> KeyToSlot;
+};
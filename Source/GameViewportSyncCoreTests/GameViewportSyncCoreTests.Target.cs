@@ -0,0 +1,31 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class GameViewportSyncCoreTestsTarget : TargetRules
+{
+	public GameViewportSyncCoreTestsTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "GameViewportSyncCoreTests";
+
+		// Core only, the follow core runs without the engine or the editor
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bCompileICU = false;
+		bBuildWithEditorOnlyData = true;
+		bIsBuildingConsoleApplication = true;
+
+		// Programs leave automation tests out otherwise
+		bForceCompileDevelopmentAutomationTests = true;
+
+		// GameViewportSyncCore comes from the plugin, only its program modules get built
+		bCompileWithPluginSupport = true;
+		EnablePlugins.Add("GameViewportSync");
+	}
+}
@@ -0,0 +1,117 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "RequiredProgramMainCPPInclude.h"
+#include "ViewportSyncCoreBenchmark.h"
+
+// UE Includes
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogViewportSyncCoreTests, Log, All);
+
+IMPLEMENT_APPLICATION(GameViewportSyncCoreTests, "GameViewportSyncCoreTests");
+
+/* Runs every automation test whose path starts with Filter, only the ones in modules linked into this program are there to find */
+static bool RunTests(const FString& Filter)
+{
+	FAutomationTestFramework& Framework = FAutomationTestFramework::Get();
+	Framework.SetRequestedTestFilter(EAutomationTestFlags::FilterMask);
+
+	TArray<FAutomationTestInfo> TestInfos;
+	Framework.GetValidTestNames(TestInfos);
+
+	int32 NumRun = 0;
+	int32 NumFailed = 0;
+
+	for (const FAutomationTestInfo& TestInfo : TestInfos)
+	{
+		if (!TestInfo.GetFullTestPath().StartsWith(Filter))
+		{
+			continue;
+		}
+
+		Framework.StartTestByName(TestInfo.GetTestName(), 0);
+
+		FAutomationTestExecutionInfo ExecutionInfo;
+		const bool bTestPassed = Framework.StopTest(ExecutionInfo);
+
+		++NumRun;
+		if (!bTestPassed)
+		{
+			++NumFailed;
+		}
+
+		UE_LOG(LogViewportSyncCoreTests, Display, TEXT("%-56s %s"), *TestInfo.GetFullTestPath(), bTestPassed ? TEXT("OK") : TEXT("FAILED"));
+
+		for (const FAutomationExecutionEntry& Entry : ExecutionInfo.GetEntries())
+		{
+			if (Entry.Event.Type == EAutomationEventType::Error)
+			{
+				UE_LOG(LogViewportSyncCoreTests, Error, TEXT("    %s"), *Entry.Event.Message);
+			}
+		}
+	}
+
+	UE_LOG(LogViewportSyncCoreTests, Display, TEXT("%d of %d tests passed"), NumRun - NumFailed, NumRun);
+
+	// Nothing matching means the filter is wrong or the tests were compiled out, either way it isn't a pass
+	return NumRun > 0 && NumFailed == 0;
+}
+
+/*
+ * Usage: GameViewportSyncCoreTests [-Tests=ViewportSync.] [-NoBenchmark] [-Viewports=64] [-Frames=2000] [-MaxNsPerViewport=] [-MaxAllocsPerTick=]
+ * Returns non-zero if a test failed or the microbenchmark went over a threshold that was passed in
+ */
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	GEngineLoop.PreInit(ArgC, ArgV);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FString Filter(TEXT("ViewportSync."));
+	FParse::Value(CommandLine, TEXT("Tests="), Filter);
+
+	bool bPassed = RunTests(Filter);
+
+	if (!FParse::Param(CommandLine, TEXT("NoBenchmark")))
+	{
+		int32 NumViewports = 64;
+		int32 NumFrames = 2000;
+		float MaxNsPerViewport = -1.0f;
+		float MaxAllocsPerTick = -1.0f;
+		FParse::Value(CommandLine, TEXT("Viewports="), NumViewports);
+		FParse::Value(CommandLine, TEXT("Frames="), NumFrames);
+		FParse::Value(CommandLine, TEXT("MaxNsPerViewport="), MaxNsPerViewport);
+		FParse::Value(CommandLine, TEXT("MaxAllocsPerTick="), MaxAllocsPerTick);
+
+		const FViewportSyncCoreBenchmarkResult Result = FViewportSyncCoreBenchmark::Run(NumViewports, NumFrames);
+
+		UE_LOG(LogViewportSyncCoreTests, Display, TEXT("Follow core: %d viewports over %d frames, %.1f ns per viewport per tick"), NumViewports, NumFrames, Result.NsPerViewport);
+
+		if (Result.bAllocationsCounted)
+		{
+			UE_LOG(LogViewportSyncCoreTests, Display, TEXT("Follow core: %.2f allocs/tick (max %llu)"), Result.AllocsPerTick, Result.MaxAllocsPerTick);
+		}
+		else
+		{
+			UE_LOG(LogViewportSyncCoreTests, Warning, TEXT("Allocations aren't counted by this build's allocator, try -ansimalloc. MaxAllocsPerTick is not checked"));
+		}
+
+		if (MaxNsPerViewport >= 0.0f && Result.NsPerViewport > MaxNsPerViewport)
+		{
+			UE_LOG(LogViewportSyncCoreTests, Error, TEXT("NsPerViewport %.1f is over the threshold of %.1f"), Result.NsPerViewport, MaxNsPerViewport);
+			bPassed = false;
+		}
+
+		if (Result.bAllocationsCounted && MaxAllocsPerTick >= 0.0f && Result.AllocsPerTick > MaxAllocsPerTick)
+		{
+			UE_LOG(LogViewportSyncCoreTests, Error, TEXT("AllocsPerTick %.2f is over the threshold of %.2f"), Result.AllocsPerTick, MaxAllocsPerTick);
+			bPassed = false;
+		}
+	}
+
+	FEngineLoop::AppExit();
+	return bPassed ? 0 : 1;
+}